@@ -10,9 +10,189 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 
+#include <iosfwd>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DemandDrivenIFDSSolver.h"
+
 namespace psr {
 
-class DemandDrivenAnalysis {};
+/**
+ * Solves an IFDS problem on demand: the facts at a statement are only
+ * computed once they are queried and only the part of the program that can
+ * reach the queried statement is analyzed. Results are kept across queries.
+ *
+ * @see DemandDrivenIFDSSolver
+ */
+template <typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class DemandDrivenAnalysis {
+  // Check if the problem description can be solved on demand
+  static_assert(
+      std::is_base_of_v<
+          IFDSTabulationProblem<
+              typename ProblemDescription::ProblemAnalysisDomain,
+              typename ProblemDescription::container_type>,
+          ProblemDescription>,
+      "Only IFDS problems can be solved on demand!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using Solver = DemandDrivenIFDSSolver<
+      typename ProblemDescription::ProblemAnalysisDomain,
+      typename ProblemDescription::container_type>;
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  ProblemDescription ProblemDesc;
+  Solver DataFlowSolver;
+
+public:
+  DemandDrivenAnalysis(ProjectIRDB &IRDB,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {}
+
+  /// Returns the data-flow facts that hold at the given statement.
+  std::set<d_t> query(n_t Stmt) { return DataFlowSolver.query(Stmt); }
+
+  /// Returns whether Fact holds at the given statement.
+  bool holdsAt(n_t Stmt, d_t Fact) {
+    return DataFlowSolver.holdsAt(Stmt, Fact);
+  }
+
+  /// Computes the data-flow facts at all of the given statements at once.
+  void demand(const std::vector<n_t> &Stmts) { DataFlowSolver.demand(Stmts); }
+
+  /// Demands every statement, i.e. solves the problem for the whole program.
+  void solve() { DataFlowSolver.solve(); }
+
+  void operator()() { solve(); }
+
+  ProblemDescription &getProblem() { return ProblemDesc; }
+
+  Solver &getSolver() { return DataFlowSolver; }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    DataFlowSolver.dumpResults(OS);
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitGraphicalReport(OS);
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
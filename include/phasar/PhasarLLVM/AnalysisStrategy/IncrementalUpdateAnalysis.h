@@ -10,9 +10,174 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 
+#include <iosfwd>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMProgramVersionMapping.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IncrementalIFDSSolver.h"
+
 namespace psr {
 
-class IncrementalUpdateAnalysis {};
+/**
+ * Analyzes a sequence of versions of a project. The first version is solved
+ * from scratch; every following version passed to update() reuses the
+ * results of its predecessor for all functions that are unchanged, cf.
+ * LLVMProgramVersionMapping and IncrementalIFDSSolver. The helper analyses
+ * are recomputed for every version; functions whose points-to sets differ
+ * between two versions count as changed.
+ */
+template <typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class IncrementalUpdateAnalysis {
+  // Check if the problem description can be updated incrementally
+  static_assert(
+      std::is_base_of_v<
+          IFDSTabulationProblem<
+              typename ProblemDescription::ProblemAnalysisDomain,
+              typename ProblemDescription::container_type>,
+          ProblemDescription>,
+      "Only IFDS problems can be updated incrementally!");
+  static_assert(
+      std::is_base_of_v<
+          ProgramVersionMapping<
+              typename ProblemDescription::ProblemAnalysisDomain>,
+          LLVMProgramVersionMapping>,
+      "Problem description does not use the default LLVM analysis domain!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using Solver = IncrementalIFDSSolver<
+      typename ProblemDescription::ProblemAnalysisDomain,
+      typename ProblemDescription::container_type>;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  // everything that is computed for one version of the project
+  struct Version {
+    ProjectIRDB &IRDB;
+    std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+    std::unique_ptr<PointerAnalysisTy> PointerInfo;
+    std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+    std::unique_ptr<ProblemDescription> ProblemDesc;
+    std::unique_ptr<Solver> DataFlowSolver;
+
+    Version(ProjectIRDB &IRDB) : IRDB(IRDB) {}
+  };
+
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  std::unique_ptr<Version> Current;
+  std::set<std::string> ChangedFunctions;
+
+  std::unique_ptr<Version> makeVersion(ProjectIRDB &IRDB) {
+    auto V = std::make_unique<Version>(IRDB);
+    V->TypeHierarchy = std::make_unique<TypeHierarchyTy>(IRDB);
+    V->PointerInfo = std::make_unique<PointerAnalysisTy>(IRDB);
+    V->CallGraph = std::make_unique<CallGraphAnalysisTy>(
+        IRDB, CallGraphAnalysisType::OTF, EntryPoints, V->TypeHierarchy.get(),
+        V->PointerInfo.get());
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      V->ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, V->TypeHierarchy.get(), V->CallGraph.get(),
+          V->PointerInfo.get(), EntryPoints);
+    } else {
+      V->ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, V->TypeHierarchy.get(), V->CallGraph.get(),
+          V->PointerInfo.get(), *Config, EntryPoints);
+    }
+    return V;
+  }
+
+public:
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB,
+                            std::set<std::string> EntryPoints = {})
+      : EntryPoints(std::move(EntryPoints)), Current(makeVersion(IRDB)) {
+    Current->DataFlowSolver = std::make_unique<Solver>(*Current->ProblemDesc);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                            std::set<std::string> EntryPoints = {})
+      : EntryPoints(std::move(EntryPoints)),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        Current(makeVersion(IRDB)) {
+    Current->DataFlowSolver = std::make_unique<Solver>(*Current->ProblemDesc);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                            std::set<std::string> EntryPoints = {})
+      : EntryPoints(std::move(EntryPoints)),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath), Current(makeVersion(IRDB)) {
+    Current->DataFlowSolver = std::make_unique<Solver>(*Current->ProblemDesc);
+  }
+
+  /// Solves the first version of the project from scratch.
+  void solve() { Current->DataFlowSolver->solve(); }
+
+  void operator()() { solve(); }
+
+  /**
+   * Solves the given version of the project, reusing the results of the
+   * current version for unchanged functions, and makes it the current
+   * version. The results and helper analyses of the previous version are
+   * released afterwards; its IRDB is not accessed anymore.
+   */
+  void update(ProjectIRDB &IRDB) {
+    std::unique_ptr<Version> Next = makeVersion(IRDB);
+    LLVMProgramVersionMapping Mapping(Current->IRDB, IRDB,
+                                      *Current->PointerInfo,
+                                      *Next->PointerInfo);
+    Next->DataFlowSolver = std::make_unique<Solver>(
+        *Next->ProblemDesc, *Current->DataFlowSolver, Mapping);
+    Next->DataFlowSolver->solve();
+    ChangedFunctions = Mapping.getChangedFunctions();
+    Current = std::move(Next);
+  }
+
+  /// Returns the names of the functions that have been added, removed or
+  /// changed by the last update().
+  [[nodiscard]] const std::set<std::string> &getChangedFunctions() const {
+    return ChangedFunctions;
+  }
+
+  ProblemDescription &getProblem() { return *Current->ProblemDesc; }
+
+  Solver &getSolver() { return *Current->DataFlowSolver; }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    Current->DataFlowSolver->dumpResults(OS);
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    Current->DataFlowSolver->emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    Current->DataFlowSolver->emitGraphicalReport(OS);
+  }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
@@ -10,9 +10,399 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 
+#include <algorithm>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ModuleWiseIFDSSolver.h"
+#include "phasar/PhasarLLVM/Utils/SummaryStrategy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
 namespace psr {
 
-class ModuleWiseAnalysis {};
+/**
+ * Analyzes each module of a project separately instead of linking them into
+ * a single module first. The modules are analyzed bottom-up along their
+ * dependencies, i.e. a module is analyzed after the modules that define the
+ * functions it declares. Modules that (transitively) depend on each other
+ * are analyzed together: their solvers import each other's summaries, which
+ * are iterated to a fixpoint before any module that depends on them is
+ * analyzed, cf. ModuleWiseIFDSSolver::stabilizeComponent().
+ *
+ * Every module is solved by a ModuleWiseIFDSSolver over a call graph of its
+ * own functions, rooted at its externally visible functions and the entry
+ * points it defines. Calls of functions exported by an analyzed module are
+ * resolved with the summaries of the exporting module's solver, which are
+ * kept for the whole analysis. By default, a summary is computed the first
+ * time a dependent module calls a function with a particular fact. The
+ * given SummaryGenerationStrategy may request summaries of all exported
+ * functions up-front as well: always_none for the zero fact and always_all,
+ * all_and_none and powerset for the zero fact and every single parameter and
+ * global variable the function uses. As IFDS problems are distributive,
+ * summaries for single facts cover all combinations of inputs. The type
+ * hierarchy and points-to information are computed once for all modules.
+ */
+template <typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ModuleWiseAnalysis {
+  // Check if the problem description can be analyzed module-wise
+  static_assert(
+      std::is_base_of_v<
+          IFDSTabulationProblem<
+              typename ProblemDescription::ProblemAnalysisDomain,
+              typename ProblemDescription::container_type>,
+          ProblemDescription>,
+      "Only IFDS problems can be analyzed module-wise!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using Solver = ModuleWiseIFDSSolver<
+      typename ProblemDescription::ProblemAnalysisDomain,
+      typename ProblemDescription::container_type>;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  // everything that is computed for one module
+  struct ModuleUnit {
+    std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+    std::unique_ptr<ProblemDescription> ProblemDesc;
+    std::unique_ptr<Solver> DataFlowSolver;
+  };
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  SummaryGenerationStrategy SummaryStrategy =
+      SummaryGenerationStrategy::all_observed;
+  typename Solver::ExportTableTy Exports;
+  std::vector<const llvm::Module *> AnalysisOrder;
+  std::map<const llvm::Module *, ModuleUnit> Units;
+  // the solvers of modules that depend on each other
+  std::vector<std::unique_ptr<typename Solver::ComponentTy>> Components;
+
+  static bool isExported(const llvm::Function &F) {
+    return !F.isDeclaration() && !F.hasLocalLinkage();
+  }
+
+  // state of Tarjan's algorithm over the module dependencies
+  struct ModuleOrderState {
+    std::map<const llvm::Module *, size_t> Index;
+    std::map<const llvm::Module *, size_t> LowLink;
+    std::vector<const llvm::Module *> Stack;
+    std::set<const llvm::Module *> OnStack;
+    std::vector<std::vector<const llvm::Module *>> Components;
+  };
+
+  void visitModule(const llvm::Module *M,
+                   const std::map<std::string, const llvm::Module *> &Definers,
+                   ModuleOrderState &State) const {
+    size_t Index = State.Index.size();
+    State.Index[M] = Index;
+    State.LowLink[M] = Index;
+    State.Stack.push_back(M);
+    State.OnStack.insert(M);
+    for (const llvm::Function &F : *M) {
+      if (!F.isDeclaration()) {
+        continue;
+      }
+      auto Search = Definers.find(F.getName().str());
+      if (Search == Definers.end() || Search->second == M) {
+        continue;
+      }
+      const llvm::Module *Definer = Search->second;
+      if (!State.Index.count(Definer)) {
+        visitModule(Definer, Definers, State);
+        State.LowLink[M] = std::min(State.LowLink[M], State.LowLink[Definer]);
+      } else if (State.OnStack.count(Definer)) {
+        State.LowLink[M] = std::min(State.LowLink[M], State.Index[Definer]);
+      }
+    }
+    if (State.LowLink[M] == Index) {
+      auto &Component = State.Components.emplace_back();
+      const llvm::Module *Member;
+      do {
+        Member = State.Stack.back();
+        State.Stack.pop_back();
+        State.OnStack.erase(Member);
+        Component.push_back(Member);
+      } while (Member != M);
+      std::sort(Component.begin(), Component.end(), compareModules);
+    }
+  }
+
+  static bool compareModules(const llvm::Module *LHS,
+                             const llvm::Module *RHS) {
+    return LHS->getModuleIdentifier() < RHS->getModuleIdentifier();
+  }
+
+  /// Groups the modules that (transitively) depend on each other and orders
+  /// the groups such that every group follows the groups that define the
+  /// functions its modules declare.
+  [[nodiscard]] std::vector<std::vector<const llvm::Module *>>
+  orderModulesBottomUp() const {
+    std::vector<const llvm::Module *> Modules;
+    for (const llvm::Module *M : IRDB.getAllModules()) {
+      Modules.push_back(M);
+    }
+    // make the order deterministic
+    std::sort(Modules.begin(), Modules.end(), compareModules);
+    std::map<std::string, const llvm::Module *> Definers;
+    for (const llvm::Module *M : Modules) {
+      for (const llvm::Function &F : *M) {
+        if (isExported(F)) {
+          Definers.try_emplace(F.getName().str(), M);
+        }
+      }
+    }
+    ModuleOrderState State;
+    for (const llvm::Module *M : Modules) {
+      if (!State.Index.count(M)) {
+        visitModule(M, Definers, State);
+      }
+    }
+    return std::move(State.Components);
+  }
+
+  void exportFunctions(const llvm::Module *M) {
+    for (const llvm::Function &F : *M) {
+      if (isExported(F)) {
+        Exports.try_emplace(F.getName().str(),
+                            Units.at(M).DataFlowSolver.get(), &F);
+      }
+    }
+  }
+
+  void generateSummaries(ModuleUnit &Unit, const llvm::Module *M) {
+    if (SummaryStrategy == SummaryGenerationStrategy::all_observed) {
+      return;
+    }
+    auto ZeroValue = Unit.ProblemDesc->getZeroValue();
+    for (const llvm::Function &F : *M) {
+      if (!isExported(F)) {
+        continue;
+      }
+      Unit.DataFlowSolver->summarize(&F, ZeroValue);
+      if (SummaryStrategy == SummaryGenerationStrategy::always_none) {
+        continue;
+      }
+      for (const llvm::Argument &Arg : F.args()) {
+        Unit.DataFlowSolver->summarize(&F, &Arg);
+      }
+      for (const llvm::Value *Global : globalValuesUsedinFunction(&F)) {
+        Unit.DataFlowSolver->summarize(&F, Global);
+      }
+    }
+  }
+
+  void setUpModule(const llvm::Module *M,
+                   const typename Solver::ComponentTy *Component) {
+    std::set<std::string> Roots;
+    std::set<std::string> ModuleEntryPoints;
+    for (const llvm::Function &F : *M) {
+      if (F.isDeclaration()) {
+        continue;
+      }
+      std::string Name = F.getName().str();
+      if (EntryPoints.count(Name)) {
+        ModuleEntryPoints.insert(Name);
+        Roots.insert(Name);
+      }
+      if (isExported(F)) {
+        Roots.insert(Name);
+      }
+    }
+    ModuleUnit &Unit = Units[M];
+    Unit.CallGraph = std::make_unique<CallGraphAnalysisTy>(
+        IRDB, CallGraphAnalysisType::OTF, Roots, TypeHierarchy.get(),
+        PointerInfo.get());
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      Unit.ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy.get(), Unit.CallGraph.get(), PointerInfo.get(),
+          ModuleEntryPoints);
+    } else {
+      Unit.ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy.get(), Unit.CallGraph.get(), PointerInfo.get(),
+          *Config, ModuleEntryPoints);
+    }
+    Unit.DataFlowSolver =
+        std::make_unique<Solver>(*Unit.ProblemDesc, Exports, Component);
+  }
+
+  void analyzeModules(const std::vector<const llvm::Module *> &Modules) {
+    typename Solver::ComponentTy *Component = nullptr;
+    if (Modules.size() > 1) {
+      Components.push_back(std::make_unique<typename Solver::ComponentTy>());
+      Component = Components.back().get();
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << Modules.size()
+                    << " modules depend on each other, iterating their "
+                       "summaries to a fixpoint");
+    }
+    for (const llvm::Module *M : Modules) {
+      setUpModule(M, Component);
+      if (Component) {
+        Component->push_back(Units.at(M).DataFlowSolver.get());
+      }
+    }
+    // the modules of a component import summaries from each other while
+    // they are solved
+    if (Component) {
+      for (const llvm::Module *M : Modules) {
+        exportFunctions(M);
+      }
+    }
+    for (const llvm::Module *M : Modules) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Analyze module: " << M->getModuleIdentifier());
+      Units.at(M).DataFlowSolver->solve();
+    }
+    if (Component) {
+      Component->front()->stabilizeComponent();
+    }
+    for (const llvm::Module *M : Modules) {
+      generateSummaries(Units.at(M), M);
+      // dependent modules may use this module's summaries from now on
+      exportFunctions(M);
+      AnalysisOrder.push_back(M);
+    }
+  }
+
+public:
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, std::set<std::string> EntryPoints = {},
+                     PointerAnalysisTy *PointerInfo = nullptr,
+                     TypeHierarchyTy *TypeHierarchy = nullptr,
+                     SummaryGenerationStrategy SummaryStrategy =
+                         SummaryGenerationStrategy::all_observed)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        EntryPoints(std::move(EntryPoints)), SummaryStrategy(SummaryStrategy) {
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                     std::set<std::string> EntryPoints = {},
+                     PointerAnalysisTy *PointerInfo = nullptr,
+                     TypeHierarchyTy *TypeHierarchy = nullptr,
+                     SummaryGenerationStrategy SummaryStrategy =
+                         SummaryGenerationStrategy::all_observed)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        EntryPoints(std::move(EntryPoints)),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        SummaryStrategy(SummaryStrategy) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                     std::set<std::string> EntryPoints = {},
+                     PointerAnalysisTy *PointerInfo = nullptr,
+                     TypeHierarchyTy *TypeHierarchy = nullptr,
+                     SummaryGenerationStrategy SummaryStrategy =
+                         SummaryGenerationStrategy::all_observed)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        EntryPoints(std::move(EntryPoints)),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath), SummaryStrategy(SummaryStrategy) {}
+
+  /// Analyzes all modules of the project that have not been analyzed yet.
+  void solve() {
+    for (const auto &Modules : orderModulesBottomUp()) {
+      if (!Units.count(Modules.front())) {
+        analyzeModules(Modules);
+      }
+    }
+  }
+
+  void operator()() { solve(); }
+
+  /// Returns the modules in the order in which they have been analyzed.
+  [[nodiscard]] const std::vector<const llvm::Module *> &
+  getAnalysisOrder() const {
+    return AnalysisOrder;
+  }
+
+  ProblemDescription &getProblem(const llvm::Module *M) {
+    return *Units.at(M).ProblemDesc;
+  }
+
+  Solver &getSolver(const llvm::Module *M) {
+    return *Units.at(M).DataFlowSolver;
+  }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    for (const llvm::Module *M : AnalysisOrder) {
+      OS << "\nModule: " << M->getModuleIdentifier() << '\n';
+      Units.at(M).DataFlowSolver->dumpResults(OS);
+    }
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    for (const llvm::Module *M : AnalysisOrder) {
+      OS << "\nModule: " << M->getModuleIdentifier() << '\n';
+      Units.at(M).DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    for (const llvm::Module *M : AnalysisOrder) {
+      Units.at(M).DataFlowSolver->emitGraphicalReport(OS);
+    }
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
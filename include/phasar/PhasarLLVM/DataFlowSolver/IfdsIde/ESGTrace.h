@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_ESGTRACE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_ESGTRACE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/StringRef.h"
+
+#include "nlohmann/json.hpp"
+
+namespace llvm {
+class MemoryBuffer;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * The binary format of an exploded super-graph (ESG) trace: a header
+ * followed by a sequence of records. Functions, nodes and facts are
+ * identified by dense IDs, and each of them is defined by a record of its
+ * own before the first edge that refers to it; the records of a kind define
+ * the IDs in ascending order, starting at 0. Edges are records of a
+ * fixed size, such that a trace stays compact and every prefix of a trace
+ * that ends after a complete record is a valid trace.
+ */
+struct ESGTraceFormat {
+  /// The version of the file format.
+  static constexpr uint32_t FormatVersion = 1;
+  static constexpr char Magic[8] = {'P', 'S', 'R', 'E', 'S', 'G', 'T', '\0'};
+
+  enum RecordKind : uint8_t {
+    // ID, name
+    FunctionRecord = 1,
+    // ID, function ID, statement ID, label
+    NodeRecord,
+    // ID, whether it is the zero value, label
+    FactRecord,
+    // source node, source fact, target node, target fact
+    IntraEdgeRecord,
+    InterEdgeRecord
+  };
+};
+
+/**
+ * Appends the records of an ESG trace to a file. Records are buffered and
+ * only written in large blocks, such that tracing does not slow down a
+ * solver considerably.
+ */
+class ESGTraceWriter {
+public:
+  /// Creates the trace file, overwriting an existing one.
+  explicit ESGTraceWriter(const std::string &TraceFile);
+
+  ~ESGTraceWriter();
+
+  ESGTraceWriter(const ESGTraceWriter &) = delete;
+  ESGTraceWriter &operator=(const ESGTraceWriter &) = delete;
+
+  /// Returns whether all records have been written so far.
+  [[nodiscard]] bool good() const { return static_cast<bool>(OS); }
+
+  void addFunction(uint32_t ID, llvm::StringRef Name);
+
+  void addNode(uint32_t ID, uint32_t Function, llvm::StringRef StmtID,
+               llvm::StringRef Label);
+
+  void addFact(uint32_t ID, bool IsZero, llvm::StringRef Label);
+
+  void addEdge(bool InterP, uint32_t SrcNode, uint32_t SrcFact,
+               uint32_t DstNode, uint32_t DstFact);
+
+  /// Writes all buffered records to the trace file.
+  void flush();
+
+private:
+  std::vector<char> Buffer;
+  std::ofstream OS;
+};
+
+/**
+ * Reads an ESG trace from a memory-mapped file. The definitions of the
+ * functions, nodes and facts are indexed when the trace is loaded, while
+ * edges are only decoded from the mapping on demand, e.g. to render the
+ * subgraph of some functions.
+ */
+class ESGTraceReader {
+public:
+  struct Node {
+    uint32_t Function;
+    llvm::StringRef StmtID;
+    llvm::StringRef Label;
+  };
+
+  struct Fact {
+    bool IsZero;
+    llvm::StringRef Label;
+  };
+
+  struct Edge {
+    bool InterP;
+    uint32_t SrcNode;
+    uint32_t SrcFact;
+    uint32_t DstNode;
+    uint32_t DstFact;
+  };
+
+  ESGTraceReader();
+
+  ~ESGTraceReader();
+
+  /// Maps and indexes the given trace; returns false if it cannot be read
+  /// or has an unsupported format. A trace whose last record is incomplete,
+  /// e.g. since the analysis has crashed, is read up to that record, just
+  /// like a trace with a corrupt record, e.g. one that skips an ID.
+  bool load(const std::string &TraceFile);
+
+  [[nodiscard]] const std::vector<llvm::StringRef> &getFunctions() const {
+    return Functions;
+  }
+
+  [[nodiscard]] const Node &getNode(uint32_t ID) const { return Nodes[ID]; }
+
+  [[nodiscard]] const Fact &getFact(uint32_t ID) const { return Facts[ID]; }
+
+  [[nodiscard]] size_t getNumEdges() const { return NumEdges; }
+
+  /// Calls F for every edge of the trace in the order of recording.
+  template <typename FnTy> void foreachEdge(FnTy F) const {
+    size_t Offset = FirstRecord;
+    Edge E;
+    while (nextEdge(Offset, E)) {
+      F(E);
+    }
+  }
+
+  /**
+   * Calls F for every edge from or to a node of the given functions; all
+   * edges are visited if Functions is empty.
+   */
+  template <typename FnTy>
+  void foreachEdgeOf(const std::set<std::string> &Functions, FnTy F) const {
+    if (Functions.empty()) {
+      foreachEdge(F);
+      return;
+    }
+    std::vector<bool> Selected = selectFunctions(Functions);
+    foreachEdge([this, &Selected, &F](const Edge &E) {
+      if (Selected[Nodes[E.SrcNode].Function] ||
+          Selected[Nodes[E.DstNode].Function]) {
+        F(E);
+      }
+    });
+  }
+
+  /**
+   * Renders the subgraph of the given functions, or the whole ESG if
+   * Functions is empty, in the layout of IDESolver::emitESGAsDot().
+   */
+  void printAsDot(std::ostream &OS,
+                  const std::set<std::string> &Functions = {}) const;
+
+  /// Returns the subgraph of the given functions, or the whole ESG if
+  /// Functions is empty, as a list of edges between labeled nodes.
+  [[nodiscard]] nlohmann::json
+  getAsJson(const std::set<std::string> &Functions = {}) const;
+
+private:
+  std::unique_ptr<llvm::MemoryBuffer> Trace;
+  std::vector<llvm::StringRef> Functions;
+  std::vector<Node> Nodes;
+  std::vector<Fact> Facts;
+  size_t FirstRecord = 0;
+  // the end of the last complete record
+  size_t End = 0;
+  size_t NumEdges = 0;
+
+  bool nextEdge(size_t &Offset, Edge &E) const;
+
+  [[nodiscard]] std::vector<bool>
+  selectFunctions(const std::set<std::string> &Names) const;
+};
+
+} // namespace psr
+
+#endif
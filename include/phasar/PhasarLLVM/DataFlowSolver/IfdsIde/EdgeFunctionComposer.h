@@ -10,9 +10,12 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONCOMPOSER_H
 #define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONCOMPOSER_H
 
+#include "boost/functional/hash.hpp"
+
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 
 #include <memory>
+#include <typeinfo>
 
 namespace psr {
 
@@ -41,6 +44,15 @@ private:
   // For debug purpose only
   const unsigned EFComposer_Id;
   static inline unsigned CurrEFComposer_Id = 0;
+  // number of edge functions other than composers this composition is made of
+  const size_t ChainLength;
+
+  static size_t getChainLength(const EdgeFunctionPtrType &EF) {
+    if (auto *EFC = dynamic_cast<EdgeFunctionComposer<L> *>(EF.get())) {
+      return EFC->ChainLength;
+    }
+    return 1;
+  }
 
 protected:
   /// First edge function
@@ -50,7 +62,8 @@ protected:
 
 public:
   EdgeFunctionComposer(EdgeFunctionPtrType F, EdgeFunctionPtrType G)
-      : EFComposer_Id(++CurrEFComposer_Id), F(F), G(G) {}
+      : EFComposer_Id(++CurrEFComposer_Id),
+        ChainLength(getChainLength(F) + getChainLength(G)), F(F), G(G) {}
 
   ~EdgeFunctionComposer() override = default;
 
@@ -82,13 +95,41 @@ public:
   // virtual EdgeFunctionPtrType
   // joinWith(EdgeFunctionPtrType otherFunction) = 0;
 
+  /**
+   * Compositions are equal if they are of the same dynamic type and their
+   * parts are equal.
+   */
   bool equal_to(EdgeFunctionPtrType other) const override {
-    if (auto EFC = dynamic_cast<EdgeFunctionComposer<L> *>(other.get())) {
-      return F->equal_to(EFC->F) && G->equal_to(EFC->G);
+    if (other.get() == this) {
+      return true;
+    }
+    if (!other || typeid(*other) != typeid(*this)) {
+      return false;
     }
-    return false;
+    auto *EFC = static_cast<EdgeFunctionComposer<L> *>(other.get());
+    return F->equal_to(EFC->F) && G->equal_to(EFC->G);
   }
 
+  /**
+   * Hashes the dynamic type and the hashes of F and G, consistent with
+   * equal_to(). Opts out of sharing (returns 0) if F or G do.
+   */
+  size_t hash() const override {
+    size_t FHash = F->hash();
+    size_t GHash = G->hash();
+    if (FHash == 0 || GHash == 0) {
+      return 0;
+    }
+    size_t Seed = typeid(*this).hash_code();
+    boost::hash_combine(Seed, FHash);
+    boost::hash_combine(Seed, GHash);
+    return Seed;
+  }
+
+  /// Returns the number of edge functions other than composers this
+  /// composition is made of.
+  size_t getChainLength() const { return ChainLength; }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "COMP[ " << F.get()->str() << " , " << G.get()->str()
        << " ] (EF:" << EFComposer_Id << ')';
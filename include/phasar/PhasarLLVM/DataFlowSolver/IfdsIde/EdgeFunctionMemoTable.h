@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONMEMOTABLE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONMEMOTABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include "boost/functional/hash.hpp"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/Utils/ClockCache.h"
+#include "phasar/Utils/PAMMMacros.h"
+
+namespace psr {
+
+/**
+ * Memoizes the results of composing and joining edge functions. Results are
+ * looked up by the identities of their operands; to make these identities
+ * meaningful, every result is hash-consed first: if a structurally equal edge
+ * function (see EdgeFunction::hash() and EdgeFunction::equal_to()) has been
+ * produced before, the earlier instance is returned instead. Repeated
+ * compositions of equal chains thus collapse into a single shared instance
+ * and a single table lookup.
+ *
+ * The table is split into shards that are guarded by their own locks, hence
+ * it may be used by multiple solver threads at once. A capacity other than 0
+ * bounds the number of memoized results per shard and operation; hash-consed
+ * edge functions are kept as long as the table lives.
+ */
+template <typename L> class EdgeFunctionMemoTable {
+public:
+  using EdgeFunctionPtrType = typename EdgeFunction<L>::EdgeFunctionPtrType;
+
+  static constexpr size_t NumShards = 16;
+
+private:
+  struct OperandKey {
+    // holding the operands keeps their addresses from being reused
+    EdgeFunctionPtrType F;
+    EdgeFunctionPtrType G;
+    size_t Hash;
+
+    OperandKey(EdgeFunctionPtrType F, EdgeFunctionPtrType G)
+        : F(std::move(F)), G(std::move(G)), Hash(0) {
+      boost::hash_combine(Hash, this->F.get());
+      boost::hash_combine(Hash, this->G.get());
+    }
+
+    bool operator==(const OperandKey &Other) const {
+      return F.get() == Other.F.get() && G.get() == Other.G.get();
+    }
+
+    struct Hasher {
+      size_t operator()(const OperandKey &Key) const { return Key.Hash; }
+    };
+  };
+
+  using MemoCache =
+      ClockCache<OperandKey, EdgeFunctionPtrType, typename OperandKey::Hasher>;
+
+  struct Shard {
+    std::mutex Mutex;
+    MemoCache Composed;
+    MemoCache Joined;
+    std::unordered_map<size_t, llvm::SmallVector<EdgeFunctionPtrType, 1>>
+        Interned;
+  };
+
+  std::array<Shard, NumShards> Shards;
+
+  Shard &getShard(size_t Hash) {
+    return Shards[(Hash * 0x9E3779B97F4A7C15ULL >> 32) % NumShards];
+  }
+
+  template <typename Fn>
+  EdgeFunctionPtrType memoize(MemoCache Shard::*Cache,
+                              const EdgeFunctionPtrType &F,
+                              const EdgeFunctionPtrType &G, Fn Compute) {
+    OperandKey Key(F, G);
+    Shard &S = getShard(Key.Hash);
+    {
+      std::lock_guard<std::mutex> Lock(S.Mutex);
+      if (auto *Cached = (S.*Cache).lookup(Key)) {
+        return *Cached;
+      }
+    }
+    // the operands' implementation may take a while, do not block the shard
+    EdgeFunctionPtrType Result = intern(Compute());
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    if (!(S.*Cache).lookup(Key)) {
+      (S.*Cache).insert(std::move(Key), Result);
+    }
+    return Result;
+  }
+
+public:
+  explicit EdgeFunctionMemoTable(size_t Capacity = 0) {
+    for (Shard &S : Shards) {
+      S.Composed = MemoCache(Capacity);
+      S.Joined = MemoCache(Capacity);
+    }
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("EF Compose Memo Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Join Memo Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Hash-Consed", 0, PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  EdgeFunctionMemoTable(const EdgeFunctionMemoTable &) = delete;
+  EdgeFunctionMemoTable &operator=(const EdgeFunctionMemoTable &) = delete;
+  EdgeFunctionMemoTable(EdgeFunctionMemoTable &&) = delete;
+  EdgeFunctionMemoTable &operator=(EdgeFunctionMemoTable &&) = delete;
+  ~EdgeFunctionMemoTable() = default;
+
+  /// Returns F->composeWith(G), reusing the result of an earlier call.
+  EdgeFunctionPtrType compose(const EdgeFunctionPtrType &F,
+                              const EdgeFunctionPtrType &G) {
+    bool Computed = false;
+    auto Result = memoize(&Shard::Composed, F, G, [&] {
+      Computed = true;
+      return F->composeWith(G);
+    });
+    if (!Computed) {
+      PAMM_GET_INSTANCE;
+      INC_COUNTER("EF Compose Memo Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+    }
+    return Result;
+  }
+
+  /// Returns F->joinWith(G), reusing the result of an earlier call.
+  EdgeFunctionPtrType join(const EdgeFunctionPtrType &F,
+                           const EdgeFunctionPtrType &G) {
+    bool Computed = false;
+    auto Result = memoize(&Shard::Joined, F, G, [&] {
+      Computed = true;
+      return F->joinWith(G);
+    });
+    if (!Computed) {
+      PAMM_GET_INSTANCE;
+      INC_COUNTER("EF Join Memo Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+    }
+    return Result;
+  }
+
+  /// Returns the canonical instance of all edge functions equal to EF. Edge
+  /// functions whose hash() is 0 are returned unchanged.
+  EdgeFunctionPtrType intern(EdgeFunctionPtrType EF) {
+    size_t Hash = EF->hash();
+    if (Hash == 0) {
+      return EF;
+    }
+    Shard &S = getShard(Hash);
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    auto &Candidates = S.Interned[Hash];
+    for (const auto &Candidate : Candidates) {
+      if (Candidate == EF || Candidate->equal_to(EF)) {
+        PAMM_GET_INSTANCE;
+        INC_COUNTER("EF Hash-Consed", 1, PAMM_SEVERITY_LEVEL::Full);
+        return Candidate;
+      }
+    }
+    Candidates.push_back(EF);
+    return EF;
+  }
+};
+
+} // namespace psr
+
+#endif
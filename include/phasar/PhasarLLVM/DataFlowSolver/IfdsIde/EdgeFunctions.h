@@ -19,7 +19,9 @@
 
 #include "llvm/Support/Compiler.h"
 
-#include <atomic>
+#include "phasar/Utils/PoolAllocator.h"
+
+#include <array>
 #include <iosfwd>
 #include <iostream>
 #include <map>
@@ -27,9 +29,11 @@
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
-#include <thread>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 namespace psr {
@@ -80,6 +84,15 @@ public:
 
   virtual bool equal_to(EdgeFunctionPtrType OtherFunction) const = 0;
 
+  //
+  // Returns a hash value for this edge function that is used to share
+  // structurally equal edge functions (see EdgeFunctionMemoTable). Edge
+  // functions that are equal_to() each other should return the same hash;
+  // functions with different hashes are never shared. The default
+  // implementation returns 0, which exempts the function from sharing.
+  //
+  virtual size_t hash() const { return 0; }
+
   virtual void print(std::ostream &OS, bool IsForDebug = false) const {
     OS << "EdgeFunction";
   }
@@ -135,6 +148,8 @@ public:
     return false;
   }
 
+  size_t hash() const override { return typeid(AllTop<L>).hash_code(); }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "AllTop";
   }
@@ -189,6 +204,8 @@ public:
     return false;
   }
 
+  size_t hash() const override { return typeid(AllBottom<L>).hash_code(); }
+
   void print(std::ostream &OS, bool isForDebug = false) const override {
     OS << "AllBottom";
   }
@@ -491,9 +508,14 @@ public:
 // inheriting from EdgeFunctionSingletonFactory and only allocating
 // EdgeFunction throught the provided createEdgeFunction method.
 //
-// Old unused EdgeFunction that were deallocated need to/should be clean from
-// the factory by either calling cleanExpiredEdgeFunctions or initializing the
-// automatic cleaner thread with initEdgeFunctionCleaner.
+// The factory keeps its EdgeFunctions in a number of shards, each of which is
+// guarded by its own reader-writer lock. Looking up an EdgeFunction that was
+// already created only takes a shared lock on a single shard, such that
+// concurrent lookups do not block each other. Keys are distributed among the
+// shards by std::hash<CtorArgT>, if available. Old unused EdgeFunction that
+// were deallocated are cleaned from a shard incrementally while new
+// EdgeFunctions are inserted into it; cleanExpiredEdgeFunctions removes all of
+// them at once.
 template <typename EdgeFunctionType, typename CtorArgT>
 class EdgeFunctionSingletonFactory {
 public:
@@ -506,122 +528,130 @@ public:
   EdgeFunctionSingletonFactory &
   operator=(EdgeFunctionSingletonFactory &&) noexcept = default;
 
-  virtual ~EdgeFunctionSingletonFactory() {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
-  }
+  virtual ~EdgeFunctionSingletonFactory() = default;
 
   // Creates a new EdgeFunction of type EdgeFunctionType, reusing the previous
   // allocation if an EdgeFunction with the same values was already created.
   static inline std::shared_ptr<EdgeFunctionType>
   createEdgeFunction(CtorArgT K) {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
+    auto &Shard = getCacheData().getShard(K);
+    {
+      std::shared_lock<std::shared_mutex> ReadLock(Shard.DataMutex);
+      auto SearchVal = Shard.Storage.find(K);
+      if (SearchVal != Shard.Storage.end()) {
+        if (auto EdgeFunc = SearchVal->second.lock()) {
+          return EdgeFunc;
+        }
+      }
+    }
 
-    auto &Storage = getCacheData().Storage;
-    auto SearchVal = Storage.find(K);
-    if (SearchVal != Storage.end() && !SearchVal->second.expired()) {
-      return SearchVal->second.lock();
+    std::lock_guard<std::shared_mutex> WriteLock(Shard.DataMutex);
+    // another thread may have created the EdgeFunction in the meantime
+    auto SearchVal = Shard.Storage.find(K);
+    if (SearchVal != Shard.Storage.end()) {
+      if (auto EdgeFunc = SearchVal->second.lock()) {
+        return EdgeFunc;
+      }
+    }
+    auto NewEdgeFunc = makePooledShared<EdgeFunctionType>(K);
+    if (SearchVal != Shard.Storage.end()) {
+      SearchVal->second = NewEdgeFunc;
     } else {
-      auto NewEdgeFunc = std::make_shared<EdgeFunctionType>(K);
-      Storage[K] = NewEdgeFunc;
-      return NewEdgeFunc;
+      Shard.Storage.emplace(std::move(K), NewEdgeFunc);
     }
+    Shard.sweepExpired(SweepStepsPerInsertion);
+    return NewEdgeFunc;
   }
 
-  // Initialize a cleaner thread to automatically remove unused/expired
-  // EdgeFunctions. The thread is only started the first time this function is
-  // called.
-  static inline void initEdgeFunctionCleaner() { getCleaner(); }
-
-  static inline void stopEdgeFunctionCleaner() { getCleaner().stop(); }
-
   // Clean all unused/expired EdgeFunctions from the internal storage.
   static inline void cleanExpiredEdgeFunctions() {
-    cleanExpiredMapEntries(getCacheData());
+    for (auto &Shard : getCacheData().Shards) {
+      std::lock_guard<std::shared_mutex> WriteLock(Shard.DataMutex);
+      Shard.sweepExpired(Shard.Storage.size());
+    }
   }
 
   LLVM_DUMP_METHOD
   static void dump(bool PrintElements = false) {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
-
-    std::cout << "Elements in cache: " << getCacheData().Storage.size();
+    std::cout << "Elements in cache: " << getCacheData().size();
 
     if (PrintElements) {
       std::cout << "\n";
-      for (auto &KVPair : getCacheData().Storage) {
-        std::cout << "(" << KVPair.first << ") -> " << std::boolalpha
-                  << KVPair.second.expired() << std::endl;
+      for (auto &Shard : getCacheData().Shards) {
+        std::shared_lock<std::shared_mutex> ReadLock(Shard.DataMutex);
+        for (auto &KVPair : Shard.Storage) {
+          std::cout << "(" << KVPair.first << ") -> " << std::boolalpha
+                    << KVPair.second.expired() << std::endl;
+        }
       }
     }
     std::cout << std::endl;
   }
 
 private:
-  struct EFStorageData {
+  static constexpr size_t NumShards = 32;
+  // Every insertion inspects this many entries of its shard for expired
+  // EdgeFunctions. As it exceeds the number of entries an insertion adds, a
+  // shard never grows beyond a constant factor of its live EdgeFunctions.
+  static constexpr size_t SweepStepsPerInsertion = 2;
+
+  template <typename T, typename = void>
+  struct IsHashable : std::false_type {};
+  template <typename T>
+  struct IsHashable<T, std::void_t<decltype(std::declval<std::hash<T>>()(
+                           std::declval<const T &>()))>> : std::true_type {};
+
+  struct EFStorageShard {
     std::map<CtorArgT, std::weak_ptr<EdgeFunctionType>> Storage{};
-    std::mutex DataMutex;
+    // position at which the next incremental sweep continues
+    typename std::map<CtorArgT, std::weak_ptr<EdgeFunctionType>>::iterator
+        SweepPos = Storage.end();
+    mutable std::shared_mutex DataMutex;
+
+    // Inspects up to N entries, starting at SweepPos and wrapping around at
+    // the end of the storage, and removes the expired ones. Expects DataMutex
+    // to be held exclusively.
+    void sweepExpired(size_t N) {
+      for (size_t I = 0; I < N && !Storage.empty(); ++I) {
+        if (SweepPos == Storage.end()) {
+          SweepPos = Storage.begin();
+        }
+        if (SweepPos->second.expired()) {
+          SweepPos = Storage.erase(SweepPos);
+        } else {
+          ++SweepPos;
+        }
+      }
+    }
   };
 
-  static inline EFStorageData &getCacheData() {
-    static EFStorageData StoredData{};
-    return StoredData;
-  }
-
-  static void cleanExpiredMapEntries(EFStorageData &CData) {
-    std::lock_guard<std::mutex> DataLock(CData.DataMutex);
+  struct EFStorageData {
+    std::array<EFStorageShard, NumShards> Shards{};
 
-    auto &Storage = CData.Storage;
-    for (auto Iter = Storage.begin(); Iter != Storage.end();) {
-      if (Iter->second.expired()) {
-        Iter = Storage.erase(Iter);
+    EFStorageShard &getShard(const CtorArgT &K) {
+      if constexpr (IsHashable<CtorArgT>::value) {
+        size_t Hash = std::hash<CtorArgT>()(K);
+        return Shards[(Hash * 0x9E3779B97F4A7C15ULL >> 32) % NumShards];
       } else {
-        ++Iter;
+        return Shards[0];
       }
     }
-  }
 
-  class EdgeFactoryStorageCleaner {
-  public:
-    EdgeFactoryStorageCleaner()
-        : CleanerThread(&EdgeFactoryStorageCleaner::runCleaner, this,
-                        std::reference_wrapper<EFStorageData>(
-                            EdgeFunctionSingletonFactory::getCacheData())) {
-#ifdef __linux__
-      pthread_setname_np(CleanerThread.native_handle(),
-                         "EdgeFactoryStorageCleanerThread");
-#endif
-    }
-    EdgeFactoryStorageCleaner(const EdgeFactoryStorageCleaner &) = delete;
-    EdgeFactoryStorageCleaner &
-    operator=(const EdgeFactoryStorageCleaner &) = delete;
-    EdgeFactoryStorageCleaner(EdgeFactoryStorageCleaner &&) = delete;
-    EdgeFactoryStorageCleaner &operator=(EdgeFactoryStorageCleaner &&) = delete;
-    ~EdgeFactoryStorageCleaner() { stop(); }
-
-    // Stops the cleaning thread running in the background.
-    void stop() {
-      KeepRunning = false;
-      if (CleanerThread.joinable()) {
-        CleanerThread.join();
+    // Returns the number of stored entries, including expired ones that have
+    // not been cleaned yet.
+    [[nodiscard]] size_t size() const {
+      size_t Size = 0;
+      for (const auto &Shard : Shards) {
+        std::shared_lock<std::shared_mutex> ReadLock(Shard.DataMutex);
+        Size += Shard.Storage.size();
       }
+      return Size;
     }
-
-  private:
-    void runCleaner(EFStorageData &CData) {
-      while (KeepRunning) {
-        std::this_thread::sleep_for(CleaningPauseTime);
-        cleanExpiredMapEntries(CData);
-      }
-    }
-
-    static constexpr auto CleaningPauseTime = std::chrono::seconds(2);
-
-    std::atomic_bool KeepRunning{true};
-    std::thread CleanerThread;
   };
 
-  static inline EdgeFactoryStorageCleaner &getCleaner() {
-    static EdgeFactoryStorageCleaner EdgeFunctionCleaner{};
-    return EdgeFunctionCleaner;
+  static inline EFStorageData &getCacheData() {
+    static EFStorageData StoredData{};
+    return StoredData;
   }
 
   friend internal::TestEdgeFunction;
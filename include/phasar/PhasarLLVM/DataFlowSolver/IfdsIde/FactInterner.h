@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_FACTINTERNER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_FACTINTERNER_H_
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace psr {
+
+/**
+ * A 32-bit handle of a data-flow fact that has been interned by a
+ * FactInterner. Handles are cheap to copy, compare and hash, no matter how
+ * heavy the facts they stand for are.
+ */
+class FactHandle {
+public:
+  FactHandle() = default;
+  explicit FactHandle(uint32_t ID) : ID(ID) {}
+
+  [[nodiscard]] uint32_t getID() const { return ID; }
+
+  friend bool operator==(FactHandle LHS, FactHandle RHS) {
+    return LHS.ID == RHS.ID;
+  }
+  friend bool operator!=(FactHandle LHS, FactHandle RHS) {
+    return LHS.ID != RHS.ID;
+  }
+  friend bool operator<(FactHandle LHS, FactHandle RHS) {
+    return LHS.ID < RHS.ID;
+  }
+  friend std::ostream &operator<<(std::ostream &OS, FactHandle H) {
+    return OS << '#' << H.ID;
+  }
+
+private:
+  uint32_t ID = 0;
+};
+
+/**
+ * Maps data-flow facts of type D to stable FactHandles. Every fact is
+ * stored once and keeps its handle for the lifetime of the interner, and
+ * handles are handed out in the order in which the facts are interned,
+ * starting at 0. D must be hashable using std::hash.
+ *
+ * If the interner is concurrent, it may be used from several threads at
+ * once; otherwise it does not lock at all.
+ */
+template <typename D> class FactInterner {
+public:
+  explicit FactInterner(bool Concurrent = false) : Concurrent(Concurrent) {}
+
+  FactInterner(const FactInterner &) = delete;
+  FactInterner &operator=(const FactInterner &) = delete;
+
+  /// Returns the handle of Fact, which is interned if it is not yet.
+  FactHandle intern(const D &Fact) {
+    if (auto Handle = lookup(Fact)) {
+      return *Handle;
+    }
+    std::unique_lock<std::shared_mutex> Lock(Mutex, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    // another thread may have interned Fact meanwhile
+    auto Search = Handles.find(std::cref(Fact));
+    if (Search != Handles.end()) {
+      return Search->second;
+    }
+    assert(Facts.size() < std::numeric_limits<uint32_t>::max() &&
+           "Too many data-flow facts to intern!");
+    FactHandle Handle(Facts.size());
+    // the deque never moves its elements, so we can refer to them as keys
+    Handles.emplace(std::cref(Facts.emplace_back(Fact)), Handle);
+    return Handle;
+  }
+
+  /// Returns the handle of Fact if it has been interned.
+  [[nodiscard]] std::optional<FactHandle> lookup(const D &Fact) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    auto Search = Handles.find(std::cref(Fact));
+    if (Search == Handles.end()) {
+      return std::nullopt;
+    }
+    return Search->second;
+  }
+
+  /// Returns the fact that Handle stands for. The reference remains valid
+  /// for the lifetime of the interner.
+  [[nodiscard]] const D &get(FactHandle Handle) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    assert(Handle.getID() < Facts.size() && "Unknown fact handle!");
+    return Facts[Handle.getID()];
+  }
+
+  /// Returns the number of interned facts.
+  [[nodiscard]] size_t size() const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    return Facts.size();
+  }
+
+private:
+  struct RefHash {
+    size_t operator()(std::reference_wrapper<const D> Fact) const {
+      return std::hash<D>{}(Fact.get());
+    }
+  };
+  struct RefEqual {
+    bool operator()(std::reference_wrapper<const D> LHS,
+                    std::reference_wrapper<const D> RHS) const {
+      return LHS.get() == RHS.get();
+    }
+  };
+
+  bool Concurrent;
+  mutable std::shared_mutex Mutex;
+  std::deque<D> Facts;
+  std::unordered_map<std::reference_wrapper<const D>, FactHandle, RefHash,
+                     RefEqual>
+      Handles;
+};
+
+} // namespace psr
+
+namespace std {
+
+template <> struct hash<psr::FactHandle> {
+  size_t operator()(psr::FactHandle H) const {
+    return std::hash<uint32_t>{}(H.getID());
+  }
+};
+
+} // namespace std
+
+#endif
@@ -10,18 +10,54 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 
-#include <map>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <tuple>
+#include <unordered_map>
+
+#include "boost/functional/hash.hpp"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/Utils/ClockCache.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/PoolAllocator.h"
 
 namespace psr {
 
+/**
+ * Key of the flow- and edge-function caches. The hash is computed once on
+ * construction such that rehashing and lookups only compare the stored hash
+ * values before falling back to comparing the tuple elements.
+ */
+template <typename... Ts> struct FlowEdgeFunctionCacheKey {
+  std::tuple<Ts...> Values;
+  size_t Hash;
+
+  FlowEdgeFunctionCacheKey(Ts... Vals)
+      : Values(Vals...), Hash(computeHash(Vals...)) {}
+
+  bool operator==(const FlowEdgeFunctionCacheKey &Other) const {
+    return Hash == Other.Hash && Values == Other.Values;
+  }
+
+  struct Hasher {
+    size_t operator()(const FlowEdgeFunctionCacheKey &Key) const {
+      return Key.Hash;
+    }
+  };
+
+private:
+  static size_t computeHash(const Ts &... Vals) {
+    size_t Seed = 0;
+    (boost::hash_combine(Seed, std::hash<Ts>{}(Vals)), ...);
+    return Seed;
+  }
+};
+
 /**
  * This class caches flow and edge functions to avoid their reconstruction.
  * When a flow or edge function must be applied to multiple times, a cached
@@ -41,32 +77,61 @@ class FlowEdgeFunctionCache {
   using t_t = typename AnalysisDomainTy::t_t;
 
 private:
-  using EdgeFuncInstKey = std::pair<n_t, n_t>;
-  using EdgeFuncNodeKey = std::pair<d_t, d_t>;
-  using InnerEdgeFunctionMapType =
-      std::map<EdgeFuncNodeKey, EdgeFunctionPtrType>;
+  template <typename... Ts> using KeyT = FlowEdgeFunctionCacheKey<Ts...>;
+  template <typename KeyTy, typename ValueTy>
+  using CacheT = ClockCache<KeyTy, ValueTy, typename KeyTy::Hasher>;
+  // Callee sets are interned to small integer IDs such that call-to-return
+  // flow-function lookups neither copy nor compare whole sets.
+  using CalleeSetID = unsigned;
+
+  struct CalleeSetHash {
+    size_t operator()(const std::set<f_t> &Callees) const {
+      size_t Seed = 0;
+      for (f_t Callee : Callees) {
+        boost::hash_combine(Seed, std::hash<f_t>{}(Callee));
+      }
+      return Seed;
+    }
+  };
 
   IDETabulationProblem<AnalysisDomainTy, Container> &problem;
   // Auto add zero
   bool autoAddZero;
   d_t zeroValue;
+  // Maximum number of entries per cache, 0 means unbounded
+  size_t CacheCapacity;
+  std::unordered_map<std::set<f_t>, CalleeSetID, CalleeSetHash> CalleeSetIDs;
   // Caches for the flow functions
-  std::map<std::tuple<n_t, n_t>, FlowFunctionPtrType> NormalFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t, std::set<f_t>>, FlowFunctionPtrType>
-      CallToRetFlowFunctionCache;
+  CacheT<KeyT<n_t, n_t>, FlowFunctionPtrType> NormalFlowFunctionCache{
+      CacheCapacity};
+  CacheT<KeyT<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache{
+      CacheCapacity};
+  CacheT<KeyT<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
+      ReturnFlowFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, n_t, CalleeSetID>, FlowFunctionPtrType>
+      CallToRetFlowFunctionCache{CacheCapacity};
   // Caches for the edge functions
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType> NormalEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      ReturnEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      SummaryEdgeFunctionCache;
+  CacheT<KeyT<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+      NormalEdgeFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType> CallEdgeFunctionCache{
+      CacheCapacity};
+  CacheT<KeyT<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+      ReturnEdgeFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+      CallToRetEdgeFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+      SummaryEdgeFunctionCache{CacheCapacity};
+  // Every cache is guarded by its own lock such that concurrent solver threads
+  // only contend if they query the same kind of flow or edge function.
+  std::mutex NormalFFMutex;
+  std::mutex CallFFMutex;
+  std::mutex ReturnFFMutex;
+  std::mutex CallToRetFFMutex; // also guards CalleeSetIDs
+  std::mutex NormalEFMutex;
+  std::mutex CallEFMutex;
+  std::mutex ReturnEFMutex;
+  std::mutex CallToRetEFMutex;
+  std::mutex SummaryEFMutex;
 
 public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
@@ -75,47 +140,57 @@ public:
       IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : problem(Problem),
         autoAddZero(problem.getIFDSIDESolverConfig().autoAddZero()),
-        zeroValue(problem.getZeroValue()) {
+        zeroValue(problem.getZeroValue()),
+        CacheCapacity(
+            problem.getIFDSIDESolverConfig().flowEdgeFunctionCacheCapacity()) {
     PAMM_GET_INSTANCE;
     REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Normal-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call flow functions
     REG_COUNTER("Call-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Call-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Call-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for return flow functions
     REG_COUNTER("Return-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Return-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Return-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return flow functions
     REG_COUNTER("CallToRet-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("CallToRet-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("CallToRet-FF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary flow functions
     // REG_COUNTER("Summary-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     // REG_COUNTER("Summary-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the normal edge functions
     REG_COUNTER("Normal-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Normal-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call edge functions
     REG_COUNTER("Call-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Call-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Call-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the return edge functions
     REG_COUNTER("Return-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Return-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Return-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the call to return edge functions
     REG_COUNTER("CallToRet-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("CallToRet-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("CallToRet-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
     // Counters for the summary edge functions
     REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Summary-EF Cache Eviction", 0, PAMM_SEVERITY_LEVEL::Full);
   }
 
   ~FlowEdgeFunctionCache() = default;
 
-  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = default;
-  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = default;
+  FlowEdgeFunctionCache(const FlowEdgeFunctionCache &FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(const FlowEdgeFunctionCache &FEFC) = delete;
 
-  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) noexcept = default;
-  FlowEdgeFunctionCache &
-  operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
+  FlowEdgeFunctionCache(FlowEdgeFunctionCache &&FEFC) = delete;
+  FlowEdgeFunctionCache &operator=(FlowEdgeFunctionCache &&FEFC) = delete;
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) {
     PAMM_GET_INSTANCE;
@@ -125,20 +200,23 @@ public:
                   << "(N) Curr Inst : " << problem.NtoString(curr);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Succ Inst : " << problem.NtoString(succ));
-    auto key = std::tie(curr, succ);
-    if (NormalFlowFunctionCache.count(key)) {
+    KeyT<n_t, n_t> Key(curr, succ);
+    std::lock_guard<std::mutex> Lock(NormalFFMutex);
+    if (auto *Cached = NormalFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return NormalFlowFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+                    ? makePooledShared<ZeroedFlowFunction<d_t, Container>>(
                           problem.getNormalFlowFunction(curr, succ), zeroValue)
                     : problem.getNormalFlowFunction(curr, succ);
-      NormalFlowFunctionCache.insert(make_pair(key, ff));
+      if (NormalFlowFunctionCache.insert(Key, ff)) {
+        INC_COUNTER("Normal-FF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -154,21 +232,24 @@ public:
                   << "(N) Call Stmt : " << problem.NtoString(callStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(F) Dest Fun : " << problem.FtoString(destFun));
-    auto key = std::tie(callStmt, destFun);
-    if (CallFlowFunctionCache.count(key)) {
+    KeyT<n_t, f_t> Key(callStmt, destFun);
+    std::lock_guard<std::mutex> Lock(CallFFMutex);
+    if (auto *Cached = CallFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallFlowFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff =
           (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+              ? makePooledShared<ZeroedFlowFunction<d_t, Container>>(
                     problem.getCallFlowFunction(callStmt, destFun), zeroValue)
               : problem.getCallFlowFunction(callStmt, destFun);
-      CallFlowFunctionCache.insert(std::make_pair(key, ff));
+      if (CallFlowFunctionCache.insert(Key, ff)) {
+        INC_COUNTER("Call-FF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -189,23 +270,26 @@ public:
                   << "(N) Exit Stmt : " << problem.NtoString(exitStmt);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Ret Site  : " << problem.NtoString(retSite));
-    auto key = std::tie(callSite, calleeFun, exitStmt, retSite);
-    if (ReturnFlowFunctionCache.count(key)) {
+    KeyT<n_t, f_t, n_t, n_t> Key(callSite, calleeFun, exitStmt, retSite);
+    std::lock_guard<std::mutex> Lock(ReturnFFMutex);
+    if (auto *Cached = ReturnFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return ReturnFlowFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff = (autoAddZero)
-                    ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+                    ? makePooledShared<ZeroedFlowFunction<d_t, Container>>(
                           problem.getRetFlowFunction(callSite, calleeFun,
                                                      exitStmt, retSite),
                           zeroValue)
                     : problem.getRetFlowFunction(callSite, calleeFun, exitStmt,
                                                  retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(key, ff));
+      if (ReturnFlowFunctionCache.insert(Key, ff)) {
+        INC_COUNTER("Return-FF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -214,7 +298,7 @@ public:
   }
 
   FlowFunctionPtrType getCallToRetFlowFunction(n_t callSite, n_t retSite,
-                                               std::set<f_t> callees) {
+                                               const std::set<f_t> &callees) {
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -227,23 +311,28 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto key = std::tie(callSite, retSite, callees);
-    if (CallToRetFlowFunctionCache.count(key)) {
+    std::lock_guard<std::mutex> Lock(CallToRetFFMutex);
+    KeyT<n_t, n_t, CalleeSetID> Key(callSite, retSite,
+                                    getCalleeSetID(callees));
+    if (auto *Cached = CallToRetFlowFunctionCache.lookup(Key)) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return CallToRetFlowFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff =
           (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+              ? makePooledShared<ZeroedFlowFunction<d_t, Container>>(
                     problem.getCallToRetFlowFunction(callSite, retSite,
                                                      callees),
                     zeroValue)
               : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(key, ff));
+      if (CallToRetFlowFunctionCache.insert(Key, ff)) {
+        INC_COUNTER("CallToRet-FF Cache Eviction", 1,
+                    PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -278,41 +367,19 @@ public:
                   << "(N) Succ Inst : " << problem.NtoString(succ);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Succ Node : " << problem.DtoString(succNode));
-    if (hasNormalEdgeFunction(curr, currNode, succ, succNode)) {
+    KeyT<n_t, d_t, n_t, d_t> Key(curr, currNode, succ, succNode);
+    std::lock_guard<std::mutex> Lock(NormalEFMutex);
+    if (auto *Cached = NormalEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-
-      EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-      auto SearchInnerMap = NormalEdgeFunctionCache.find(OuterMapKey);
-      assert(
-          SearchInnerMap != NormalEdgeFunctionCache.end() &&
-          "Outer map did not contain map node, which should be guaranteed by "
-          "hasNormalEdgeFunction.");
-
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
-          createEdgeFunctionNodeKey(currNode, succNode));
-      assert(SearchEdgeFunc != SearchInnerMap->second.end() &&
-             "Inner map did not contain EdgeFunction, which should be "
-             "guaranteed by hasNormalEdgeFunction");
-
-      return SearchEdgeFunc->second;
+      return *Cached;
     } else {
       INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
-
-      EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-      auto SearchInnerMap = NormalEdgeFunctionCache.find(OuterMapKey);
-      if (SearchInnerMap != NormalEdgeFunctionCache.end()) {
-        SearchInnerMap->second.emplace(
-            createEdgeFunctionNodeKey(currNode, succNode), ef);
-      } else {
-        NormalEdgeFunctionCache.emplace(
-            OuterMapKey,
-            InnerEdgeFunctionMapType{
-                {typename InnerEdgeFunctionMapType::value_type{
-                    createEdgeFunctionNodeKey(currNode, succNode), ef}}});
+      if (NormalEdgeFunctionCache.insert(Key, ef)) {
+        INC_COUNTER("Normal-EF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
       }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
@@ -335,18 +402,22 @@ public:
         << "(F) Dest Fun : " << problem.FtoString(destinationFunction);
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "(D) Dest Node : " << problem.DtoString(destNode));
-    auto key = std::tie(callStmt, srcNode, destinationFunction, destNode);
-    if (CallEdgeFunctionCache.count(key)) {
+    KeyT<n_t, d_t, f_t, d_t> Key(callStmt, srcNode, destinationFunction,
+                                    destNode);
+    std::lock_guard<std::mutex> Lock(CallEFMutex);
+    if (auto *Cached = CallEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return CallEdgeFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getCallEdgeFunction(callStmt, srcNode,
                                             destinationFunction, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(key, ef));
+      if (CallEdgeFunctionCache.insert(Key, ef)) {
+        INC_COUNTER("Call-EF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -372,19 +443,22 @@ public:
                   << "(N) Ret Site  : " << problem.NtoString(reSite);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retNode));
-    auto key =
-        std::tie(callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-    if (ReturnEdgeFunctionCache.count(key)) {
+    KeyT<n_t, f_t, n_t, d_t, n_t, d_t> Key(callSite, calleeFunction, exitStmt,
+                                             exitNode, reSite, retNode);
+    std::lock_guard<std::mutex> Lock(ReturnEFMutex);
+    if (auto *Cached = ReturnEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return ReturnEdgeFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getReturnEdgeFunction(
           callSite, calleeFunction, exitStmt, exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(key, ef));
+      if (ReturnEdgeFunctionCache.insert(Key, ef)) {
+        INC_COUNTER("Return-EF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -394,7 +468,7 @@ public:
 
   EdgeFunctionPtrType getCallToRetEdgeFunction(n_t callSite, d_t callNode,
                                                n_t retSite, d_t retSiteNode,
-                                               std::set<f_t> callees) {
+                                               const std::set<f_t> &callees) {
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -411,18 +485,22 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (CallToRetEdgeFunctionCache.count(key)) {
+    KeyT<n_t, d_t, n_t, d_t> Key(callSite, callNode, retSite, retSiteNode);
+    std::lock_guard<std::mutex> Lock(CallToRetEFMutex);
+    if (auto *Cached = CallToRetEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return CallToRetEdgeFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("CallToRet-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
                                                  retSiteNode, callees);
-      CallToRetEdgeFunctionCache.insert(std::make_pair(key, ef));
+      if (CallToRetEdgeFunctionCache.insert(Key, ef)) {
+        INC_COUNTER("CallToRet-EF Cache Eviction", 1,
+                    PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -444,18 +522,21 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retSiteNode);
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    auto key = std::tie(callSite, callNode, retSite, retSiteNode);
-    if (SummaryEdgeFunctionCache.count(key)) {
+    KeyT<n_t, d_t, n_t, d_t> Key(callSite, callNode, retSite, retSiteNode);
+    std::lock_guard<std::mutex> Lock(SummaryEFMutex);
+    if (auto *Cached = SummaryEdgeFunctionCache.lookup(Key)) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return SummaryEdgeFunctionCache.at(key);
+      return *Cached;
     } else {
       INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
                                                retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(key, ef));
+      if (SummaryEdgeFunctionCache.insert(Key, ef)) {
+        INC_COUNTER("Summary-EF Cache Eviction", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -474,24 +555,36 @@ public:
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal-flow function constructions: "
                     << GET_COUNTER("Normal-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Normal-flow function evictions: "
+                    << GET_COUNTER("Normal-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-flow function cache hits: "
                     << GET_COUNTER("Call-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-flow function constructions: "
                     << GET_COUNTER("Call-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-flow function evictions: "
+                    << GET_COUNTER("Call-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return-flow function cache hits: "
                     << GET_COUNTER("Return-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return-flow function constructions: "
                     << GET_COUNTER("Return-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Return-flow function evictions: "
+                    << GET_COUNTER("Return-FF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return-flow function cache hits: "
                     << GET_COUNTER("CallToRet-FF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return-flow function constructions: "
                     << GET_COUNTER("CallToRet-FF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-to-Return-flow function evictions: "
+                    << GET_COUNTER("CallToRet-FF Cache Eviction"));
       // LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Summary-flow function
       // cache hits: "
       //                        << GET_COUNTER("Summary-FF Cache Hit"));
@@ -511,6 +604,13 @@ public:
                             "Return-FF Construction",
                             "CallToRet-FF Construction" /*,
                 "Summary-FF Construction"*/}));
+      LOG_IF_ENABLE(
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Total flow function cache evictions: "
+          << GET_SUM_COUNT({"Normal-FF Cache Eviction",
+                            "Call-FF Cache Eviction",
+                            "Return-FF Cache Eviction",
+                            "CallToRet-FF Cache Eviction"}));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << ' ');
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal edge function cache hits: "
@@ -518,30 +618,45 @@ public:
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Normal edge function constructions: "
                     << GET_COUNTER("Normal-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Normal edge function evictions: "
+                    << GET_COUNTER("Normal-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call edge function cache hits: "
                     << GET_COUNTER("Call-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call edge function constructions: "
                     << GET_COUNTER("Call-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call edge function evictions: "
+                    << GET_COUNTER("Call-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return edge function cache hits: "
                     << GET_COUNTER("Return-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Return edge function constructions: "
                     << GET_COUNTER("Return-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Return edge function evictions: "
+                    << GET_COUNTER("Return-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return edge function cache hits: "
                     << GET_COUNTER("CallToRet-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Call-to-Return edge function constructions: "
                     << GET_COUNTER("CallToRet-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Call-to-Return edge function evictions: "
+                    << GET_COUNTER("CallToRet-EF Cache Eviction"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Summary edge function cache hits: "
                     << GET_COUNTER("Summary-EF Cache Hit"));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "Summary edge function constructions: "
                     << GET_COUNTER("Summary-EF Construction"));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                    << "Summary edge function evictions: "
+                    << GET_COUNTER("Summary-EF Cache Eviction"));
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Total edge function cache hits: "
@@ -555,6 +670,14 @@ public:
                             "Return-EF Construction",
                             "CallToRet-EF Construction",
                             "Summary-EF Construction"}));
+      LOG_IF_ENABLE(
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Total edge function cache evictions: "
+          << GET_SUM_COUNT({"Normal-EF Cache Eviction",
+                            "Call-EF Cache Eviction",
+                            "Return-EF Cache Eviction",
+                            "CallToRet-EF Cache Eviction",
+                            "Summary-EF Cache Eviction"}));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "----------------------------------------------");
     } else {
@@ -565,27 +688,16 @@ public:
   }
 
 private:
-  /// Checks if an EdgeFunction corresponding to the passed n_t/d_t values is
-  /// cached.
-  ///
-  /// \returns true, if a cache entry is present
-  inline bool hasNormalEdgeFunction(n_t curr, d_t currNode, n_t succ,
-                                    d_t succNode) {
-    auto Search =
-        NormalEdgeFunctionCache.find(createEdgeFunctionInstKey(curr, succ));
-    if (Search != NormalEdgeFunctionCache.end()) {
-      return Search->second.count(
-          createEdgeFunctionNodeKey(currNode, succNode));
+  /// Returns the unique ID of the given callee set; must be called with
+  /// CallToRetFFMutex held.
+  CalleeSetID getCalleeSetID(const std::set<f_t> &Callees) {
+    auto Search = CalleeSetIDs.find(Callees);
+    if (Search != CalleeSetIDs.end()) {
+      return Search->second;
     }
-    return false;
-  }
-
-  static inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t n1, n_t n2) {
-    return std::make_pair(n1, n2);
-  }
-
-  static inline EdgeFuncNodeKey createEdgeFunctionNodeKey(d_t d1, d_t d2) {
-    return std::make_pair(d1, d2);
+    CalleeSetID ID = CalleeSetIDs.size();
+    CalleeSetIDs.emplace(Callees, ID);
+    return ID;
   }
 };
 
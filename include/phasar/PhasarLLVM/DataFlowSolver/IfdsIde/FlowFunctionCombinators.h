@@ -0,0 +1,344 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_FLOWFUNCTIONCOMBINATORS_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_FLOWFUNCTIONCOMBINATORS_H_
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/Utils/PoolAllocator.h"
+
+namespace psr {
+
+/**
+ * Statically dispatched flow functions. Instead of nesting FlowFunction
+ * objects, e.g. a Union of a Compose of LambdaFlows, whose targets are
+ * computed by one virtual call, and possibly one std::function call, per
+ * nested function and fact, a flow function is written as an expression
+ *
+ *   auto FF = ff::makeFlowFunction<d_t>(ff::compose(
+ *       ff::kill(Store->getPointerOperand()),
+ *       ff::genIf(Store->getPointerOperand(),
+ *                 [Store](d_t Source) {
+ *                   return Source == Store->getValueOperand();
+ *                 })));
+ *
+ * whose type encodes the whole function, such that the compiler can inline
+ * it into a single FlowFunction. Only that FlowFunction is dispatched
+ * virtually by the solvers.
+ *
+ * An expression provides
+ *
+ *   template <typename D, typename OutTy>
+ *   void apply(const D &Source, OutTy &Targets) const;
+ *
+ * which inserts the targets of Source into Targets by calling
+ * Targets.insert(D). The expressions below follow the semantics of their
+ * counterparts in FlowFunctions.h. Expressions that have a gen/kill form
+ * additionally provide
+ *
+ *   template <typename D, typename Container>
+ *   std::optional<GenKillForm<D, Container>> genKillForm() const;
+ */
+namespace ff {
+
+template <typename ExprTy, typename D, typename Container, typename = void>
+struct HasGenKillForm : std::false_type {};
+
+template <typename ExprTy, typename D, typename Container>
+struct HasGenKillForm<
+    ExprTy, D, Container,
+    std::void_t<decltype(std::declval<const ExprTy &>()
+                             .template genKillForm<D, Container>())>>
+    : std::true_type {};
+
+/// Passes every fact as it is, see Identity.
+struct IdentityExpr {
+  template <typename D, typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    Targets.insert(Source);
+  }
+
+  template <typename D, typename Container>
+  std::optional<GenKillForm<D, Container>> genKillForm() const {
+    return GenKillForm<D, Container>{};
+  }
+};
+
+/// Generates GenValue from the zero value, see Gen.
+template <typename D> struct GenExpr {
+  D GenValue;
+  D ZeroValue;
+
+  template <typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    Targets.insert(Source);
+    if (Source == ZeroValue) {
+      Targets.insert(GenValue);
+    }
+  }
+
+  template <typename, typename Container>
+  std::optional<GenKillForm<D, Container>> genKillForm() const {
+    return GenKillForm<D, Container>{{GenValue}, ZeroValue, {}, false};
+  }
+};
+
+/// Generates GenValue from every fact that satisfies Pred, see GenIf.
+template <typename D, typename PredTy> struct GenIfExpr {
+  D GenValue;
+  PredTy Pred;
+
+  template <typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    Targets.insert(Source);
+    if (Pred(Source)) {
+      Targets.insert(GenValue);
+    }
+  }
+};
+
+/// Kills KillValue, see Kill.
+template <typename D> struct KillExpr {
+  D KillValue;
+
+  template <typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    if (!(Source == KillValue)) {
+      Targets.insert(Source);
+    }
+  }
+
+  template <typename, typename Container>
+  std::optional<GenKillForm<D, Container>> genKillForm() const {
+    return GenKillForm<D, Container>{{}, std::nullopt, {KillValue}, false};
+  }
+};
+
+/// Kills every fact that satisfies Pred, see KillIf.
+template <typename PredTy> struct KillIfExpr {
+  PredTy Pred;
+
+  template <typename D, typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    if (!Pred(Source)) {
+      Targets.insert(Source);
+    }
+  }
+};
+
+/// Kills every fact, see KillAll.
+struct KillAllExpr {
+  template <typename D, typename OutTy>
+  void apply(const D & /*Source*/, OutTy & /*Targets*/) const {}
+
+  template <typename D, typename Container>
+  std::optional<GenKillForm<D, Container>> genKillForm() const {
+    return GenKillForm<D, Container>{{}, std::nullopt, {}, true};
+  }
+};
+
+/// Copies FromValue to ToValue and kills ToValue otherwise, see Transfer.
+template <typename D> struct TransferExpr {
+  D ToValue;
+  D FromValue;
+
+  template <typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    if (Source == FromValue) {
+      Targets.insert(Source);
+      Targets.insert(ToValue);
+    } else if (!(Source == ToValue)) {
+      Targets.insert(Source);
+    }
+  }
+};
+
+/// Calls a user-defined function, either as F(Source, Targets), which
+/// inserts the targets itself, or as F(Source), which returns the targets
+/// in a container.
+template <typename FnTy> struct LambdaExpr {
+  FnTy Fn;
+
+  template <typename D, typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    if constexpr (std::is_invocable_v<const FnTy &, const D &, OutTy &>) {
+      Fn(Source, Targets);
+    } else {
+      for (const auto &Target : Fn(Source)) {
+        Targets.insert(Target);
+      }
+    }
+  }
+};
+
+/// Applies Second to every target of First.
+template <typename FirstTy, typename SecondTy> struct ComposeExpr {
+  FirstTy First;
+  SecondTy Second;
+
+  template <typename D, typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    // the intermediate targets may contain duplicates; Second then inserts
+    // the same targets again, which the target container ignores
+    struct {
+      llvm::SmallVector<D, 4> Facts;
+      void insert(const D &Fact) { Facts.push_back(Fact); }
+    } Intermediate;
+    First.apply(Source, Intermediate);
+    for (const D &Fact : Intermediate.Facts) {
+      Second.apply(Fact, Targets);
+    }
+  }
+};
+
+/// Computes the union of the targets of all given expressions.
+template <typename... ExprTys> struct UnionExpr {
+  std::tuple<ExprTys...> Exprs;
+
+  template <typename D, typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    std::apply(
+        [&Source, &Targets](const auto &... Expr) {
+          (Expr.apply(Source, Targets), ...);
+        },
+        Exprs);
+  }
+};
+
+/// Additionally passes the zero value, see ZeroedFlowFunction.
+template <typename D, typename ExprTy> struct ZeroedExpr {
+  ExprTy Expr;
+  D ZeroValue;
+
+  template <typename OutTy>
+  void apply(const D &Source, OutTy &Targets) const {
+    Expr.apply(Source, Targets);
+    if (Source == ZeroValue) {
+      Targets.insert(ZeroValue);
+    }
+  }
+
+  template <typename, typename Container>
+  std::optional<GenKillForm<D, Container>> genKillForm() const {
+    if constexpr (HasGenKillForm<ExprTy, D, Container>::value) {
+      auto Form = Expr.template genKillForm<D, Container>();
+      if (!Form || (Form->GenSource && !(*Form->GenSource == ZeroValue))) {
+        return std::nullopt;
+      }
+      Form->GenSource = ZeroValue;
+      Form->Gen.insert(ZeroValue);
+      return Form;
+    } else {
+      return std::nullopt;
+    }
+  }
+};
+
+inline IdentityExpr identity() { return {}; }
+
+template <typename D> GenExpr<D> gen(D GenValue, D ZeroValue) {
+  return {std::move(GenValue), std::move(ZeroValue)};
+}
+
+template <typename D, typename PredTy>
+GenIfExpr<D, PredTy> genIf(D GenValue, PredTy Pred) {
+  return {std::move(GenValue), std::move(Pred)};
+}
+
+template <typename D> KillExpr<D> kill(D KillValue) {
+  return {std::move(KillValue)};
+}
+
+template <typename PredTy> KillIfExpr<PredTy> killIf(PredTy Pred) {
+  return {std::move(Pred)};
+}
+
+inline KillAllExpr killAll() { return {}; }
+
+template <typename D> TransferExpr<D> transfer(D ToValue, D FromValue) {
+  return {std::move(ToValue), std::move(FromValue)};
+}
+
+template <typename FnTy> LambdaExpr<FnTy> lambda(FnTy Fn) {
+  return {std::move(Fn)};
+}
+
+template <typename FirstTy, typename SecondTy>
+ComposeExpr<FirstTy, SecondTy> compose(FirstTy First, SecondTy Second) {
+  return {std::move(First), std::move(Second)};
+}
+
+template <typename FirstTy, typename SecondTy, typename... RestTys>
+auto compose(FirstTy First, SecondTy Second, RestTys... Rest) {
+  return compose(compose(std::move(First), std::move(Second)),
+                 std::move(Rest)...);
+}
+
+template <typename... ExprTys> UnionExpr<ExprTys...> unite(ExprTys... Exprs) {
+  return {std::make_tuple(std::move(Exprs)...)};
+}
+
+template <typename D, typename ExprTy>
+ZeroedExpr<D, ExprTy> zeroed(ExprTy Expr, D ZeroValue) {
+  return {std::move(Expr), std::move(ZeroValue)};
+}
+
+/// The FlowFunction that evaluates an expression; this is the only level of
+/// virtual dispatch.
+template <typename D, typename Container, typename ExprTy>
+class StaticFlowFunction : public FlowFunction<D, Container> {
+public:
+  using typename FlowFunction<D, Container>::container_type;
+
+  explicit StaticFlowFunction(ExprTy Expr) : Expr(std::move(Expr)) {}
+
+  ~StaticFlowFunction() override = default;
+
+  container_type computeTargets(D Source) override {
+    container_type Targets;
+    Expr.apply(Source, Targets);
+    return Targets;
+  }
+
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    if constexpr (HasGenKillForm<ExprTy, D, Container>::value) {
+      return Expr.template genKillForm<D, Container>();
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] const ExprTy &getExpr() const { return Expr; }
+
+private:
+  ExprTy Expr;
+};
+
+/// Type-erases the given expression into a FlowFunction that can be handed
+/// to the solvers.
+template <typename D, typename Container = std::set<D>, typename ExprTy>
+std::shared_ptr<FlowFunction<D, Container>> makeFlowFunction(ExprTy Expr) {
+  return makePooledShared<StaticFlowFunction<D, Container, ExprTy>>(
+      std::move(Expr));
+}
+
+} // namespace ff
+
+} // namespace psr
+
+#endif
@@ -19,16 +19,31 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <type_traits>
 #include <vector>
 
+#include "llvm/ADT/STLExtras.h"
+
 namespace psr {
 
 //===----------------------------------------------------------------------===//
 //                              FlowFunction Class
 //===----------------------------------------------------------------------===//
 
+//
+// Describes a flow function of a gen/kill (bit-vector) problem: every fact
+// that is neither in Kill nor killed by KillAll is mapped to itself, and the
+// fact GenSource, if any, is additionally mapped to all facts in Gen.
+//
+template <typename D, typename Container = std::set<D>> struct GenKillForm {
+  Container Gen;
+  std::optional<D> GenSource;
+  Container Kill;
+  bool KillAll = false;
+};
+
 //
 // This class models a flow function for distributive data-flow problems.
 //
@@ -42,6 +57,8 @@ public:
 
   using container_type = Container;
   using value_type = typename container_type::value_type;
+  using EdgeHandlerType =
+      llvm::function_ref<void(const D &Source, const D &Target)>;
 
   virtual ~FlowFunction() = default;
 
@@ -57,6 +74,40 @@ public:
   // details.
   //
   virtual container_type computeTargets(D Source) = 0;
+
+  //
+  // Applies the flow function to all data-flow facts in Sources at once and
+  // calls Handler(Source, Target) for every exploded supergraph edge that is
+  // to be drawn, i.e. for every Target in computeTargets(Source). The solvers
+  // use this to push all facts that are pending at an instruction through a
+  // single call (see IFDSIDESolverConfig::setBatchFlowFunctions()).
+  //
+  // The default implementation calls computeTargets() for each fact. Flow
+  // functions that treat most facts alike, such as Identity or Kill,
+  // override it to emit the edges without building a container per fact.
+  // Handler must not be called twice for the same edge.
+  //
+  virtual void computeTargetsBatch(const container_type &Sources,
+                                   EdgeHandlerType Handler) {
+    for (const D &Source : Sources) {
+      for (const D &Target : computeTargets(Source)) {
+        Handler(Source, Target);
+      }
+    }
+  }
+
+  //
+  // Returns the gen/kill form of this flow function if it has one. Solvers
+  // that represent sets of facts as bit vectors then apply the flow function
+  // to all facts at once with bitwise operations rather than calling
+  // computeTargets() for each of them (see CompactIFDSSolver). The result
+  // must describe the same edges as computeTargets().
+  //
+  // The default implementation returns none.
+  //
+  virtual std::optional<GenKillForm<D, Container>> getGenKillForm() const {
+    return std::nullopt;
+  }
 };
 
 template <typename D, typename Container = std::set<D>>
@@ -66,12 +117,22 @@ public:
   using typename FlowFunction<D, Container>::FlowFunctionPtrType;
 
   using typename FlowFunction<D, Container>::container_type;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
   virtual ~Identity() = default;
   Identity(const Identity &i) = delete;
   Identity &operator=(const Identity &i) = delete;
   // simply return what the user provides
   container_type computeTargets(D source) override { return {source}; }
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    for (const D &Source : Sources) {
+      Handler(Source, Source);
+    }
+  }
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{};
+  }
   static std::shared_ptr<Identity> getInstance() {
     static std::shared_ptr<Identity> instance =
         std::shared_ptr<Identity>(new Identity);
@@ -146,6 +207,7 @@ protected:
 template <typename D, typename Container = std::set<D>>
 class Gen : public FlowFunction<D, Container> {
   using typename FlowFunction<D, Container>::container_type;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
 protected:
   D genValue;
@@ -162,6 +224,20 @@ public:
       return {source};
     }
   }
+
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    for (const D &Source : Sources) {
+      Handler(Source, Source);
+      if (Source == zeroValue && !(genValue == zeroValue)) {
+        Handler(Source, genValue);
+      }
+    }
+  }
+
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{{genValue}, zeroValue, {}, false};
+  }
 };
 
 /**
@@ -214,6 +290,10 @@ public:
     }
   }
 
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{genValues, zeroValue, {}, false};
+  }
+
 protected:
   container_type genValues;
   D zeroValue;
@@ -226,6 +306,7 @@ template <typename D, typename Container = std::set<D>>
 class Kill : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
   Kill(D killValue) : killValue(killValue) {}
   virtual ~Kill() = default;
@@ -237,6 +318,19 @@ public:
     }
   }
 
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    for (const D &Source : Sources) {
+      if (!(Source == killValue)) {
+        Handler(Source, Source);
+      }
+    }
+  }
+
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{{}, std::nullopt, {killValue}, false};
+  }
+
 protected:
   D killValue;
 };
@@ -269,7 +363,8 @@ class KillMultiple : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
 
-  KillMultiple(std::set<D> killValues) : killValues(killValues) {}
+  KillMultiple(std::set<D> killValues)
+      : killValues(killValues.begin(), killValues.end()) {}
   virtual ~KillMultiple() = default;
   container_type computeTargets(D source) override {
     if (killValues.find(source) != killValues.end()) {
@@ -279,6 +374,10 @@ public:
     }
   }
 
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{{}, std::nullopt, killValues, false};
+  }
+
 protected:
   container_type killValues;
 };
@@ -287,12 +386,18 @@ template <typename D, typename Container = std::set<D>>
 class KillAll : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
   virtual ~KillAll() = default;
   KillAll(const KillAll &k) = delete;
   KillAll &operator=(const KillAll &k) = delete;
   container_type computeTargets(D source) override { return container_type(); }
-  static std::shared_ptr<KillAll<D>> getInstance() {
+  void computeTargetsBatch(const container_type & /*Sources*/,
+                           EdgeHandlerType /*Handler*/) override {}
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    return GenKillForm<D, Container>{{}, std::nullopt, {}, true};
+  }
+  static std::shared_ptr<KillAll> getInstance() {
     static std::shared_ptr<KillAll> instance =
         std::shared_ptr<KillAll>(new KillAll);
     return instance;
@@ -306,6 +411,7 @@ template <typename D, typename Container = std::set<D>>
 class Transfer : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
   Transfer(D toValue, D fromValue) : toValue(toValue), fromValue(fromValue) {}
   virtual ~Transfer() = default;
@@ -319,6 +425,20 @@ public:
     }
   }
 
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    for (const D &Source : Sources) {
+      if (Source == fromValue) {
+        Handler(Source, Source);
+        if (!(toValue == fromValue)) {
+          Handler(Source, toValue);
+        }
+      } else if (!(Source == toValue)) {
+        Handler(Source, Source);
+      }
+    }
+  }
+
 protected:
   D toValue;
   D fromValue;
@@ -365,6 +485,7 @@ template <typename D, typename Container = std::set<D>>
 class ZeroedFlowFunction : public FlowFunction<D, Container> {
   using typename FlowFunction<D, Container>::container_type;
   using typename FlowFunction<D, Container>::FlowFunctionPtrType;
+  using typename FlowFunction<D, Container>::EdgeHandlerType;
 
 public:
   ZeroedFlowFunction(FlowFunctionPtrType ff, D zv)
@@ -379,6 +500,30 @@ public:
     }
   }
 
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    bool ZeroPassed = false;
+    delegate->computeTargetsBatch(
+        Sources, [this, &ZeroPassed, Handler](const D &Source,
+                                              const D &Target) {
+          ZeroPassed |= Source == zerovalue && Target == zerovalue;
+          Handler(Source, Target);
+        });
+    if (!ZeroPassed && Sources.count(zerovalue)) {
+      Handler(zerovalue, zerovalue);
+    }
+  }
+
+  std::optional<GenKillForm<D, Container>> getGenKillForm() const override {
+    auto Form = delegate->getGenKillForm();
+    if (!Form || (Form->GenSource && !(*Form->GenSource == zerovalue))) {
+      return std::nullopt;
+    }
+    Form->GenSource = zerovalue;
+    Form->Gen.insert(zerovalue);
+    return Form;
+  }
+
 private:
   FlowFunctionPtrType delegate;
   D zerovalue;
@@ -627,6 +772,23 @@ public:
   //
   virtual FlowFunctionPtrType getSummaryFlowFunction(n_t Curr,
                                                      f_t CalleeFun) = 0;
+
+  //
+  // Used for sparse propagation (cf.
+  // IFDSIDESolverConfig::setSparsePropagation()): describes whether the normal
+  // (non-call, non-return) instruction Inst may affect the data-flow fact Fact.
+  // If it returns false, the normal flow function at Inst must map Fact to
+  // {Fact} for every successor, and, for IDE problems, the respective normal
+  // edge function must be the identity. The data-flow solver then propagates
+  // Fact past Inst without querying any flow or edge functions, and does not
+  // record any results for Fact at Inst.
+  //
+  // A typical implementation checks whether Fact is an operand of Inst, which
+  // follows the def-use chains of Fact. Returning true is always sound.
+  //
+  // The default implementation considers every instruction relevant.
+  //
+  virtual bool isRelevant(n_t Inst, d_t Fact) { return true; }
 };
 } // namespace  psr
 
@@ -18,6 +18,7 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
 #include <iosfwd>
+#include <string>
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/Utils/EnumFlags.h"
@@ -34,10 +35,31 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  DenseJumpFunctions = 64,
+  MemoizeEdgeFunctions = 128,
+  SparsePropagation = 256,
+  BatchFlowFunctions = 512,
 
   All = ~0u
 };
 
+/// Determines how the IDESolver schedules the path edges of Phase I.
+/// Recursive processes every new path edge immediately from within
+/// propagate(); all other kinds use an explicit worklist of the respective
+/// order instead.
+enum class PathEdgeWorklistKind {
+  Recursive = 0,
+  FIFO,
+  LIFO,
+  ReversePostOrder
+};
+
+std::string toString(const PathEdgeWorklistKind &Kind);
+
+PathEdgeWorklistKind toPathEdgeWorklistKind(const std::string &S);
+
+std::ostream &operator<<(std::ostream &OS, const PathEdgeWorklistKind &Kind);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig();
   IFDSIDESolverConfig(SolverConfigOptions Options);
@@ -53,6 +75,16 @@ struct IFDSIDESolverConfig {
   bool recordEdges() const;
   bool emitESG() const;
   bool computePersistedSummaries() const;
+  bool denseJumpFunctions() const;
+  bool memoizeEdgeFunctions() const;
+  bool sparsePropagation() const;
+  bool batchFlowFunctions() const;
+  PathEdgeWorklistKind pathEdgeWorklistKind() const;
+  unsigned numThreads() const;
+  size_t flowEdgeFunctionCacheCapacity() const;
+  size_t maxEdgeFunctionChainLength() const;
+  size_t memoryBudget() const;
+  const std::string &esgTraceFile() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -60,6 +92,59 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  /// Stores the jump functions of each target node together and indexes
+  /// them by node-local fact IDs rather than in three nested hash tables.
+  /// Must be set before the solver is constructed.
+  void setDenseJumpFunctions(bool Set = true);
+  /// Memoizes the compositions and joins of edge functions the solver
+  /// computes and shares structurally equal results (see
+  /// EdgeFunctionMemoTable). The memo tables are bounded by the
+  /// flowEdgeFunctionCacheCapacity. Must be set before the solver is
+  /// constructed.
+  void setMemoizeEdgeFunctions(bool Set = true);
+  /// Propagates data-flow facts directly to the instructions that are
+  /// relevant to them (see FlowFunctions::isRelevant()) rather than along
+  /// every intra-procedural edge. Results are then only recorded at the
+  /// relevant instructions, call sites, start and exit points.
+  void setSparsePropagation(bool Set = true);
+  /// Groups the pending path edges of Phase I by their target node and
+  /// pushes all facts that are pending at a node through a single call of
+  /// each successor's normal flow function (see
+  /// FlowFunction::computeTargetsBatch()). Requires a single thread in
+  /// Phase I; a Recursive pathEdgeWorklistKind is then treated as FIFO.
+  void setBatchFlowFunctions(bool Set = true);
+  void setPathEdgeWorklistKind(PathEdgeWorklistKind Kind);
+  /// Sets the number of worker threads that construct the exploded
+  /// super-graph (Phase I). For more than one thread, path edges are
+  /// distributed over work-stealing queues and the pathEdgeWorklistKind is
+  /// ignored. Only problems that declare themselves thread-safe (see
+  /// IFDSTabulationProblem::isThreadSafe()) are solved on more than one
+  /// thread; debug logging should then be disabled.
+  void setNumThreads(unsigned N);
+  /// Limits the number of entries each of the solver's flow- and
+  /// edge-function caches and edge-function memo tables may hold. Entries
+  /// that have not been used recently are evicted and reconstructed on
+  /// demand. 0 means unbounded (default).
+  void setFlowEdgeFunctionCacheCapacity(size_t Capacity);
+  /// Limits the number of edge functions an EdgeFunctionComposer that the
+  /// IDESolver computes may be made of. Longer compositions are replaced by
+  /// AllBottom, i.e. the value is no longer tracked precisely along that
+  /// path. 0 means unbounded (default).
+  void setMaxEdgeFunctionChainLength(size_t Length);
+  /// Limits the resident set size of the process (in bytes) the IDESolver
+  /// aims for. Whenever it is exceeded during Phase I, the jump functions of
+  /// all nodes other than start points, call sites, exits and loop heads are
+  /// dropped for the functions that have no pending path edges, and they are
+  /// recomputed function by function in Phase II. Requires a single thread
+  /// in Phase I; a Recursive pathEdgeWorklistKind is then treated as FIFO.
+  /// 0 means unbounded (default).
+  void setMemoryBudget(size_t Bytes);
+  /// Appends the edges of the exploded super-graph that the IDESolver
+  /// computes to the given binary trace file (see ESGTraceReader), which
+  /// takes far less memory than recordEdges(). Both may be used at once.
+  /// An empty file name disables tracing (default). Must be set before the
+  /// solver is constructed.
+  void setESGTraceFile(std::string File);
 
   friend std::ostream &operator<<(std::ostream &OS,
                                   const IFDSIDESolverConfig &SC);
@@ -68,6 +153,12 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  PathEdgeWorklistKind WorklistKind = PathEdgeWorklistKind::Recursive;
+  unsigned NumThreads = 1;
+  size_t FlowEdgeFunctionCacheCapacity = 0;
+  size_t MaxEdgeFunctionChainLength = 0;
+  size_t MemoryBudget = 0;
+  std::string ESGTraceFile;
 };
 
 } // namespace psr
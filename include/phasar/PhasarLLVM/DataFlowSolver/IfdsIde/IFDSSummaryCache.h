@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_IFDSSUMMARYCACHE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_IFDSSUMMARYCACHE_H_
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace psr {
+
+/**
+ * Stores the summaries of functions that an IFDS solver may use instead of
+ * analyzing the functions again, e.g. across runs. A summary of a function
+ * holds the facts at its exit points that are reached from one fact at its
+ * start point.
+ */
+template <typename AnalysisDomainTy> class IFDSSummaryCache {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+
+  /// The facts per exit point that are reached from one fact at the start
+  /// point.
+  using SummaryTy = std::map<n_t, std::set<d_t>>;
+
+  virtual ~IFDSSummaryCache() = default;
+
+  /// Returns whether the summaries of Fun are taken from and stored in the
+  /// cache.
+  virtual bool isCacheable(f_t Fun) = 0;
+
+  /// Returns the summary of Fun for fact D1 at its start point, if cached.
+  virtual std::optional<SummaryTy> lookup(f_t Fun, d_t D1) = 0;
+
+  /// Stores the summary of Fun for fact D1 at its start point; returns false
+  /// if it cannot be stored.
+  virtual bool insert(f_t Fun, d_t D1, const SummaryTy &Summary) = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -21,6 +21,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
@@ -28,6 +29,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
 #include "phasar/PhasarLLVM/Utils/Printer.h"
+#include "phasar/Utils/Logger.h"
 #include "phasar/Utils/SoundnessFlag.h"
 
 namespace psr {
@@ -86,6 +88,42 @@ public:
 
   virtual std::map<n_t, std::set<d_t>> initialSeeds() = 0;
 
+  /// Returns the data-flow facts that may arise during the analysis, e.g.
+  /// the values of the analyzed program. Solvers that represent sets of
+  /// facts as bit vectors number these facts densely up front (see
+  /// CompactIFDSSolver); other facts are numbered when they first arise.
+  /// The default implementation returns no facts.
+  virtual std::vector<d_t> getFactUniverse() { return {}; }
+
+  /// Returns whether the flow functions of calls of Fun do more than
+  /// computing targets, e.g. record a leak in the problem. Solvers must not
+  /// replace the analysis of a function that (transitively) calls such a
+  /// function with a summary, as that would skip the side effects. The
+  /// default implementation returns false.
+  virtual bool hasSideEffects(f_t Fun) { return false; }
+
+  /// Returns whether the flow and edge functions of this problem may be
+  /// constructed and evaluated by several threads at once, i.e. they
+  /// neither record results in the problem nor lazily fill shared state
+  /// such as points-to sets. Problems that are not thread-safe are solved
+  /// on a single thread, whatever numThreads() their solver config sets.
+  /// The default implementation returns false.
+  virtual bool isThreadSafe() const { return false; }
+
+  /// Returns the number of threads a solver may use for this problem: the
+  /// solver config's numThreads() if the problem is thread-safe and 1
+  /// otherwise.
+  [[nodiscard]] unsigned getNumSolverThreads() const {
+    if (SolverConfig.numThreads() > 1 && !isThreadSafe()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "The analysis problem is not thread-safe, solving it "
+                       "on a single thread instead of "
+                    << SolverConfig.numThreads());
+      return 1;
+    }
+    return SolverConfig.numThreads();
+  }
+
   d_t getZeroValue() const { return ZeroValue; }
 
   [[nodiscard]] std::set<std::string> getEntryPoints() const {
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_LLVMIFDSSUMMARYCACHE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_LLVMIFDSSUMMARYCACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryCache.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * Persists the summaries of library functions, such as the internals of the
+ * C++ standard library, in a binary file, such that later runs of an
+ * analysis do not need to analyze them again.
+ *
+ * Summaries are keyed by the analysis they have been computed by and the
+ * hash of the function's IR together with the IR of all functions it
+ * (transitively) calls, cf. computeFunctionHash(). Functions that
+ * (transitively) contain indirect calls are not cached, as their summaries
+ * depend on the call-graph and points-to analyses. Solvers neither use nor
+ * store the summaries of functions that (transitively) call a function with
+ * side effects, cf. IFDSTabulationProblem::hasSideEffects(), as replaying a
+ * summary would skip them. Facts are stored relative to the summarized
+ * function: the zero value, arguments and instructions by their position and
+ * global values by their name. Summaries with any other facts are not
+ * stored.
+ *
+ * The analysis ID must identify the analysis and its configuration, e.g.
+ * the sources and sinks of a taint analysis, as summaries of different
+ * configurations must not be mixed up. Summaries of other analyses in the
+ * same file are retained.
+ */
+class LLVMIFDSSummaryCache
+    : public IFDSSummaryCache<LLVMAnalysisDomainDefault> {
+public:
+  /// The version of the file format.
+  static constexpr uint32_t FormatVersion = 1;
+
+  /// Returns whether F belongs to the C++ standard library.
+  static bool isStdLibraryFunction(const llvm::Function *F);
+
+  /**
+   * Creates a cache for the summaries of the given analysis that reads its
+   * summaries from and stores them in CacheFile. Only the summaries of
+   * functions that satisfy IsLibraryFunction are cached.
+   */
+  LLVMIFDSSummaryCache(
+      std::string AnalysisID, std::string CacheFile,
+      std::function<bool(const llvm::Function *)> IsLibraryFunction =
+          isStdLibraryFunction);
+
+  ~LLVMIFDSSummaryCache() override = default;
+
+  bool isCacheable(f_t Fun) override;
+
+  std::optional<SummaryTy> lookup(f_t Fun, d_t D1) override;
+
+  bool insert(f_t Fun, d_t D1, const SummaryTy &Summary) override;
+
+  /// Reads the summaries from the cache file; returns false if the file
+  /// cannot be read or has an unsupported format.
+  bool load();
+
+  /// Writes all summaries to the cache file; returns false on failure.
+  [[nodiscard]] bool store() const;
+
+  /// Returns the number of summaries of all analyses in the cache.
+  [[nodiscard]] size_t size() const { return Summaries.size(); }
+
+  /// Returns the number of summaries that have been looked up successfully.
+  [[nodiscard]] size_t getNumHits() const { return NumHits; }
+
+private:
+  // a fact relative to a function: its kind, a position and a name
+  struct PersistedFact {
+    enum Kind : uint8_t { Zero = 0, Argument, Instruction, Global };
+    uint8_t FactKind = Zero;
+    uint32_t Index = 0;
+    std::string Name;
+
+    bool operator<(const PersistedFact &Other) const {
+      return std::tie(FactKind, Index, Name) <
+             std::tie(Other.FactKind, Other.Index, Other.Name);
+    }
+  };
+  // the facts per position of an exit point
+  using PersistedSummary = std::map<uint32_t, std::vector<PersistedFact>>;
+  // analysis ID, function hash and fact at the start point
+  using KeyTy = std::tuple<std::string, uint64_t, PersistedFact>;
+
+  std::string AnalysisID;
+  std::string CacheFile;
+  std::function<bool(const llvm::Function *)> IsLibraryFunction;
+  std::map<KeyTy, PersistedSummary> Summaries;
+  // the hash of every cacheable function, none if not cacheable
+  std::unordered_map<f_t, std::optional<uint64_t>> Hashes;
+  // the instructions of every function in the order of their positions
+  std::unordered_map<f_t, std::vector<const llvm::Instruction *>>
+      Instructions;
+  size_t NumHits = 0;
+
+  std::optional<uint64_t> computeHash(f_t Fun);
+
+  const std::vector<const llvm::Instruction *> &getInstructions(f_t Fun);
+
+  std::optional<PersistedFact> persist(f_t Fun, d_t Fact);
+
+  d_t restore(f_t Fun, const PersistedFact &Fact);
+};
+
+} // namespace psr
+
+#endif
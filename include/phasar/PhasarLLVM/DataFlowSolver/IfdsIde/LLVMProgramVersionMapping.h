@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_LLVMPROGRAMVERSIONMAPPING_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_LLVMPROGRAMVERSIONMAPPING_H_
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ProgramVersionMapping.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+class LLVMPointsToInfo;
+class ProjectIRDB;
+
+/**
+ * Maps the IR of a previous version of a project to the IR of its current
+ * version. A function is unchanged if it is defined (or declared) in both
+ * versions and computeFunctionHash() yields the same hash for both. The
+ * arguments and instructions of an unchanged function are mapped by their
+ * position, global values by their name.
+ */
+class LLVMProgramVersionMapping
+    : public ProgramVersionMapping<LLVMAnalysisDomainDefault> {
+public:
+  LLVMProgramVersionMapping(const ProjectIRDB &PreviousIRDB,
+                            const ProjectIRDB &IRDB);
+
+  /// Additionally treats a function as changed if one of its pointers has a
+  /// different points-to set in PT than its counterpart in PreviousPT.
+  /// Aliases that cannot be mapped, e.g. external global variables, are
+  /// conservatively taken as a difference; constant expressions are ignored.
+  LLVMProgramVersionMapping(const ProjectIRDB &PreviousIRDB,
+                            const ProjectIRDB &IRDB,
+                            LLVMPointsToInfo &PreviousPT, LLVMPointsToInfo &PT);
+
+  ~LLVMProgramVersionMapping() override = default;
+
+  [[nodiscard]] std::optional<f_t> mapFunction(f_t Previous) const override;
+
+  [[nodiscard]] std::optional<n_t> mapStatement(n_t Previous) const override;
+
+  [[nodiscard]] std::optional<d_t> mapFact(d_t Previous) const override;
+
+  [[nodiscard]] bool comparesPointsToInfo() const override {
+    return ComparesPointsToInfo;
+  }
+
+  /// Returns the names of all functions that have been added, removed or
+  /// changed, including the ones whose points-to information changed.
+  [[nodiscard]] const std::set<std::string> &getChangedFunctions() const {
+    return ChangedFunctions;
+  }
+
+private:
+  const ProjectIRDB &IRDB;
+  std::unordered_map<const llvm::Function *, const llvm::Function *> Functions;
+  std::unordered_map<const llvm::Value *, const llvm::Value *> Values;
+  std::set<std::string> ChangedFunctions;
+  bool ComparesPointsToInfo = false;
+
+  [[nodiscard]] std::optional<const llvm::Value *>
+  mapPointer(const llvm::Value *Previous) const;
+
+  [[nodiscard]] bool hasSamePointsToSets(const llvm::Function *PreviousF,
+                                         LLVMPointsToInfo &PreviousPT,
+                                         LLVMPointsToInfo &PT) const;
+};
+
+} // namespace psr
+
+#endif
@@ -105,6 +105,9 @@ public:
 
 private:
   std::function<EdgeFactGeneratorTy> edgeFactGen;
+  // assigns the edge facts their bits in the BitVectorSets of this analysis,
+  // such that it does not share the global index with other analyses
+  BitVectorSetIndex<e_t> EdgeFactIndex;
   static inline const l_t BottomElement = Bottom{};
   static inline const l_t TopElement = Top{};
   // bool GeneratedGlobalVariables = false;
@@ -112,7 +115,7 @@ private:
   inline BitVectorSet<e_t> edgeFactGenToBitVectorSet(n_t curr) {
     if (edgeFactGen) {
       auto Results = edgeFactGen(curr);
-      BitVectorSet<e_t> BVS(Results.begin(), Results.end());
+      BitVectorSet<e_t> BVS(Results.begin(), Results.end(), EdgeFactIndex);
       return BVS;
     }
     return {};
@@ -128,8 +131,6 @@ public:
     this->ZeroValue =
         IDEInstInteractionAnalysisT<EdgeFactType, SyntacticAnalysisOnly,
                                     EnableIndirectTaints>::createZeroValue();
-    IIAAAddLabelsEF::initEdgeFunctionCleaner();
-    IIAAKillOrReplaceEF::initEdgeFunctionCleaner();
   }
 
   ~IDEInstInteractionAnalysisT() override = default;
@@ -513,7 +514,8 @@ public:
     if (edgeFactGen) {
       EdgeFacts = edgeFactGen(curr);
       // fill BitVectorSet
-      UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+      UserEdgeFacts =
+          BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end(), EdgeFactIndex);
     }
 
     // override at store instructions
@@ -916,16 +918,22 @@ public:
       OS << "\nFunction: " << fName << "\n----------"
          << std::string(fName.size(), '-') << '\n';
       for (const auto *stmt : this->ICF->getAllInstructionsOf(f)) {
-        auto results = SR.resultsAt(stmt, true);
-        stripBottomResults(results);
-        if (!results.empty()) {
-          OS << "At IR statement: " << this->NtoString(stmt) << '\n';
-          for (auto res : results) {
-            if (res.second != BottomElement) {
-              OS << "   Fact: " << this->DtoString(res.first)
-                 << "\n  Value: " << this->LtoString(res.second) << '\n';
-            }
-          }
+        bool hasResults = false;
+        SR.foreachResultAt(
+            stmt,
+            [&](d_t fact, const l_t &value) {
+              if (value == BottomElement) {
+                return;
+              }
+              if (!hasResults) {
+                hasResults = true;
+                OS << "At IR statement: " << this->NtoString(stmt) << '\n';
+              }
+              OS << "   Fact: " << this->DtoString(fact)
+                 << "\n  Value: " << this->LtoString(value) << '\n';
+            },
+            true);
+        if (hasResults) {
           OS << '\n';
         }
       }
@@ -101,6 +101,9 @@ public:
 
   bool isZeroValue(d_t d) const override;
 
+  // the flow and edge functions only read the IR
+  bool isThreadSafe() const override { return true; }
+
   // in addition provide specifications for the IDE parts
 
   std::shared_ptr<EdgeFunction<l_t>>
@@ -165,6 +168,8 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> other) const override;
 
+    size_t hash() const override;
+
     void print(std::ostream &OS, bool isForDebug = false) const override;
   };
 
@@ -143,6 +143,8 @@ public:
    */
   std::map<n_t, std::set<d_t>> initialSeeds() override;
 
+  std::vector<d_t> getFactUniverse() override;
+
   /**
    * @brief Returns appropriate zero value.
    */
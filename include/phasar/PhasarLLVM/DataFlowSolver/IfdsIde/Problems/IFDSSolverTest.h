@@ -13,59 +13,115 @@
 #include <initializer_list>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <set>
 #include <string>
+#include <utility>
 
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Value.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
-
-namespace llvm {
-class Instruction;
-class Function;
-class StructType;
-class Value;
-} // namespace llvm
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
 
 namespace psr {
 
-class LLVMBasedICFG;
 class LLVMTypeHierarchy;
 class LLVMPointsToInfo;
 
-class IFDSSolverTest : public IFDSTabulationProblem<LLVMAnalysisDomainDefault> {
+///
+/// Container: the container of the flow functions' targets, e.g.
+/// SmallFactSet<const llvm::Value *> to avoid the allocations of std::set
+///
+template <typename Container = std::set<LLVMAnalysisDomainDefault::d_t>>
+class IFDSSolverTestT
+    : public IFDSTabulationProblem<LLVMAnalysisDomainDefault, Container> {
 public:
-  IFDSSolverTest(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
-                 const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
-                 std::set<std::string> EntryPoints = {"main"});
+  using IFDSTabProblemType =
+      IFDSTabulationProblem<LLVMAnalysisDomainDefault, Container>;
+  using typename IFDSTabProblemType::FlowFunctionPtrType;
+
+  using d_t = typename LLVMAnalysisDomainDefault::d_t;
+  using n_t = typename LLVMAnalysisDomainDefault::n_t;
+  using f_t = typename LLVMAnalysisDomainDefault::f_t;
 
-  ~IFDSSolverTest() override = default;
+  IFDSSolverTestT(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                  const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                  std::set<std::string> EntryPoints = {"main"})
+      : IFDSTabProblemType(IRDB, TH, ICF, PT, std::move(EntryPoints)) {
+    this->ZeroValue = IFDSSolverTestT<Container>::createZeroValue();
+  }
 
-  FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override;
+  ~IFDSSolverTestT() override = default;
 
-  FlowFunctionPtrType getCallFlowFunction(n_t callStmt, f_t destFun) override;
+  FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override {
+    return Identity<d_t, Container>::getInstance();
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t callStmt,
+                                          f_t destFun) override {
+    return Identity<d_t, Container>::getInstance();
+  }
 
   FlowFunctionPtrType getRetFlowFunction(n_t callSite, f_t calleeFun,
-                                         n_t exitStmt, n_t retSite) override;
+                                         n_t exitStmt, n_t retSite) override {
+    return Identity<d_t, Container>::getInstance();
+  }
 
   FlowFunctionPtrType getCallToRetFlowFunction(n_t callSite, n_t retSite,
-                                               std::set<f_t> callees) override;
+                                               std::set<f_t> callees) override {
+    return Identity<d_t, Container>::getInstance();
+  }
 
   FlowFunctionPtrType getSummaryFlowFunction(n_t callStmt,
-                                             f_t destFun) override;
-
-  std::map<n_t, std::set<d_t>> initialSeeds() override;
-
-  d_t createZeroValue() const override;
-
-  bool isZeroValue(d_t d) const override;
-
-  void printNode(std::ostream &os, n_t n) const override;
-
-  void printDataFlowFact(std::ostream &os, d_t d) const override;
-
-  void printFunction(std::ostream &os, f_t m) const override;
+                                             f_t destFun) override {
+    return nullptr;
+  }
+
+  std::map<n_t, std::set<d_t>> initialSeeds() override {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "IFDSSolverTest::initialSeeds()");
+    std::map<n_t, std::set<d_t>> SeedMap;
+    for (const auto &EntryPoint : this->EntryPoints) {
+      SeedMap.insert(
+          std::make_pair(&this->ICF->getFunction(EntryPoint)->front().front(),
+                         std::set<d_t>({this->getZeroValue()})));
+    }
+    return SeedMap;
+  }
+
+  d_t createZeroValue() const override {
+    // create a special value to represent the zero value!
+    return LLVMZeroValue::getInstance();
+  }
+
+  bool isZeroValue(d_t d) const override {
+    return LLVMZeroValue::getInstance()->isLLVMZeroValue(d);
+  }
+
+  bool isThreadSafe() const override { return true; }
+
+  void printNode(std::ostream &os, n_t n) const override {
+    os << llvmIRToString(n);
+  }
+
+  void printDataFlowFact(std::ostream &os, d_t d) const override {
+    os << llvmIRToString(d);
+  }
+
+  void printFunction(std::ostream &os, f_t m) const override {
+    os << m->getName().str();
+  }
 };
 
+using IFDSSolverTest = IFDSSolverTestT<>;
+
 } // namespace psr
 
 #endif
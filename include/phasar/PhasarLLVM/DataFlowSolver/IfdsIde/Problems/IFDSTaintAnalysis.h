@@ -19,6 +19,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 // Forward declaration of types for which we only use its pointer or ref type
 namespace llvm {
@@ -82,8 +83,15 @@ public:
   FlowFunctionPtrType getSummaryFlowFunction(n_t callStmt,
                                              f_t destFun) override;
 
+  bool isRelevant(n_t Inst, d_t Fact) override;
+
   std::map<n_t, std::set<d_t>> initialSeeds() override;
 
+  std::vector<d_t> getFactUniverse() override;
+
+  /// Calls of sink functions record leaks.
+  bool hasSideEffects(f_t Fun) override;
+
   d_t createZeroValue() const override;
 
   bool isZeroValue(d_t d) const override;
@@ -96,6 +104,10 @@ public:
 
   void emitTextReport(const SolverResults<n_t, d_t, BinaryDomain> &SR,
                       std::ostream &OS = std::cout) override;
+
+  /// Returns all call sites that call a sink function, i.e. the statements
+  /// that have to be queried to find all leaks when solving on demand.
+  [[nodiscard]] std::set<n_t> getSinkCallSites() const;
 };
 } // namespace psr
 
@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
@@ -71,8 +72,12 @@ public:
   FlowFunctionPtrType getSummaryFlowFunction(n_t callStmt,
                                              f_t destFun) override;
 
+  bool isRelevant(n_t Inst, d_t Fact) override;
+
   std::map<n_t, std::set<d_t>> initialSeeds() override;
 
+  std::vector<d_t> getFactUniverse() override;
+
   d_t createZeroValue() const override;
 
   bool isZeroValue(d_t d) const override;
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_PROGRAMVERSIONMAPPING_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_PROGRAMVERSIONMAPPING_H_
+
+#include <optional>
+
+namespace psr {
+
+/**
+ * Relates the functions, statements and data-flow facts of a previous
+ * version of the program under analysis to their counterparts in the current
+ * version. Only entities that did not change between the two versions have
+ * a counterpart.
+ */
+template <typename AnalysisDomainTy> class ProgramVersionMapping {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+
+  virtual ~ProgramVersionMapping() = default;
+
+  /// Returns the counterpart of a previous function if it has not changed.
+  [[nodiscard]] virtual std::optional<f_t> mapFunction(f_t Previous) const = 0;
+
+  /// Returns the counterpart of a statement of an unchanged previous function.
+  [[nodiscard]] virtual std::optional<n_t> mapStatement(n_t Previous) const = 0;
+
+  /// Returns the counterpart of a previous data-flow fact, if there is any.
+  [[nodiscard]] virtual std::optional<d_t> mapFact(d_t Previous) const = 0;
+
+  /// Returns whether functions whose pointers have different points-to sets
+  /// in the two versions are treated as changed even if their code is not.
+  [[nodiscard]] virtual bool comparesPointsToInfo() const { return false; }
+};
+
+} // namespace psr
+
+#endif
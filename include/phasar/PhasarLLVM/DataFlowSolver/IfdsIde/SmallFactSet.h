@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SMALLFACTSET_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SMALLFACTSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "llvm/ADT/SmallVector.h"
+
+namespace psr {
+
+/**
+ * A set of data-flow facts that is stored as a sorted, duplicate-free
+ * vector whose first N elements live inside the object itself. Most flow
+ * functions produce only one or two facts per call, so using a SmallFactSet
+ * as the Container of a flow function, e.g.
+ *
+ *   IFDSTabulationProblem<AnalysisDomainTy, SmallFactSet<d_t>>
+ *
+ * avoids the heap allocations of std::set's tree nodes on every call.
+ * SmallFactSet provides the subset of std::set's interface that the flow
+ * functions and solvers rely on and iterates its facts in the same order.
+ * Inserting a single fact is linear in the size of the set, so it is not
+ * meant for sets of many facts that are built incrementally.
+ */
+template <typename D, unsigned N = 4> class SmallFactSet {
+  using StorageTy = llvm::SmallVector<D, N>;
+
+public:
+  using value_type = D;
+  using key_type = D;
+  using size_type = size_t;
+  using const_iterator = typename StorageTy::const_iterator;
+  using iterator = const_iterator;
+
+  SmallFactSet() = default;
+
+  SmallFactSet(std::initializer_list<D> Facts) {
+    insert(Facts.begin(), Facts.end());
+  }
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                 InputIt>::iterator_category>
+  SmallFactSet(InputIt First, InputIt Last) {
+    insert(First, Last);
+  }
+
+  std::pair<iterator, bool> insert(const D &Fact) {
+    auto Pos = std::lower_bound(Facts.begin(), Facts.end(), Fact, Less{});
+    if (Pos != Facts.end() && !Less{}(Fact, *Pos)) {
+      return {Pos, false};
+    }
+    return {Facts.insert(Pos, Fact), true};
+  }
+
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    size_t OldSize = Facts.size();
+    Facts.append(First, Last);
+    auto Mid = Facts.begin() + OldSize;
+    if (Mid == Facts.end()) {
+      return;
+    }
+    // only the new facts need to be sorted; they are merged with the old ones
+    // unless all of them are greater. Small sets are sorted as a whole, since
+    // std::inplace_merge may allocate a buffer.
+    std::sort(Mid, Facts.end(), Less{});
+    if (Mid != Facts.begin() && !Less{}(*std::prev(Mid), *Mid)) {
+      if (Facts.size() <= N) {
+        std::sort(Facts.begin(), Facts.end(), Less{});
+      } else {
+        std::inplace_merge(Facts.begin(), Mid, Facts.end(), Less{});
+      }
+    }
+    Facts.erase(std::unique(Facts.begin(), Facts.end(),
+                            [](const D &Lhs, const D &Rhs) {
+                              return !Less{}(Lhs, Rhs) && !Less{}(Rhs, Lhs);
+                            }),
+                Facts.end());
+  }
+
+  void insert(std::initializer_list<D> NewFacts) {
+    insert(NewFacts.begin(), NewFacts.end());
+  }
+
+  size_type erase(const D &Fact) {
+    auto Pos = find(Fact);
+    if (Pos == end()) {
+      return 0;
+    }
+    erase(Pos);
+    return 1;
+  }
+
+  iterator erase(iterator Pos) {
+    return Facts.erase(Facts.begin() + (Pos - Facts.begin()));
+  }
+
+  [[nodiscard]] iterator find(const D &Fact) const {
+    auto Pos = std::lower_bound(Facts.begin(), Facts.end(), Fact, Less{});
+    if (Pos != Facts.end() && !Less{}(Fact, *Pos)) {
+      return Pos;
+    }
+    return Facts.end();
+  }
+
+  [[nodiscard]] size_type count(const D &Fact) const {
+    return find(Fact) != end() ? 1 : 0;
+  }
+
+  [[nodiscard]] iterator begin() const { return Facts.begin(); }
+
+  [[nodiscard]] iterator end() const { return Facts.end(); }
+
+  [[nodiscard]] size_type size() const { return Facts.size(); }
+
+  [[nodiscard]] bool empty() const { return Facts.empty(); }
+
+  void clear() { Facts.clear(); }
+
+  void reserve(size_type Size) { Facts.reserve(Size); }
+
+  friend bool operator==(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    return Lhs.Facts == Rhs.Facts;
+  }
+
+  friend bool operator!=(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  friend bool operator<(const SmallFactSet &Lhs, const SmallFactSet &Rhs) {
+    return std::lexicographical_compare(Lhs.begin(), Lhs.end(), Rhs.begin(),
+                                        Rhs.end(), Less{});
+  }
+
+private:
+  using Less = std::less<D>;
+
+  StorageTy Facts;
+};
+
+} // namespace psr
+
+#endif
@@ -17,4 +17,373 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionMemoTable.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
+
+namespace psr {
+
+/**
+ * Solves a forward and a backward IDETabulationProblem over the same
+ * statements, facts and values together, cf. the bidirectional solver of
+ * Heros. Both problems are typically seeded at the same statement deep
+ * inside the program, e.g. at the source of an alias or taint query, and
+ * must follow returns past their seeds.
+ *
+ * The two directions are solved in lock-step, alternately processing one
+ * path edge (or batch of path edges) each. When a direction returns a fact
+ * through an unbalanced return, i.e. into a caller at a call site through
+ * which it has not entered the function, it records that it has reached
+ * that call site, and a leak if the fact is not the zero value. Unbalanced
+ * returns, including those of the zero value, are only propagated once the
+ * other direction has reached the same call site, i.e. once both directions
+ * have reached the common calling context; until then, they are paused.
+ * Returns that are still paused when both directions have finished are
+ * never propagated, which spares the analysis of all callers that only one
+ * direction reaches.
+ *
+ * The directions share the memo table of edge-function compositions and
+ * joins, which is created if either problem's solver config asks for
+ * memoized edge functions. Both directions run Phase I on the calling
+ * thread; their path edges are processed in the order of the configured
+ * path-edge worklist, or in FIFO order if none is configured. Apart from
+ * that, each direction honors its solver config like IDESolver::solve(),
+ * e.g. its memory budget, batched flow functions, ESG trace and statistics.
+ */
+template <typename FwAnalysisDomainTy, typename BwAnalysisDomainTy,
+          typename Container = std::set<typename FwAnalysisDomainTy::d_t>>
+class BiDiIDESolver {
+public:
+  using n_t = typename FwAnalysisDomainTy::n_t;
+  using d_t = typename FwAnalysisDomainTy::d_t;
+  using f_t = typename FwAnalysisDomainTy::f_t;
+  using l_t = typename FwAnalysisDomainTy::l_t;
+
+  static_assert(std::is_same_v<n_t, typename BwAnalysisDomainTy::n_t> &&
+                    std::is_same_v<d_t, typename BwAnalysisDomainTy::d_t> &&
+                    std::is_same_v<f_t, typename BwAnalysisDomainTy::f_t> &&
+                    std::is_same_v<l_t, typename BwAnalysisDomainTy::l_t>,
+                "Both directions must share statements, facts, functions and "
+                "values!");
+
+  BiDiIDESolver(
+      IDETabulationProblem<FwAnalysisDomainTy, Container> &ForwardProblem,
+      IDETabulationProblem<BwAnalysisDomainTy, Container> &BackwardProblem)
+      : Forward(ForwardProblem, "FW"), Backward(BackwardProblem, "BW") {
+    connect();
+  }
+
+  BiDiIDESolver(const BiDiIDESolver &) = delete;
+  BiDiIDESolver &operator=(const BiDiIDESolver &) = delete;
+  BiDiIDESolver(BiDiIDESolver &&) = delete;
+  BiDiIDESolver &operator=(BiDiIDESolver &&) = delete;
+
+  virtual ~BiDiIDESolver() = default;
+
+  /**
+   * @brief Runs both directions on their problems. This can take some time.
+   */
+  virtual void solve() {
+    PAMM_GET_INSTANCE;
+    IDESolver<FwAnalysisDomainTy, Container>::registerCounters();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Bidirectional IDE solver is solving the specified "
+                     "problems");
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    Forward.submitSeeds();
+    Backward.submitSeeds();
+    bool Progress = true;
+    while (Progress) {
+      Progress = Forward.processNextPathEdge();
+      Progress |= Backward.processNextPathEdge();
+    }
+    Forward.completeSeeds();
+    Backward.completeSeeds();
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    Forward.runPhaseII();
+    Backward.runPhaseII();
+    STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Problems solved, " << getNumPausedReturns()
+                  << " unbalanced returns remain paused, "
+                  << getNumPausedZeroReturns() << " of the zero value");
+    Forward.finishSolving();
+    Backward.finishSolving();
+  }
+
+  /// Returns the solver of the forward direction, e.g. to query its results.
+  IDESolver<FwAnalysisDomainTy, Container> &getForwardSolver() {
+    return Forward;
+  }
+
+  /// Returns the solver of the backward direction, e.g. to query its
+  /// results.
+  IDESolver<BwAnalysisDomainTy, Container> &getBackwardSolver() {
+    return Backward;
+  }
+
+  /// Returns the facts other than the zero value that the forward direction
+  /// has returned to the callers of unbalanced returns, by call site. They
+  /// are handed to the callers once the backward direction has reached the
+  /// same call site, see getNumPausedReturns().
+  [[nodiscard]] const std::unordered_map<n_t, std::set<d_t>> &
+  getForwardLeaks() const {
+    return Forward.getLeaks();
+  }
+
+  /// Returns the facts other than the zero value that the backward direction
+  /// has returned to the callers of unbalanced returns, by call site.
+  [[nodiscard]] const std::unordered_map<n_t, std::set<d_t>> &
+  getBackwardLeaks() const {
+    return Backward.getLeaks();
+  }
+
+  /// Returns the number of unbalanced returns of both directions that have
+  /// not been propagated (yet), as the other direction has not reached the
+  /// respective call site.
+  [[nodiscard]] size_t getNumPausedReturns() const {
+    return Forward.getNumPausedReturns() + Backward.getNumPausedReturns();
+  }
+
+  /// Returns the number of paused unbalanced returns that return the zero
+  /// value; they are included in getNumPausedReturns().
+  [[nodiscard]] size_t getNumPausedZeroReturns() const {
+    return Forward.getNumPausedZeroReturns() +
+           Backward.getNumPausedZeroReturns();
+  }
+
+  virtual void dumpResults(std::ostream &OS = std::cout) {
+    OS << "Forward direction:\n";
+    Forward.dumpResults(OS);
+    OS << "Backward direction:\n";
+    Backward.dumpResults(OS);
+  }
+
+protected:
+  // the interface through which the directions learn about each other's
+  // unbalanced returns
+  class Direction {
+  public:
+    virtual ~Direction() = default;
+
+    /// Returns whether this direction has tried to return a fact, possibly
+    /// the zero value, to the caller of an unbalanced return at CallSite.
+    [[nodiscard]] virtual bool hasReached(n_t CallSite) const = 0;
+
+    /// Returns whether this direction has tried to return a fact other than
+    /// the zero value to the caller of an unbalanced return at CallSite.
+    [[nodiscard]] virtual bool hasLeaked(n_t CallSite) const = 0;
+
+    /// Propagates the unbalanced returns at CallSite that have been paused.
+    virtual void resumePausedReturns(n_t CallSite) = 0;
+  };
+
+  template <typename AnalysisDomainTy>
+  class SingleDirectionSolver : public IDESolver<AnalysisDomainTy, Container>,
+                                public Direction {
+    using Base = IDESolver<AnalysisDomainTy, Container>;
+
+  public:
+    using typename Base::EdgeFunctionPtrType;
+
+    template <typename ProblemTy>
+    SingleDirectionSolver(ProblemTy &Problem, std::string DebugName)
+        : Base(Problem), DebugName(std::move(DebugName)) {
+      assert(this->SolverConfig.followReturnsPastSeeds() &&
+             "Bidirectional problems must follow returns past their seeds!");
+    }
+
+    ~SingleDirectionSolver() override = default;
+
+    void setOtherDirection(Direction &Other) { this->Other = &Other; }
+
+    std::shared_ptr<EdgeFunctionMemoTable<l_t>> &getEdgeFunctionMemo() {
+      return this->EdgeFunctionMemo;
+    }
+
+    /// Propagates the initial seeds without processing the resulting path
+    /// edges.
+    void submitSeeds() {
+      if (this->NumThreads > 1) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << '[' << DebugName
+                      << "] Phase I of bidirectional problems runs on the "
+                         "calling thread only");
+      }
+      this->preparePhaseI(true);
+      for (const auto &[StartPoint, Facts] : this->initialSeeds) {
+        for (const auto &Fact : Facts) {
+          this->submitSeed(StartPoint, Fact);
+        }
+      }
+    }
+
+    /// Processes the next path edge, or batch of path edges; returns false
+    /// if there is none left.
+    bool processNextPathEdge() {
+      if (this->PathEdgeWL->empty()) {
+        return false;
+      }
+      this->processNextWorklistPathEdge();
+      return true;
+    }
+
+    /// Completes Phase I once no path edges are left in either direction.
+    void completeSeeds() {
+      for (const auto &Seed : this->initialSeeds) {
+        this->jumpFn->addFunction(this->ZeroValue, Seed.first,
+                                  this->ZeroValue,
+                                  EdgeIdentity<l_t>::getInstance());
+      }
+      this->completePhaseI();
+    }
+
+    [[nodiscard]] bool hasReached(n_t CallSite) const override {
+      return Reached.count(CallSite);
+    }
+
+    [[nodiscard]] bool hasLeaked(n_t CallSite) const override {
+      return Leaked.count(CallSite);
+    }
+
+    void resumePausedReturns(n_t CallSite) override {
+      auto Search = Paused.find(CallSite);
+      if (Search == Paused.end()) {
+        return;
+      }
+      std::vector<PausedReturn> Returns = std::move(Search->second);
+      Paused.erase(Search);
+      NumPausedReturns -= Returns.size();
+      for (auto &Return : Returns) {
+        if (this->IDEProblem.isZeroValue(Return.TargetVal)) {
+          --NumPausedZeroReturns;
+        }
+        Base::propagteUnbalancedReturnFlow(Return.RetSite, Return.TargetVal,
+                                           std::move(Return.EdgeFunction),
+                                           CallSite);
+      }
+    }
+
+    [[nodiscard]] const std::unordered_map<n_t, std::set<d_t>> &
+    getLeaks() const {
+      return Leaked;
+    }
+
+    [[nodiscard]] size_t getNumPausedReturns() const {
+      return NumPausedReturns;
+    }
+
+    [[nodiscard]] size_t getNumPausedZeroReturns() const {
+      return NumPausedZeroReturns;
+    }
+
+  protected:
+    struct PausedReturn {
+      n_t RetSite;
+      d_t TargetVal;
+      EdgeFunctionPtrType EdgeFunction;
+    };
+
+    std::string DebugName;
+    Direction *Other = nullptr;
+    // the call sites to which this direction has returned unbalanced
+    std::unordered_set<n_t> Reached;
+    // the facts other than the zero value that this direction has returned
+    // unbalanced, by call site
+    std::unordered_map<n_t, std::set<d_t>> Leaked;
+    // the unbalanced returns that wait for the other direction to reach
+    // their call site
+    std::unordered_map<n_t, std::vector<PausedReturn>> Paused;
+    size_t NumPausedReturns = 0;
+    size_t NumPausedZeroReturns = 0;
+
+    void propagteUnbalancedReturnFlow(n_t RetSite, d_t TargetVal,
+                                      EdgeFunctionPtrType EdgeFunction,
+                                      n_t CallSite) override {
+      bool IsZero = this->IDEProblem.isZeroValue(TargetVal);
+      Reached.insert(CallSite);
+      if (!IsZero) {
+        Leaked[CallSite].insert(TargetVal);
+      }
+      if (Other->hasReached(CallSite)) {
+        Other->resumePausedReturns(CallSite);
+        Base::propagteUnbalancedReturnFlow(RetSite, std::move(TargetVal),
+                                           std::move(EdgeFunction), CallSite);
+        return;
+      }
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << '[' << DebugName << "] Pause unbalanced return to "
+                    << this->IDEProblem.NtoString(RetSite));
+      Paused[CallSite].push_back(
+          {RetSite, std::move(TargetVal), std::move(EdgeFunction)});
+      ++NumPausedReturns;
+      if (IsZero) {
+        ++NumPausedZeroReturns;
+      }
+    }
+  };
+
+  SingleDirectionSolver<FwAnalysisDomainTy> Forward;
+  SingleDirectionSolver<BwAnalysisDomainTy> Backward;
+
+  /// Solves the given IFDS problems, promoted to IDE problems like in
+  /// IFDSSolver.
+  template <typename FwIFDSAnalysisDomainTy, typename BwIFDSAnalysisDomainTy,
+            typename = std::enable_if_t<
+                is_analysis_domain_extensions<FwAnalysisDomainTy>::value &&
+                    is_analysis_domain_extensions<BwAnalysisDomainTy>::value,
+                FwIFDSAnalysisDomainTy>>
+  BiDiIDESolver(
+      IFDSTabulationProblem<FwIFDSAnalysisDomainTy, Container> &ForwardProblem,
+      IFDSTabulationProblem<BwIFDSAnalysisDomainTy, Container> &BackwardProblem)
+      : Forward(ForwardProblem, "FW"), Backward(BackwardProblem, "BW") {
+    connect();
+  }
+
+  void connect() {
+    Forward.setOtherDirection(Backward);
+    Backward.setOtherDirection(Forward);
+    // compositions and joins of edge functions do not depend on the direction
+    auto &ForwardMemo = Forward.getEdgeFunctionMemo();
+    auto &BackwardMemo = Backward.getEdgeFunctionMemo();
+    if (!ForwardMemo) {
+      ForwardMemo = BackwardMemo;
+    }
+    BackwardMemo = ForwardMemo;
+  }
+};
+
+template <typename FwProblem, typename BwProblem>
+BiDiIDESolver(FwProblem &, BwProblem &)
+    -> BiDiIDESolver<typename FwProblem::ProblemAnalysisDomain,
+                     typename BwProblem::ProblemAnalysisDomain,
+                     typename FwProblem::container_type>;
+
+template <typename FwProblem, typename BwProblem>
+using BiDiIDESolver_P =
+    BiDiIDESolver<typename FwProblem::ProblemAnalysisDomain,
+                  typename BwProblem::ProblemAnalysisDomain,
+                  typename FwProblem::container_type>;
+
+} // namespace psr
+
 #endif
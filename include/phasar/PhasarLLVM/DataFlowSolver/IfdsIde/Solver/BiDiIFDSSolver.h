@@ -16,4 +16,75 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 
+#include <set>
+#include <unordered_map>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BiDiIDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+
+namespace psr {
+
+/**
+ * Solves a forward and a backward IFDSTabulationProblem together, see
+ * BiDiIDESolver.
+ */
+template <typename FwAnalysisDomainTy, typename BwAnalysisDomainTy>
+class BiDiIFDSSolver
+    : public BiDiIDESolver<AnalysisDomainExtender<FwAnalysisDomainTy>,
+                           AnalysisDomainExtender<BwAnalysisDomainTy>> {
+  using Base = BiDiIDESolver<AnalysisDomainExtender<FwAnalysisDomainTy>,
+                             AnalysisDomainExtender<BwAnalysisDomainTy>>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::n_t;
+
+  BiDiIFDSSolver(IFDSTabulationProblem<FwAnalysisDomainTy> &ForwardProblem,
+                 IFDSTabulationProblem<BwAnalysisDomainTy> &BackwardProblem)
+      : Base(ForwardProblem, BackwardProblem) {}
+
+  ~BiDiIFDSSolver() override = default;
+
+  /// Returns the facts that the forward direction computed for Stmt.
+  std::set<d_t> forwardResultsAt(n_t Stmt) {
+    return getFacts(this->getForwardSolver(), Stmt);
+  }
+
+  /// Returns the facts that the backward direction computed for Stmt.
+  std::set<d_t> backwardResultsAt(n_t Stmt) {
+    return getFacts(this->getBackwardSolver(), Stmt);
+  }
+
+  /// Returns the facts that either direction computed for Stmt.
+  std::set<d_t> ifdsResultsAt(n_t Stmt) {
+    std::set<d_t> Facts = forwardResultsAt(Stmt);
+    Facts.merge(backwardResultsAt(Stmt));
+    return Facts;
+  }
+
+private:
+  template <typename SolverTy>
+  static std::set<d_t> getFacts(const SolverTy &Solver, n_t Stmt) {
+    std::set<d_t> Facts;
+    Solver.foreachResultAt(Stmt, [&Facts](d_t Fact, const BinaryDomain &) {
+      Facts.insert(Fact);
+    });
+    return Facts;
+  }
+};
+
+template <typename FwProblem, typename BwProblem>
+BiDiIFDSSolver(FwProblem &, BwProblem &)
+    -> BiDiIFDSSolver<typename FwProblem::ProblemAnalysisDomain,
+                      typename BwProblem::ProblemAnalysisDomain>;
+
+template <typename FwProblem, typename BwProblem>
+using BiDiIFDSSolver_P =
+    BiDiIFDSSolver<typename FwProblem::ProblemAnalysisDomain,
+                   typename BwProblem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
 #endif
@@ -0,0 +1,530 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BOTTOMUPIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BOTTOMUPIFDSSOLVER_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+/**
+ * Solves the given IFDSTabulationProblem like the CompactIFDSSolver, but
+ * computes the summaries of the functions bottom-up along the call graph
+ * before the initial seeds are propagated.
+ *
+ * The call graph that is reachable from the initial seeds is condensed into
+ * its strongly connected components (SCCs). Each SCC is summarized by a
+ * solver of its own as soon as all SCCs that it calls have been summarized,
+ * such that independent SCCs are summarized concurrently by the solver
+ * config's numThreads() workers if the problem is thread-safe. A function is
+ * summarized for the facts at its start point given by
+ * getSummaryEntryFacts(), and calls of functions of other SCCs apply their
+ * summaries rather than descending into them. The
+ * top-down pass from the initial seeds then applies the summaries, too, and
+ * only descends into functions for facts that they have not been summarized
+ * for. Finally, the results within the summarized functions are taken from
+ * the contexts that the top-down pass has (transitively) applied, so that
+ * the results are the same as the ones of CompactIFDSSolver.
+ *
+ * Functions that contain initial seeds and their (transitive) callers are
+ * not summarized, as their summaries depend on the seeds. Neither are the
+ * functions that have side effects or (transitively) call such a function,
+ * cf. IFDSTabulationProblem::hasSideEffects(): their flow functions are
+ * only evaluated by the top-down pass, for the facts that actually reach
+ * them, and on the calling thread. A summary cache
+ * that has been set before solve() is consulted for the functions that are
+ * not summarized bottom-up. The flow functions of thread-safe problems
+ * (cf. IFDSTabulationProblem::isThreadSafe()) are evaluated concurrently,
+ * but still constructed one at a time.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class BottomUpIFDSSolver
+    : public CompactIFDSSolver<AnalysisDomainTy, Container> {
+  using Base = CompactIFDSSolver<AnalysisDomainTy, Container>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::f_t;
+  using typename Base::n_t;
+
+  BottomUpIFDSSolver(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : Base(Problem) {}
+
+  ~BottomUpIFDSSolver() override = default;
+
+  void solve() override {
+    computeSCCs();
+    Store.setFallback(this->SummaryCache);
+    summarizeBottomUp();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Computed " << NumSummaries << " summaries of "
+                  << SCCs.size() << " call-graph SCCs bottom-up");
+    this->setSummaryCache(&Store);
+    Base::solve();
+    collectSummarizedResults();
+    Summarizers.clear();
+  }
+
+  /// Returns the number of summaries that have been computed bottom-up.
+  [[nodiscard]] size_t getNumSummaries() const { return NumSummaries; }
+
+  /// Returns the number of strongly connected components of the call graph
+  /// that is reachable from the initial seeds.
+  [[nodiscard]] size_t getNumSCCs() const { return SCCs.size(); }
+
+protected:
+  using typename Base::CachedSummaryTy;
+  using typename Base::FactID;
+
+  /**
+   * Returns the facts at the start point of Fun for which Fun is summarized
+   * in addition to the zero value. Subclasses may return the facts that
+   * calls of Fun are likely to produce, e.g. its formal parameters; other
+   * facts are analyzed top-down.
+   */
+  virtual std::set<d_t> getSummaryEntryFacts(f_t Fun) { return {}; }
+
+private:
+  /// A summary cache that may be used by several solvers at once.
+  class SummaryStore : public IFDSSummaryCache<AnalysisDomainTy> {
+  public:
+    using typename IFDSSummaryCache<AnalysisDomainTy>::SummaryTy;
+
+    void setFallback(IFDSSummaryCache<AnalysisDomainTy> *Cache) {
+      Fallback = Cache;
+    }
+
+    void addSummarizable(f_t Fun) { Summarizable.insert(Fun); }
+
+    [[nodiscard]] bool isSummarizable(f_t Fun) const {
+      return Summarizable.count(Fun);
+    }
+
+    bool isCacheable(f_t Fun) override {
+      if (isSummarizable(Fun)) {
+        return true;
+      }
+      std::lock_guard<std::mutex> Lock(Mutex);
+      return Fallback && Fallback->isCacheable(Fun);
+    }
+
+    std::optional<SummaryTy> lookup(f_t Fun, d_t D1) override {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (!isSummarizable(Fun)) {
+        return Fallback ? Fallback->lookup(Fun, D1) : std::nullopt;
+      }
+      auto Search = Summaries.find(Fun);
+      if (Search != Summaries.end()) {
+        auto FactSearch = Search->second.find(D1);
+        if (FactSearch != Search->second.end()) {
+          return FactSearch->second;
+        }
+      }
+      return std::nullopt;
+    }
+
+    bool insert(f_t Fun, d_t D1, const SummaryTy &Summary) override {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (!isSummarizable(Fun)) {
+        return Fallback && Fallback->insert(Fun, D1, Summary);
+      }
+      return Summaries[Fun].try_emplace(D1, Summary).second;
+    }
+
+  private:
+    std::mutex Mutex;
+    IFDSSummaryCache<AnalysisDomainTy> *Fallback = nullptr;
+    // only modified before the summaries are computed
+    std::unordered_set<f_t> Summarizable;
+    std::unordered_map<f_t, std::unordered_map<d_t, SummaryTy>> Summaries;
+  };
+
+  /// Computes the summaries of the functions of one SCC.
+  class Summarizer : public Base {
+    friend class BottomUpIFDSSolver;
+
+  public:
+    Summarizer(IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem,
+               SummaryStore &Store, std::mutex &ProblemMutex)
+        : Base(Problem) {
+      this->setSummaryCache(&Store);
+      this->ProblemMutex = &ProblemMutex;
+      // the summarized functions are reached without a call, but their
+      // callers are analyzed later on
+      this->FollowReturnsPastSeeds = false;
+    }
+
+    ~Summarizer() override = default;
+
+    /// Propagates every fact at the start points of its function in its own
+    /// context and adds the resulting summaries to the summary store.
+    size_t summarize(const std::map<f_t, std::set<d_t>> &EntryFacts) {
+      this->PathEdgeWL = this->makeSolverPathEdgeWorklist();
+      for (const auto &[Fun, Facts] : EntryFacts) {
+        for (const auto &Fact : Facts) {
+          FactID D1 = this->getFactID(Fact);
+          for (n_t SP : this->ICF->getStartPointsOf(Fun)) {
+            this->propagate(D1, SP, D1);
+          }
+          if (this->PathEdgeWL) {
+            this->processPathEdgeWorklist();
+          }
+        }
+      }
+      size_t NumSummaries = 0;
+      for (const auto &Entry : EntryFacts) {
+        f_t Fun = Entry.first;
+        // includes the contexts that have been reached by recursive calls
+        for (const auto &Context : this->PathEdges[Fun]) {
+          FactID D1 = Context.first;
+          CachedSummaryTy Summary;
+          for (const auto &[EP, ExitFacts] :
+               Base::factsByNode(this->EndSummaries, Fun, D1)) {
+            for (unsigned D : ExitFacts.set_bits()) {
+              Summary[EP].insert(this->Facts[D]);
+            }
+          }
+          NumSummaries +=
+              this->SummaryCache->insert(Fun, this->Facts[D1], Summary);
+        }
+      }
+      return NumSummaries;
+    }
+  };
+
+  SummaryStore Store;
+  std::mutex ProblemMutex;
+  // the SCCs of the reachable call graph in bottom-up order
+  std::vector<std::vector<f_t>> SCCs;
+  std::unordered_map<f_t, size_t> SCCOf;
+  // the SCCs that are called from each SCC
+  std::vector<std::set<size_t>> CalleeSCCs;
+  // the solver that has summarized each SCC, if any
+  std::vector<std::unique_ptr<Summarizer>> Summarizers;
+  size_t NumSummaries = 0;
+
+  [[nodiscard]] std::set<f_t> getCalleesOf(f_t Fun) const {
+    std::set<f_t> Callees;
+    for (n_t CallSite : this->ICF->getCallsFromWithin(Fun)) {
+      for (f_t Callee : this->ICF->getCalleesOfCallAt(CallSite)) {
+        // declarations have no summaries
+        if (!this->ICF->getStartPointsOf(Callee).empty()) {
+          Callees.insert(Callee);
+        }
+      }
+    }
+    return Callees;
+  }
+
+  /**
+   * Condenses the call graph that is reachable from the functions of the
+   * initial seeds into its SCCs using Tarjan's algorithm, which finds the
+   * SCCs in bottom-up order, and determines the summarizable functions.
+   */
+  void computeSCCs() {
+    std::unordered_map<f_t, std::set<f_t>> Callees;
+    std::unordered_map<f_t, size_t> Index;
+    std::unordered_map<f_t, size_t> LowLink;
+    std::vector<f_t> Stack;
+    std::unordered_set<f_t> OnStack;
+    // the DFS stack: a function and its callees that remain to be visited
+    std::vector<std::pair<f_t, std::vector<f_t>>> Path;
+    auto Visit = [&](f_t Fun) {
+      size_t FunIndex = Index.size();
+      Index[Fun] = FunIndex;
+      LowLink[Fun] = FunIndex;
+      Stack.push_back(Fun);
+      OnStack.insert(Fun);
+      const auto &FunCallees = Callees[Fun] = getCalleesOf(Fun);
+      Path.emplace_back(
+          Fun, std::vector<f_t>(FunCallees.rbegin(), FunCallees.rend()));
+    };
+    std::set<f_t> SeedFunctions;
+    for (const auto &Seed : this->initialSeeds) {
+      SeedFunctions.insert(this->ICF->getFunctionOf(Seed.first));
+    }
+    for (f_t Root : SeedFunctions) {
+      if (Index.count(Root)) {
+        continue;
+      }
+      Visit(Root);
+      while (!Path.empty()) {
+        auto &[Fun, Remaining] = Path.back();
+        if (!Remaining.empty()) {
+          f_t Callee = Remaining.back();
+          Remaining.pop_back();
+          if (!Index.count(Callee)) {
+            Visit(Callee);
+          } else if (OnStack.count(Callee)) {
+            LowLink[Fun] = std::min(LowLink[Fun], Index[Callee]);
+          }
+          continue;
+        }
+        f_t Done = Fun;
+        Path.pop_back();
+        if (!Path.empty()) {
+          f_t Caller = Path.back().first;
+          LowLink[Caller] = std::min(LowLink[Caller], LowLink[Done]);
+        }
+        if (LowLink[Done] != Index[Done]) {
+          continue;
+        }
+        // Done is the root of an SCC
+        auto &SCC = SCCs.emplace_back();
+        f_t Member;
+        do {
+          Member = Stack.back();
+          Stack.pop_back();
+          OnStack.erase(Member);
+          SCCOf[Member] = SCCs.size() - 1;
+          SCC.push_back(Member);
+        } while (Member != Done);
+      }
+    }
+    CalleeSCCs.assign(SCCs.size(), {});
+    for (size_t I = 0; I < SCCs.size(); ++I) {
+      for (f_t Fun : SCCs[I]) {
+        for (f_t Callee : Callees[Fun]) {
+          if (SCCOf[Callee] != I) {
+            CalleeSCCs[I].insert(SCCOf[Callee]);
+          }
+        }
+      }
+    }
+    // the summaries of the seeds' functions and all of their (transitive)
+    // callers depend on the seeds; callees come before their callers
+    std::vector<bool> Summarizable(SCCs.size(), true);
+    for (f_t Fun : SeedFunctions) {
+      Summarizable[SCCOf[Fun]] = false;
+    }
+    // the flow functions of side effects must only be evaluated for the
+    // facts that reach them top-down, and never concurrently
+    for (size_t I = 0; I < SCCs.size(); ++I) {
+      for (f_t Fun : SCCs[I]) {
+        if (!this->isSideEffectFree(Fun)) {
+          Summarizable[I] = false;
+        }
+      }
+    }
+    for (size_t I = 0; I < SCCs.size(); ++I) {
+      for (size_t Callee : CalleeSCCs[I]) {
+        if (!Summarizable[Callee]) {
+          Summarizable[I] = false;
+        }
+      }
+      if (Summarizable[I]) {
+        for (f_t Fun : SCCs[I]) {
+          Store.addSummarizable(Fun);
+        }
+      }
+    }
+  }
+
+  /**
+   * Summarizes the summarizable SCCs on the problem's
+   * getNumSolverThreads() worker threads. An SCC becomes ready once all SCCs that it calls have been
+   * summarized. The calling thread acts as the first worker. If a worker
+   * throws, all workers stop and the exception is rethrown here.
+   */
+  void summarizeBottomUp() {
+    // the entry facts of every SCC, which only this thread may ask for
+    std::vector<std::map<f_t, std::set<d_t>>> EntryFacts(SCCs.size());
+    std::vector<size_t> NumPendingCallees(SCCs.size(), 0);
+    std::vector<std::vector<size_t>> CallerSCCs(SCCs.size());
+    std::deque<size_t> Ready;
+    size_t NumRemaining = 0;
+    for (size_t I = 0; I < SCCs.size(); ++I) {
+      if (!Store.isSummarizable(SCCs[I].front())) {
+        continue;
+      }
+      for (f_t Fun : SCCs[I]) {
+        auto &Facts = EntryFacts[I][Fun] = getSummaryEntryFacts(Fun);
+        Facts.insert(this->ZeroValue);
+      }
+      // summarizable SCCs only call summarizable SCCs
+      NumPendingCallees[I] = CalleeSCCs[I].size();
+      for (size_t Callee : CalleeSCCs[I]) {
+        CallerSCCs[Callee].push_back(I);
+      }
+      if (!NumPendingCallees[I]) {
+        Ready.push_back(I);
+      }
+      ++NumRemaining;
+    }
+    Summarizers.resize(SCCs.size());
+    std::mutex Mutex;
+    std::condition_variable ReadyOrDone;
+    std::exception_ptr WorkerException;
+    auto Work = [&] {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      while (true) {
+        ReadyOrDone.wait(Lock, [&] {
+          return !Ready.empty() || !NumRemaining || WorkerException;
+        });
+        if (!NumRemaining || WorkerException) {
+          return;
+        }
+        size_t SCC = Ready.front();
+        Ready.pop_front();
+        Lock.unlock();
+        size_t NumSCCSummaries = 0;
+        try {
+          std::unique_ptr<Summarizer> S;
+          {
+            // the solver asks the problem for its zero value and seeds
+            std::lock_guard<std::mutex> ProblemLock(ProblemMutex);
+            S = std::make_unique<Summarizer>(this->IFDSProblem, Store,
+                                             ProblemMutex);
+          }
+          NumSCCSummaries = S->summarize(EntryFacts[SCC]);
+          Summarizers[SCC] = std::move(S);
+        } catch (...) {
+          Lock.lock();
+          if (!WorkerException) {
+            WorkerException = std::current_exception();
+          }
+          ReadyOrDone.notify_all();
+          return;
+        }
+        Lock.lock();
+        NumSummaries += NumSCCSummaries;
+        for (size_t Caller : CallerSCCs[SCC]) {
+          if (!--NumPendingCallees[Caller]) {
+            Ready.push_back(Caller);
+          }
+        }
+        --NumRemaining;
+        ReadyOrDone.notify_all();
+      }
+    };
+    std::vector<std::thread> Workers;
+    unsigned NumThreads = this->IFDSProblem.getNumSolverThreads();
+    for (unsigned I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back(Work);
+    }
+    Work();
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    if (WorkerException) {
+      std::rethrow_exception(WorkerException);
+    }
+  }
+
+  /**
+   * Adds the path edges of all summarized contexts that the top-down pass
+   * has applied to the results, as well as the ones of the contexts that
+   * these have applied in turn.
+   */
+  void collectSummarizedResults() {
+    // a context of a function that has been analyzed by a summarizer
+    using ContextTy = std::tuple<Summarizer *, f_t, d_t>;
+    std::vector<ContextTy> Worklist;
+    std::set<ContextTy> Visited;
+    // adds the context of Callee for fact D3, which the solver S (or the
+    // top-down pass if null) has either applied a summary for or analyzed
+    auto AddContext = [&](Summarizer *S, f_t Callee, FactID D3,
+                          const decltype(this->CachedSummaries) &Applied,
+                          const std::vector<d_t> &Facts) {
+      auto Search = Applied.find(Callee);
+      if (Search != Applied.end()) {
+        auto FactSearch = Search->second.find(D3);
+        if (FactSearch != Search->second.end() && FactSearch->second &&
+            Store.isSummarizable(Callee)) {
+          S = Summarizers[SCCOf[Callee]].get();
+        }
+      }
+      if (!S) {
+        return;
+      }
+      ContextTy Context(S, Callee, Facts[D3]);
+      if (Visited.insert(Context).second) {
+        Worklist.push_back(std::move(Context));
+      }
+    };
+    for (const auto &[Callee, Contexts] : this->CachedSummaries) {
+      for (const auto &Context : Contexts) {
+        AddContext(nullptr, Callee, Context.first, this->CachedSummaries,
+                   this->Facts);
+      }
+    }
+    while (!Worklist.empty()) {
+      auto [S, Fun, Fact] = Worklist.back();
+      Worklist.pop_back();
+      auto FunSearch = S->PathEdges.find(Fun);
+      if (FunSearch == S->PathEdges.end()) {
+        continue;
+      }
+      auto ContextSearch = FunSearch->second.find(S->FactIDs.at(Fact));
+      if (ContextSearch == FunSearch->second.end()) {
+        continue;
+      }
+      auto &Results = this->PathEdges[Fun][this->getFactID(Fact)];
+      for (const auto &[N, Reached] : ContextSearch->second) {
+        auto &NodeResults = Results[N];
+        for (unsigned D : Reached.set_bits()) {
+          Base::setBit(NodeResults, this->getFactID(S->Facts[D]));
+        }
+        if (!this->ICF->isCallStmt(N)) {
+          continue;
+        }
+        // the callee contexts that the call has been processed in
+        for (f_t Callee : this->ICF->getCalleesOfCallAt(N)) {
+          if (S->getSummaryFlowFunction(N, Callee)) {
+            continue;
+          }
+          auto CallFF = S->getCallFlowFunction(N, Callee);
+          for (unsigned D : Reached.set_bits()) {
+            for (d_t D3 : CallFF->computeTargets(S->Facts[D])) {
+              AddContext(S, Callee, S->getFactID(D3), S->CachedSummaries,
+                         S->Facts);
+            }
+          }
+        }
+      }
+    }
+    this->ResultsTabulated = false;
+    this->valtab.clear();
+  }
+};
+
+template <typename Problem>
+BottomUpIFDSSolver(Problem &)
+    -> BottomUpIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using BottomUpIFDSSolver_P =
+    BottomUpIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
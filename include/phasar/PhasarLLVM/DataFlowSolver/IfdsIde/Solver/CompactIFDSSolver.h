@@ -0,0 +1,936 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_COMPACTIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_COMPACTIFDSSOLVER_H_
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/BitVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/ClockCache.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/PoolAllocator.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/**
+ * Solves the given IFDSTabulationProblem with the tabulation algorithm of
+ * the 1995 paper by Reps, Horwitz and Sagiv, without promoting the problem
+ * to an IDE problem first. In contrast to IFDSSolver, no edge functions are
+ * created, composed or joined: a path edge (d1, n, d2) is a single bit.
+ *
+ * Data-flow facts are numbered in the order of their discovery. The path
+ * edges of a function are grouped by the fact d1 at its start point and
+ * stored as one bit vector over the facts d2 per node n. End summaries and
+ * incoming call edges are stored the same way.
+ *
+ * If the solver config's BatchFlowFunctions is set, the facts of the
+ * problem's fact universe (see IFDSTabulationProblem::getFactUniverse()) are
+ * numbered up front, such that the bit vectors are dense, and the path edges
+ * are batched by their target node. The normal flow functions that have a
+ * gen/kill form (see FlowFunction::getGenKillForm()) are then applied to the
+ * facts of all pending path edges of a context at once by bitwise
+ * operations; all other flow functions are evaluated once per fact.
+ *
+ * The results are the same as the ones of IFDSSolver and can be queried
+ * with ifdsResultsAt(), resultsAt() or as SolverResults. The solver honors
+ * the solver config's AutoAddZero, FollowReturnsPastSeeds, SparsePropagation,
+ * BatchFlowFunctions and PathEdgeWorklistKind settings as well as its
+ * flow-function cache capacity. If a summary cache is set, calls of
+ * cacheable functions apply their cached summaries instead of descending
+ * into them; with ComputePersistedSummaries, the summaries of all cacheable
+ * functions that have been analyzed are added to the cache after solving.
+ * It always runs on the calling thread and does not record or emit the
+ * exploded super-graph.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class CompactIFDSSolver {
+public:
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy, Container>;
+  using container_type = typename ProblemTy::container_type;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+
+  using l_t = BinaryDomain;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+
+  CompactIFDSSolver(IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : IFDSProblem(Problem), ZeroValue(Problem.createZeroValue()),
+        ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
+        CacheCapacity(SolverConfig.flowEdgeFunctionCacheCapacity()),
+        FollowReturnsPastSeeds(SolverConfig.followReturnsPastSeeds()),
+        initialSeeds(Problem.initialSeeds()) {
+    ZeroID = getFactID(ZeroValue);
+    if (SolverConfig.batchFlowFunctions()) {
+      for (auto &Fact : Problem.getFactUniverse()) {
+        getFactID(std::move(Fact));
+      }
+    }
+  }
+
+  CompactIFDSSolver(const CompactIFDSSolver &) = delete;
+  CompactIFDSSolver &operator=(const CompactIFDSSolver &) = delete;
+  CompactIFDSSolver(CompactIFDSSolver &&) = delete;
+  CompactIFDSSolver &operator=(CompactIFDSSolver &&) = delete;
+
+  virtual ~CompactIFDSSolver() = default;
+
+  /**
+   * @brief Runs the solver on the configured problem. This can take some time.
+   */
+  virtual void solve() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Compact-IFDS Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Compact-IFDS Facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Compact IFDS solver is solving the specified problem");
+    START_TIMER("Compact-IFDS Tabulation", PAMM_SEVERITY_LEVEL::Full);
+    submitInitialSeeds();
+    STOP_TIMER("Compact-IFDS Tabulation", PAMM_SEVERITY_LEVEL::Full);
+    INC_COUNTER("Compact-IFDS Path Edges", PathEdgeCount,
+                PAMM_SEVERITY_LEVEL::Core);
+    INC_COUNTER("Compact-IFDS Facts", Facts.size(), PAMM_SEVERITY_LEVEL::Core);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Problem solved, " << PathEdgeCount << " path edges over "
+                  << Facts.size() << " facts");
+    persistSummaries();
+  }
+
+  /**
+   * Sets the cache that summaries of library functions are taken from and,
+   * if the solver config's ComputePersistedSummaries is set, added to. The
+   * cache must outlive the solver.
+   */
+  void setSummaryCache(IFDSSummaryCache<AnalysisDomainTy> *Cache) {
+    SummaryCache = Cache;
+    CachedSummaries.clear();
+  }
+
+  /**
+   * Returns the data-flow facts that hold at the given statement.
+   */
+  [[nodiscard]] std::set<d_t> ifdsResultsAt(n_t Stmt) const {
+    std::set<d_t> Result;
+    const llvm::BitVector Reached = factsAt(Stmt);
+    for (unsigned D : Reached.set_bits()) {
+      Result.insert(Facts[D]);
+    }
+    return Result;
+  }
+
+  /**
+   * Returns BOTTOM if Fact holds at the given statement, TOP otherwise.
+   */
+  [[nodiscard]] l_t resultAt(n_t Stmt, d_t Fact) const {
+    auto Search = FactIDs.find(Fact);
+    if (Search != FactIDs.end()) {
+      const llvm::BitVector Reached = factsAt(Stmt);
+      if (Search->second < Reached.size() && Reached.test(Search->second)) {
+        return BinaryDomain::BOTTOM;
+      }
+    }
+    return BinaryDomain::TOP;
+  }
+
+  /**
+   * Returns the facts that hold at the given statement, mapped to BOTTOM, in
+   * the same form as IFDSSolver::resultsAt(). The artificial zero value can
+   * be automatically stripped.
+   */
+  [[nodiscard]] std::unordered_map<d_t, l_t>
+  resultsAt(n_t Stmt, bool StripZero = false) const {
+    std::unordered_map<d_t, l_t> Result;
+    const llvm::BitVector Reached = factsAt(Stmt);
+    for (unsigned D : Reached.set_bits()) {
+      if (!StripZero || D != ZeroID) {
+        Result.emplace(Facts[D], BinaryDomain::BOTTOM);
+      }
+    }
+    return Result;
+  }
+
+  /**
+   * Returns the results for all statements. They are tabulated on the first
+   * call after solve().
+   */
+  SolverResults<n_t, d_t, l_t> getSolverResults() {
+    if (!ResultsTabulated) {
+      for (const auto &[Fun, Contexts] : PathEdges) {
+        for (const auto &[D1, Nodes] : Contexts) {
+          for (const auto &[Node, Reached] : Nodes) {
+            for (unsigned D : Reached.set_bits()) {
+              valtab.insert(Node, Facts[D], BinaryDomain::BOTTOM);
+            }
+          }
+        }
+      }
+      ResultsTabulated = true;
+    }
+    return SolverResults<n_t, d_t, l_t>(valtab, ZeroValue);
+  }
+
+  virtual void emitTextReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitTextReport(getSolverResults(), OS);
+  }
+
+  virtual void emitGraphicalReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitGraphicalReport(getSolverResults(), OS);
+  }
+
+  virtual void dumpResults(std::ostream &OS = std::cout) {
+    OS << "\n***************************************************************\n"
+       << "*              Raw CompactIFDSSolver results                  *\n"
+       << "***************************************************************\n";
+    std::map<n_t, std::set<d_t>> Results;
+    for (const auto &[Fun, Contexts] : PathEdges) {
+      for (const auto &[D1, Nodes] : Contexts) {
+        for (const auto &[Node, Reached] : Nodes) {
+          for (unsigned D : Reached.set_bits()) {
+            Results[Node].insert(Facts[D]);
+          }
+        }
+      }
+    }
+    if (Results.empty()) {
+      OS << "No results computed!" << std::endl;
+    }
+    for (const auto &[Node, NodeFacts] : Results) {
+      OS << "\nN: " << IFDSProblem.NtoString(Node) << '\n';
+      for (const auto &Fact : NodeFacts) {
+        OS << "\tD: " << IFDSProblem.DtoString(Fact) << '\n';
+      }
+    }
+    OS << '\n';
+  }
+
+  /// Returns the number of distinct path edges that have been propagated.
+  [[nodiscard]] size_t getNumPathEdges() const { return PathEdgeCount; }
+
+  /// Returns the number of distinct data-flow facts that have been seen or,
+  /// with BatchFlowFunctions, numbered up front.
+  [[nodiscard]] size_t getNumFacts() const { return Facts.size(); }
+
+protected:
+  using FactID = unsigned;
+  // facts per node of a function
+  using NodeFacts = std::unordered_map<n_t, llvm::BitVector>;
+  // facts per node of a function, grouped by the fact at its start point
+  using ContextFacts = std::map<FactID, NodeFacts>;
+  using CachedSummaryTy =
+      typename IFDSSummaryCache<AnalysisDomainTy>::SummaryTy;
+
+  template <typename... Ts> using KeyT = FlowEdgeFunctionCacheKey<Ts...>;
+  template <typename KeyTy>
+  using CacheT =
+      ClockCache<KeyTy, FlowFunctionPtrType, typename KeyTy::Hasher>;
+
+  // returns the pooled memory of the flow functions to the heap once all
+  // other members are destroyed
+  PooledMemoryScope PoolScope;
+  IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem;
+  d_t ZeroValue;
+  FactID ZeroID = 0;
+  const i_t *ICF;
+  IFDSIDESolverConfig &SolverConfig;
+  // Maximum number of entries per flow-function cache, 0 means unbounded
+  size_t CacheCapacity;
+  size_t PathEdgeCount = 0;
+  // whether facts that originate from zero are returned to all callers of a
+  // function that has been reached without a call, see processExit()
+  bool FollowReturnsPastSeeds;
+  // guards the construction of flow functions if the problem is shared with
+  // solvers on other threads
+  std::mutex *ProblemMutex = nullptr;
+
+  // path edges waiting to be processed; processed recursively if null
+  std::unique_ptr<PathEdgeWorklist<n_t, FactID>> PathEdgeWL;
+
+  std::vector<d_t> Facts;
+  std::unordered_map<d_t, FactID> FactIDs;
+
+  // the path edges (d1, n, d2) of every function
+  std::unordered_map<f_t, ContextFacts> PathEdges;
+  // the facts d2 at exit node eP of every function that have been reached
+  // from fact d1 at its start point
+  std::unordered_map<f_t, ContextFacts> EndSummaries;
+  // the facts d2 at call site n from which fact d3 at a callee's start point
+  // has been reached
+  std::unordered_map<f_t, ContextFacts> Incoming;
+
+  // stores the return sites (inside callers) to which we have unbalanced
+  // returns if SolverConfig.followReturnPastSeeds is enabled
+  std::set<n_t> unbalancedRetSites;
+
+  std::map<n_t, std::set<d_t>> initialSeeds;
+
+  Table<n_t, d_t, l_t> valtab;
+  bool ResultsTabulated = false;
+
+  IFDSSummaryCache<AnalysisDomainTy> *SummaryCache = nullptr;
+  // the summaries that have been looked up in the cache, per callee and fact
+  // at its start point; none if the summary is not cached
+  std::unordered_map<
+      f_t, std::unordered_map<FactID, std::optional<CachedSummaryTy>>>
+      CachedSummaries;
+  // whether a function and its (transitive) callees are free of side
+  // effects, see isSideEffectFree()
+  std::unordered_map<f_t, bool> SideEffectFree;
+
+  CacheT<KeyT<n_t, n_t>> NormalFlowFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, f_t>> CallFlowFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, f_t, n_t, n_t>> ReturnFlowFunctionCache{CacheCapacity};
+  CacheT<KeyT<n_t, n_t>> CallToRetFlowFunctionCache{CacheCapacity};
+  ClockCache<KeyT<n_t, FactID>, std::vector<n_t>,
+             typename KeyT<n_t, FactID>::Hasher>
+      SparseTargetsCache{CacheCapacity};
+
+  FactID getFactID(d_t Fact) {
+    auto [It, Inserted] = FactIDs.try_emplace(Fact, Facts.size());
+    if (Inserted) {
+      Facts.push_back(std::move(Fact));
+    }
+    return It->second;
+  }
+
+  /// Sets bit D in Bits; returns false if it was set already.
+  static bool setBit(llvm::BitVector &Bits, FactID D) {
+    if (D >= Bits.size()) {
+      Bits.resize(D + 1);
+    } else if (Bits.test(D)) {
+      return false;
+    }
+    Bits.set(D);
+    return true;
+  }
+
+  /// Returns the facts that hold at Stmt in any context of its function.
+  llvm::BitVector factsAt(n_t Stmt) const {
+    llvm::BitVector Reached;
+    auto Search = PathEdges.find(ICF->getFunctionOf(Stmt));
+    if (Search != PathEdges.end()) {
+      for (const auto &[D1, Nodes] : Search->second) {
+        auto NodeSearch = Nodes.find(Stmt);
+        if (NodeSearch != Nodes.end()) {
+          Reached |= NodeSearch->second;
+        }
+      }
+    }
+    return Reached;
+  }
+
+  /// Returns a copy of the facts at Stmt for every context of Fun in Table.
+  /// Copies are handed out because propagating may modify Table.
+  static std::vector<std::pair<FactID, llvm::BitVector>>
+  factsByContext(const std::unordered_map<f_t, ContextFacts> &Table, f_t Fun,
+                 n_t Stmt) {
+    std::vector<std::pair<FactID, llvm::BitVector>> Result;
+    auto Search = Table.find(Fun);
+    if (Search != Table.end()) {
+      for (const auto &[D1, Nodes] : Search->second) {
+        auto NodeSearch = Nodes.find(Stmt);
+        if (NodeSearch != Nodes.end()) {
+          Result.emplace_back(D1, NodeSearch->second);
+        }
+      }
+    }
+    return Result;
+  }
+
+  /// Returns a copy of the facts per node of Fun in context D1 in Table.
+  static std::vector<std::pair<n_t, llvm::BitVector>>
+  factsByNode(const std::unordered_map<f_t, ContextFacts> &Table, f_t Fun,
+              FactID D1) {
+    std::vector<std::pair<n_t, llvm::BitVector>> Result;
+    auto Search = Table.find(Fun);
+    if (Search != Table.end()) {
+      auto ContextSearch = Search->second.find(D1);
+      if (ContextSearch != Search->second.end()) {
+        Result.assign(ContextSearch->second.begin(),
+                      ContextSearch->second.end());
+      }
+    }
+    return Result;
+  }
+
+  template <typename KeyTy, typename FactoryTy>
+  FlowFunctionPtrType getFlowFunction(CacheT<KeyTy> &Cache, KeyTy Key,
+                                      FactoryTy Factory) {
+    if (auto *Cached = Cache.lookup(Key)) {
+      return *Cached;
+    }
+    FlowFunctionPtrType FF;
+    {
+      std::unique_lock<std::mutex> Lock;
+      if (ProblemMutex) {
+        Lock = std::unique_lock<std::mutex>(*ProblemMutex);
+      }
+      FF = Factory();
+    }
+    if (SolverConfig.autoAddZero()) {
+      FF = makePooledShared<ZeroedFlowFunction<d_t, Container>>(std::move(FF),
+                                                                ZeroValue);
+    }
+    Cache.insert(std::move(Key), FF);
+    return FF;
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) {
+    return getFlowFunction(NormalFlowFunctionCache, KeyT<n_t, n_t>(Curr, Succ),
+                           [&] {
+                             return IFDSProblem.getNormalFlowFunction(Curr,
+                                                                      Succ);
+                           });
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t Callee) {
+    return getFlowFunction(
+        CallFlowFunctionCache, KeyT<n_t, f_t>(CallSite, Callee),
+        [&] { return IFDSProblem.getCallFlowFunction(CallSite, Callee); });
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t Callee,
+                                         n_t ExitStmt, n_t RetSite) {
+    return getFlowFunction(
+        ReturnFlowFunctionCache,
+        KeyT<n_t, f_t, n_t, n_t>(CallSite, Callee, ExitStmt, RetSite), [&] {
+          return IFDSProblem.getRetFlowFunction(CallSite, Callee, ExitStmt,
+                                                RetSite);
+        });
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t CallSite, f_t Callee) {
+    // special summaries are not cached
+    std::unique_lock<std::mutex> Lock;
+    if (ProblemMutex) {
+      Lock = std::unique_lock<std::mutex>(*ProblemMutex);
+    }
+    return IFDSProblem.getSummaryFlowFunction(CallSite, Callee);
+  }
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               const std::set<f_t> &Callees) {
+    // the callees are determined by the call site
+    return getFlowFunction(CallToRetFlowFunctionCache,
+                           KeyT<n_t, n_t>(CallSite, RetSite), [&] {
+                             return IFDSProblem.getCallToRetFlowFunction(
+                                 CallSite, RetSite, Callees);
+                           });
+  }
+
+  /// Decides whether the path edge (D1, Target, D2) is tabulated. Subclasses
+  /// may hold back path edges into parts of the program that they are not
+  /// interested in (yet) and propagate them later on.
+  virtual bool admitPathEdge(FactID D1, n_t Target, FactID D2) { return true; }
+
+  /// Processes the call from N to Callee for the path edge (D1, N, D2)
+  /// without descending into Callee, e.g. because Callee is not part of the
+  /// interprocedural control-flow graph but its effect is known otherwise;
+  /// returns false if the call has to be processed as usual. The
+  /// call-to-return flow is processed in either case.
+  virtual bool applyCalleeSummary(FactID D1, n_t N, FactID D2, f_t Callee,
+                                  const std::set<n_t> &ReturnSites) {
+    return false;
+  }
+
+  /// Returns whether neither Fun nor any function it (transitively) calls
+  /// has side effects, cf. IFDSTabulationProblem::hasSideEffects().
+  bool isSideEffectFree(f_t Fun) {
+    auto [It, Inserted] = SideEffectFree.try_emplace(Fun, true);
+    if (!Inserted) {
+      return It->second;
+    }
+    std::vector<f_t> WorkList = {Fun};
+    std::unordered_set<f_t> Visited = {Fun};
+    while (!WorkList.empty()) {
+      f_t F = WorkList.back();
+      WorkList.pop_back();
+      if (IFDSProblem.hasSideEffects(F)) {
+        return It->second = false;
+      }
+      for (n_t CallSite : ICF->getCallsFromWithin(F)) {
+        for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+          if (Visited.insert(Callee).second) {
+            WorkList.push_back(Callee);
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Returns the cached summary of Callee for fact D3 at its start point or
+  /// null if there is none.
+  const CachedSummaryTy *getCachedSummary(f_t Callee, FactID D3) {
+    if (!SummaryCache) {
+      return nullptr;
+    }
+    auto [It, Inserted] = CachedSummaries[Callee].try_emplace(D3);
+    if (Inserted && SummaryCache->isCacheable(Callee) &&
+        isSideEffectFree(Callee)) {
+      It->second = SummaryCache->lookup(Callee, Facts[D3]);
+    }
+    return It->second ? &*It->second : nullptr;
+  }
+
+  /// Adds the summaries of all cacheable functions that have been analyzed
+  /// to the summary cache if ComputePersistedSummaries is set. Must only be
+  /// called once all path edges have been processed.
+  void persistSummaries() {
+    if (!SummaryCache || !SolverConfig.computePersistedSummaries()) {
+      return;
+    }
+    // seeds and unbalanced returns reach facts in the zero context that do
+    // not stem from the start point
+    std::unordered_set<f_t> Unsummarizable;
+    for (const auto &[StartPoint, SeedFacts] : initialSeeds) {
+      Unsummarizable.insert(ICF->getFunctionOf(StartPoint));
+    }
+    for (n_t RetSite : unbalancedRetSites) {
+      Unsummarizable.insert(ICF->getFunctionOf(RetSite));
+    }
+    size_t NumPersisted = 0;
+    for (const auto &[Fun, Contexts] : PathEdges) {
+      if (Unsummarizable.count(Fun) || !SummaryCache->isCacheable(Fun) ||
+          !isSideEffectFree(Fun)) {
+        continue;
+      }
+      for (const auto &Context : Contexts) {
+        FactID D1 = Context.first;
+        CachedSummaryTy Summary;
+        for (const auto &[EP, ExitFacts] :
+             factsByNode(EndSummaries, Fun, D1)) {
+          for (unsigned D : ExitFacts.set_bits()) {
+            Summary[EP].insert(Facts[D]);
+          }
+        }
+        NumPersisted += SummaryCache->insert(Fun, Facts[D1], Summary);
+      }
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Added " << NumPersisted
+                  << " summaries to the summary cache");
+  }
+
+  /**
+   * Records the path edge (D1, Target, D2) and schedules it for processing
+   * if it is new.
+   */
+  void propagate(FactID D1, n_t Target, FactID D2) {
+    if (!admitPathEdge(D1, Target, D2)) {
+      return;
+    }
+    auto &Reached = PathEdges[ICF->getFunctionOf(Target)][D1][Target];
+    if (!setBit(Reached, D2)) {
+      return;
+    }
+    ++PathEdgeCount;
+    PathEdge<n_t, FactID> Edge(D1, Target, D2);
+    if (PathEdgeWL) {
+      PathEdgeWL->push(std::move(Edge));
+    } else {
+      pathEdgeProcessingTask(Edge);
+    }
+  }
+
+  void pathEdgeProcessingTask(const PathEdge<n_t, FactID> &Edge) {
+    n_t N = Edge.getTarget();
+    if (!ICF->isCallStmt(N)) {
+      if (ICF->isExitStmt(N)) {
+        processExit(Edge);
+      }
+      if (!ICF->getSuccsOf(N).empty()) {
+        processNormalFlow(Edge);
+      }
+    } else {
+      processCall(Edge);
+    }
+  }
+
+  void processNormalFlow(const PathEdge<n_t, FactID> &Edge) {
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    d_t D2 = Facts[Edge.factAtTarget()];
+    for (n_t Succ : ICF->getSuccsOf(N)) {
+      for (d_t D3 : getNormalFlowFunction(N, Succ)->computeTargets(D2)) {
+        FactID D3ID = getFactID(D3);
+        if (SolverConfig.sparsePropagation()) {
+          for (n_t Target : getSparseTargets(Succ, D3ID)) {
+            propagate(D1, Target, D3ID);
+          }
+        } else {
+          propagate(D1, Succ, D3ID);
+        }
+      }
+    }
+  }
+
+  /// Processes the normal flows of the path edges Edges that all target N.
+  /// The facts at N are collected in one bit vector per context D1. Flow
+  /// functions with a gen/kill form are applied to these bit vectors as a
+  /// whole, all others are evaluated once per distinct fact at N.
+  void processNormalFlowBatch(n_t N,
+                              const std::vector<PathEdge<n_t, FactID>> &Edges) {
+    std::map<FactID, llvm::BitVector> Sources;
+    llvm::BitVector AllSources(Facts.size());
+    for (const auto &Edge : Edges) {
+      auto &Bits = Sources[Edge.factAtSource()];
+      Bits.resize(Facts.size());
+      Bits.set(Edge.factAtTarget());
+      AllSources.set(Edge.factAtTarget());
+    }
+    for (n_t Succ : ICF->getSuccsOf(N)) {
+      auto FF = getNormalFlowFunction(N, Succ);
+      std::map<FactID, llvm::BitVector> Targets;
+      if (auto Form = FF->getGenKillForm()) {
+        llvm::BitVector Gen(Facts.size());
+        for (const auto &Fact : Form->Gen) {
+          setBit(Gen, getFactID(Fact));
+        }
+        // facts without an ID cannot be pending and need not be killed
+        llvm::BitVector Kill(Facts.size());
+        for (const auto &Fact : Form->Kill) {
+          auto Search = FactIDs.find(Fact);
+          if (Search != FactIDs.end()) {
+            Kill.set(Search->second);
+          }
+        }
+        std::optional<FactID> GenSource;
+        if (Form->GenSource) {
+          auto Search = FactIDs.find(*Form->GenSource);
+          if (Search != FactIDs.end()) {
+            GenSource = Search->second;
+          }
+        }
+        for (const auto &[D1, Bits] : Sources) {
+          auto &Out = Targets[D1];
+          if (!Form->KillAll) {
+            Out = Bits;
+            Out.reset(Kill);
+          }
+          if (GenSource && *GenSource < Bits.size() && Bits.test(*GenSource)) {
+            Out |= Gen;
+          }
+        }
+      } else {
+        for (unsigned D2 : AllSources.set_bits()) {
+          llvm::BitVector D2Targets;
+          for (d_t D3 : FF->computeTargets(Facts[D2])) {
+            setBit(D2Targets, getFactID(D3));
+          }
+          for (const auto &[D1, Bits] : Sources) {
+            if (Bits.test(D2)) {
+              Targets[D1] |= D2Targets;
+            }
+          }
+        }
+      }
+      for (const auto &[D1, Out] : Targets) {
+        propagateNormalFlow(D1, Succ, Out);
+      }
+    }
+  }
+
+  /// Propagates the facts Out in context D1 to the normal successor Succ.
+  void propagateNormalFlow(FactID D1, n_t Succ, const llvm::BitVector &Out) {
+    if (SolverConfig.sparsePropagation()) {
+      for (unsigned D3 : Out.set_bits()) {
+        for (n_t Target : getSparseTargets(Succ, D3)) {
+          propagate(D1, Target, D3);
+        }
+      }
+      return;
+    }
+    // skip the facts that have reached Succ already
+    llvm::BitVector New = Out;
+    auto FunSearch = PathEdges.find(ICF->getFunctionOf(Succ));
+    if (FunSearch != PathEdges.end()) {
+      auto ContextSearch = FunSearch->second.find(D1);
+      if (ContextSearch != FunSearch->second.end()) {
+        auto NodeSearch = ContextSearch->second.find(Succ);
+        if (NodeSearch != ContextSearch->second.end()) {
+          New.reset(NodeSearch->second);
+        }
+      }
+    }
+    for (unsigned D3 : New.set_bits()) {
+      propagate(D1, Succ, D3);
+    }
+  }
+
+  /// Sparse propagation stops at nodes that are relevant to fact D as well
+  /// as at all nodes that are not handled by processNormalFlow().
+  bool isSparseTarget(n_t N, FactID D) {
+    return ICF->isCallStmt(N) || ICF->isExitStmt(N) || ICF->isStartPoint(N) ||
+           IFDSProblem.isRelevant(N, Facts[D]);
+  }
+
+  /// Returns the nodes that fact D is propagated to when it reaches the normal
+  /// successor N, cf. IDESolver::getSparseTargets().
+  std::vector<n_t> getSparseTargets(n_t N, FactID D) {
+    if (isSparseTarget(N, D)) {
+      return {N};
+    }
+    KeyT<n_t, FactID> Key(N, D);
+    if (auto *Targets = SparseTargetsCache.lookup(Key)) {
+      return *Targets;
+    }
+    std::vector<n_t> Targets;
+    std::unordered_set<n_t> Visited{N};
+    std::vector<n_t> Skipped{N};
+    while (!Skipped.empty()) {
+      n_t Curr = Skipped.back();
+      Skipped.pop_back();
+      for (n_t Succ : ICF->getSuccsOf(Curr)) {
+        if (!Visited.insert(Succ).second) {
+          continue;
+        }
+        if (isSparseTarget(Succ, D)) {
+          Targets.push_back(Succ);
+        } else {
+          Skipped.push_back(Succ);
+        }
+      }
+    }
+    SparseTargetsCache.insert(std::move(Key), Targets);
+    return Targets;
+  }
+
+  void processCall(const PathEdge<n_t, FactID> &Edge) {
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    FactID D2 = Edge.factAtTarget();
+    const d_t D2Fact = Facts[D2];
+    const std::set<n_t> ReturnSites = ICF->getReturnSitesOfCallAt(N);
+    const std::set<f_t> Callees = ICF->getCalleesOfCallAt(N);
+    for (f_t Callee : Callees) {
+      // a special summary replaces the callee
+      if (FlowFunctionPtrType SpecialSum = getSummaryFlowFunction(N, Callee)) {
+        for (n_t RetSite : ReturnSites) {
+          for (d_t D3 : SpecialSum->computeTargets(D2Fact)) {
+            propagate(D1, RetSite, getFactID(D3));
+          }
+        }
+        continue;
+      }
+      if (applyCalleeSummary(D1, N, D2, Callee, ReturnSites)) {
+        continue;
+      }
+      const container_type CalleeFacts =
+          getCallFlowFunction(N, Callee)->computeTargets(D2Fact);
+      for (d_t D3Fact : CalleeFacts) {
+        FactID D3 = getFactID(D3Fact);
+        // a cached summary replaces the callee for this fact
+        if (const auto *Summary = getCachedSummary(Callee, D3)) {
+          for (const auto &[EP, ExitFacts] : *Summary) {
+            for (n_t RetSite : ReturnSites) {
+              auto RetFF = getRetFlowFunction(N, Callee, EP, RetSite);
+              for (d_t D4 : ExitFacts) {
+                for (d_t D5 : RetFF->computeTargets(D4)) {
+                  propagate(D1, RetSite, getFactID(D5));
+                }
+              }
+            }
+          }
+          continue;
+        }
+        for (n_t SP : ICF->getStartPointsOf(Callee)) {
+          propagate(D3, SP, D3);
+          setBit(Incoming[Callee][D3][N], D2);
+          // apply the summaries of the callee's exits that have already
+          // been reached from D3
+          for (const auto &[EP, ExitFacts] :
+               factsByNode(EndSummaries, Callee, D3)) {
+            for (n_t RetSite : ReturnSites) {
+              auto RetFF = getRetFlowFunction(N, Callee, EP, RetSite);
+              for (unsigned D4 : ExitFacts.set_bits()) {
+                for (d_t D5 : RetFF->computeTargets(Facts[D4])) {
+                  propagate(D1, RetSite, getFactID(D5));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    // like in IDESolver, calls without any callee have no call-to-return flow
+    if (Callees.empty()) {
+      return;
+    }
+    for (n_t RetSite : ReturnSites) {
+      auto CallToRetFF = getCallToRetFlowFunction(N, RetSite, Callees);
+      for (d_t D3 : CallToRetFF->computeTargets(D2Fact)) {
+        propagate(D1, RetSite, getFactID(D3));
+      }
+    }
+  }
+
+  void processExit(const PathEdge<n_t, FactID> &Edge) {
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    FactID D2 = Edge.factAtTarget();
+    const d_t D2Fact = Facts[D2];
+    f_t Fun = ICF->getFunctionOf(N);
+    setBit(EndSummaries[Fun][D1][N], D2);
+    // for each call site that has reached D1 at Fun's start point
+    const auto Inc = factsByNode(Incoming, Fun, D1);
+    for (const auto &[CallSite, CallFacts] : Inc) {
+      f_t Caller = ICF->getFunctionOf(CallSite);
+      for (n_t RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+        const container_type Targets =
+            getRetFlowFunction(CallSite, Fun, N, RetSite)
+                ->computeTargets(D2Fact);
+        if (Targets.empty()) {
+          continue;
+        }
+        // for each caller-side context in which a fact D4 at the call site
+        // has been reached
+        for (const auto &[D3, Reached] :
+             factsByContext(PathEdges, Caller, CallSite)) {
+          bool ReachesCall = false;
+          for (unsigned D4 : CallFacts.set_bits()) {
+            if (D4 < Reached.size() && Reached.test(D4)) {
+              ReachesCall = true;
+              break;
+            }
+          }
+          if (!ReachesCall) {
+            continue;
+          }
+          for (d_t D5 : Targets) {
+            propagate(D3, RetSite, getFactID(D5));
+          }
+        }
+      }
+    }
+    // handling for unbalanced problems where we return out of a method with a
+    // fact for which we have no incoming flow; only facts that originate
+    // from zero are propagated this way
+    if (FollowReturnsPastSeeds && Inc.empty() &&
+        IFDSProblem.isZeroValue(Facts[D1])) {
+      const std::set<n_t> Callers = ICF->getCallersOf(Fun);
+      for (n_t CallSite : Callers) {
+        for (n_t RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+          for (d_t D5 : getRetFlowFunction(CallSite, Fun, N, RetSite)
+                            ->computeTargets(D2Fact)) {
+            propagate(ZeroID, RetSite, getFactID(D5));
+            unbalancedRetSites.insert(RetSite);
+          }
+        }
+      }
+      // the return flow function may have side effects even if there are no
+      // callers; call it with a null caller
+      if (Callers.empty()) {
+        getRetFlowFunction(nullptr, Fun, N, nullptr)->computeTargets(D2Fact);
+      }
+    }
+  }
+
+  /// Processes the path edges Edges that all target the node N. Normal flows
+  /// are processed for all edges at once, calls and exits edge by edge.
+  void pathEdgeBatchProcessingTask(
+      n_t N, const std::vector<PathEdge<n_t, FactID>> &Edges) {
+    if (ICF->isCallStmt(N)) {
+      for (const auto &Edge : Edges) {
+        processCall(Edge);
+      }
+      return;
+    }
+    if (ICF->isExitStmt(N)) {
+      for (const auto &Edge : Edges) {
+        processExit(Edge);
+      }
+    }
+    if (!ICF->getSuccsOf(N).empty()) {
+      processNormalFlowBatch(N, Edges);
+    }
+  }
+
+  void processPathEdgeWorklist() {
+    std::vector<PathEdge<n_t, FactID>> Batch;
+    while (!PathEdgeWL->empty()) {
+      Batch.clear();
+      PathEdgeWL->popBatch(Batch);
+      if (Batch.size() == 1) {
+        pathEdgeProcessingTask(Batch.front());
+      } else {
+        pathEdgeBatchProcessingTask(Batch.front().getTarget(), Batch);
+      }
+    }
+  }
+
+  /// Creates the path-edge worklist of the configured kind, which batches the
+  /// path edges by target node if BatchFlowFunctions is set. Returns a
+  /// nullptr if the path edges are processed recursively.
+  std::unique_ptr<PathEdgeWorklist<n_t, FactID>> makeSolverPathEdgeWorklist() {
+    PathEdgeWorklistKind Kind = SolverConfig.pathEdgeWorklistKind();
+    if (!SolverConfig.batchFlowFunctions()) {
+      return makePathEdgeWorklist<n_t, FactID>(Kind, ICF);
+    }
+    // batches can only form in an explicit worklist
+    if (Kind == PathEdgeWorklistKind::Recursive) {
+      Kind = PathEdgeWorklistKind::FIFO;
+    }
+    return std::make_unique<NodeBatchingPathEdgeWorklist<n_t, FactID>>(
+        makePathEdgeWorklist<n_t, FactID>(Kind, ICF));
+  }
+
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    PathEdgeWL = makeSolverPathEdgeWorklist();
+    for (const auto &[StartPoint, SeedFacts] : initialSeeds) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Start point: " << IFDSProblem.NtoString(StartPoint));
+      for (const auto &Fact : SeedFacts) {
+        propagate(ZeroID, StartPoint, getFactID(Fact));
+        if (PathEdgeWL) {
+          processPathEdgeWorklist();
+        }
+      }
+      setBit(PathEdges[ICF->getFunctionOf(StartPoint)][ZeroID][StartPoint],
+             ZeroID);
+    }
+  }
+};
+
+template <typename Problem>
+CompactIFDSSolver(Problem &)
+    -> CompactIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using CompactIFDSSolver_P =
+    CompactIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
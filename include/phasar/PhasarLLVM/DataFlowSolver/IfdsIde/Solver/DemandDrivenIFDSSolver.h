@@ -0,0 +1,225 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_DEMANDDRIVENIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_DEMANDDRIVENIFDSSOLVER_H_
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/BitVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+/**
+ * Answers queries for the data-flow facts that hold at individual statements
+ * of an IFDSTabulationProblem without solving it for the whole program.
+ *
+ * A query for statement n demands all nodes of the interprocedural
+ * control-flow graph from which n can be reached, i.e. its predecessors,
+ * the calls of its function if it is a start point, and the exit points of
+ * the callees of a call if it is the call's return site. Only path edges
+ * into demanded nodes are tabulated; all others are held back and resumed
+ * as soon as a later query demands their target. Since a valid path from a
+ * seed to n only visits demanded nodes, the facts at n are complete once the
+ * query returns. Path edges, end summaries and held-back edges are kept
+ * across queries, such that each query only explores the nodes that no
+ * earlier query has demanded.
+ *
+ * Demanding every node (see solve()) computes the same results as
+ * CompactIFDSSolver.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class DemandDrivenIFDSSolver
+    : public CompactIFDSSolver<AnalysisDomainTy, Container> {
+  using Base = CompactIFDSSolver<AnalysisDomainTy, Container>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::f_t;
+  using typename Base::l_t;
+  using typename Base::n_t;
+
+  DemandDrivenIFDSSolver(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : Base(Problem) {}
+
+  ~DemandDrivenIFDSSolver() override = default;
+
+  /**
+   * @brief Demands every node, i.e. solves the problem for the whole program.
+   */
+  void solve() override {
+    std::vector<n_t> Stmts;
+    for (f_t Fun : this->ICF->getAllFunctions()) {
+      for (n_t Stmt : this->ICF->getAllInstructionsOf(Fun)) {
+        Stmts.push_back(Stmt);
+      }
+    }
+    demand(Stmts);
+    this->persistSummaries();
+  }
+
+  /**
+   * Returns the data-flow facts that hold at the given statement.
+   */
+  std::set<d_t> query(n_t Stmt) {
+    demand({Stmt});
+    return this->ifdsResultsAt(Stmt);
+  }
+
+  /**
+   * Returns whether Fact holds at the given statement.
+   */
+  bool holdsAt(n_t Stmt, d_t Fact) {
+    demand({Stmt});
+    return this->resultAt(Stmt, Fact) == BinaryDomain::BOTTOM;
+  }
+
+  /**
+   * Computes the data-flow facts at the given statements. Afterwards, their
+   * facts can also be retrieved with ifdsResultsAt(), resultAt(), etc.
+   */
+  void demand(const std::vector<n_t> &Stmts) {
+    std::vector<n_t> NewlyDemanded = demandBackwardSlice(Stmts);
+    if (NewlyDemanded.empty()) {
+      return;
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Demanded " << NewlyDemanded.size() << " new nodes");
+    if (!Seeded) {
+      submitSeeds();
+    } else {
+      resumeHeldBackPathEdges(NewlyDemanded);
+    }
+    if (this->PathEdgeWL) {
+      this->processPathEdgeWorklist();
+    }
+    for (const auto &[StartPoint, SeedFacts] : this->initialSeeds) {
+      if (Demanded.count(StartPoint)) {
+        Base::setBit(this->PathEdges[this->ICF->getFunctionOf(StartPoint)]
+                                    [this->ZeroID][StartPoint],
+                     this->ZeroID);
+      }
+    }
+    this->ResultsTabulated = false;
+    this->valtab.clear();
+  }
+
+  /// Returns whether the facts at the given statement have been computed.
+  [[nodiscard]] bool isDemanded(n_t Stmt) const {
+    return Demanded.count(Stmt);
+  }
+
+  /// Returns the number of nodes that have been demanded so far.
+  [[nodiscard]] size_t getNumDemandedNodes() const { return Demanded.size(); }
+
+protected:
+  using typename Base::FactID;
+
+  bool Seeded = false;
+  std::unordered_set<n_t> Demanded;
+  // path edges (d1, n, d2) into nodes n that have not been demanded yet,
+  // grouped by n and d1
+  std::unordered_map<n_t, std::map<FactID, llvm::BitVector>> HeldBack;
+
+  bool admitPathEdge(FactID D1, n_t Target, FactID D2) override {
+    if (Demanded.count(Target)) {
+      return true;
+    }
+    Base::setBit(HeldBack[Target][D1], D2);
+    return false;
+  }
+
+  /// Demands the given statements and all nodes they can be reached from;
+  /// returns the nodes that have not been demanded before. A node that has
+  /// been demanded before is not visited again, as everything it can be
+  /// reached from has been demanded along with it.
+  std::vector<n_t> demandBackwardSlice(const std::vector<n_t> &Stmts) {
+    std::vector<n_t> NewlyDemanded;
+    std::vector<n_t> WorkList(Stmts.begin(), Stmts.end());
+    while (!WorkList.empty()) {
+      n_t Curr = WorkList.back();
+      WorkList.pop_back();
+      if (!Demanded.insert(Curr).second) {
+        continue;
+      }
+      NewlyDemanded.push_back(Curr);
+      for (n_t Pred : this->ICF->getPredsOf(Curr)) {
+        WorkList.push_back(Pred);
+        // Curr is the return site of the call Pred, facts may also reach it
+        // from the exit points of the callees
+        if (this->ICF->isCallStmt(Pred)) {
+          for (f_t Callee : this->ICF->getCalleesOfCallAt(Pred)) {
+            for (n_t ExitPoint : this->ICF->getExitPointsOf(Callee)) {
+              WorkList.push_back(ExitPoint);
+            }
+          }
+        }
+      }
+      if (this->ICF->isStartPoint(Curr)) {
+        for (n_t Caller :
+             this->ICF->getCallersOf(this->ICF->getFunctionOf(Curr))) {
+          WorkList.push_back(Caller);
+        }
+      }
+    }
+    return NewlyDemanded;
+  }
+
+  void resumeHeldBackPathEdges(const std::vector<n_t> &NewlyDemanded) {
+    for (n_t Target : NewlyDemanded) {
+      auto Search = HeldBack.find(Target);
+      if (Search == HeldBack.end()) {
+        continue;
+      }
+      // propagating may hold back further edges and modify HeldBack
+      std::map<FactID, llvm::BitVector> Edges = std::move(Search->second);
+      HeldBack.erase(Search);
+      for (const auto &[D1, D2s] : Edges) {
+        for (unsigned D2 : D2s.set_bits()) {
+          this->propagate(D1, Target, D2);
+        }
+      }
+    }
+  }
+
+  void submitSeeds() {
+    Seeded = true;
+    this->PathEdgeWL = this->makeSolverPathEdgeWorklist();
+    for (const auto &[StartPoint, SeedFacts] : this->initialSeeds) {
+      for (const auto &Fact : SeedFacts) {
+        this->propagate(this->ZeroID, StartPoint, this->getFactID(Fact));
+      }
+    }
+  }
+};
+
+template <typename Problem>
+DemandDrivenIFDSSolver(Problem &)
+    -> DemandDrivenIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using DemandDrivenIFDSSolver_P =
+    DemandDrivenIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
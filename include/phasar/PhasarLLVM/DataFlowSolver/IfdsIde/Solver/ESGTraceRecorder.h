@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGTRACERECORDER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGTRACERECORDER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ESGTrace.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+
+namespace psr {
+
+/**
+ * Records the edges of the exploded super-graph that a solver computes in
+ * an ESG trace. Nodes, facts and functions are interned to dense IDs and
+ * their labels are written once, when they are first encountered.
+ */
+template <typename AnalysisDomainTy, typename Container>
+class ESGTraceRecorder {
+public:
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+
+  ESGTraceRecorder(
+      const std::string &TraceFile,
+      const IDETabulationProblem<AnalysisDomainTy, Container> &Problem,
+      const i_t *ICF)
+      : Writer(TraceFile), Problem(Problem), ICF(ICF) {}
+
+  /// Records the edges from (Src, SrcFact) to (Dst, D) for all D in DstFacts.
+  void recordEdges(n_t Src, n_t Dst, d_t SrcFact, const Container &DstFacts,
+                   bool InterP) {
+    uint32_t SrcNode = getNodeID(Src);
+    uint32_t DstNode = getNodeID(Dst);
+    uint32_t SrcFactID = getFactID(SrcFact);
+    for (const auto &DstFact : DstFacts) {
+      Writer.addEdge(InterP, SrcNode, SrcFactID, DstNode, getFactID(DstFact));
+    }
+  }
+
+  /// Writes all recorded edges to the trace file.
+  void flush() { Writer.flush(); }
+
+  [[nodiscard]] bool good() const { return Writer.good(); }
+
+private:
+  ESGTraceWriter Writer;
+  const IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
+  const i_t *ICF;
+  std::unordered_map<n_t, uint32_t> NodeIDs;
+  std::unordered_map<d_t, uint32_t> FactIDs;
+  std::unordered_map<f_t, uint32_t> FunctionIDs;
+
+  uint32_t getFunctionID(f_t Fun) {
+    auto [It, Inserted] = FunctionIDs.try_emplace(Fun, FunctionIDs.size());
+    if (Inserted) {
+      Writer.addFunction(It->second, ICF->getFunctionName(Fun));
+    }
+    return It->second;
+  }
+
+  uint32_t getNodeID(n_t Node) {
+    auto Search = NodeIDs.find(Node);
+    if (Search != NodeIDs.end()) {
+      return Search->second;
+    }
+    uint32_t Function = getFunctionID(ICF->getFunctionOf(Node));
+    uint32_t ID = NodeIDs.size();
+    NodeIDs.emplace(Node, ID);
+    Writer.addNode(ID, Function, ICF->getStatementId(Node),
+                   Problem.NtoString(Node));
+    return ID;
+  }
+
+  uint32_t getFactID(d_t Fact) {
+    auto [It, Inserted] = FactIDs.try_emplace(Fact, FactIDs.size());
+    if (Inserted) {
+      Writer.addFact(It->second, Problem.isZeroValue(Fact),
+                     Problem.DtoString(Fact));
+    }
+    return It->second;
+  }
+};
+
+} // namespace psr
+
+#endif
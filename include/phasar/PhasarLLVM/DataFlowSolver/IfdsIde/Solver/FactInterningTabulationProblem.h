@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINTERNINGTABULATIONPROBLEM_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINTERNINGTABULATIONPROBLEM_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FactInterner.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+
+namespace psr {
+
+/**
+ * The analysis domain of OriginalAnalysisDomain in which the data-flow facts
+ * are replaced by their FactHandles.
+ */
+template <typename OriginalAnalysisDomain> struct InternedAnalysisDomain {
+  using OriginalDomain = OriginalAnalysisDomain;
+  using d_t = FactHandle;
+  using n_t = typename OriginalAnalysisDomain::n_t;
+  using f_t = typename OriginalAnalysisDomain::f_t;
+  using t_t = typename OriginalAnalysisDomain::t_t;
+  using v_t = typename OriginalAnalysisDomain::v_t;
+  using c_t = typename OriginalAnalysisDomain::c_t;
+  using i_t = typename OriginalAnalysisDomain::i_t;
+  using l_t = typename OriginalAnalysisDomain::l_t;
+};
+
+/**
+ * Applies a flow function of the original problem to the fact that a handle
+ * stands for and interns the resulting facts. Batches of facts and the
+ * gen/kill form are translated as well, so that solvers relying on them see
+ * the original flow function's behavior.
+ */
+template <typename D, typename Container>
+class InternedFlowFunction : public FlowFunction<FactHandle> {
+public:
+  using typename FlowFunction<FactHandle>::container_type;
+  using typename FlowFunction<FactHandle>::EdgeHandlerType;
+
+  InternedFlowFunction(std::shared_ptr<FlowFunction<D, Container>> Original,
+                       FactInterner<D> &Interner)
+      : Original(std::move(Original)), Interner(Interner) {}
+
+  ~InternedFlowFunction() override = default;
+
+  container_type computeTargets(FactHandle Source) override {
+    container_type Targets;
+    for (const auto &Target : Original->computeTargets(Interner.get(Source))) {
+      Targets.insert(Interner.intern(Target));
+    }
+    return Targets;
+  }
+
+  void computeTargetsBatch(const container_type &Sources,
+                           EdgeHandlerType Handler) override {
+    Container Facts;
+    for (FactHandle Source : Sources) {
+      Facts.insert(Interner.get(Source));
+    }
+    Original->computeTargetsBatch(
+        Facts, [this, &Handler](const D &Source, const D &Target) {
+          Handler(Interner.intern(Source), Interner.intern(Target));
+        });
+  }
+
+  std::optional<GenKillForm<FactHandle>> getGenKillForm() const override {
+    auto Form = Original->getGenKillForm();
+    if (!Form) {
+      return std::nullopt;
+    }
+    GenKillForm<FactHandle> Interned;
+    for (const auto &Fact : Form->Gen) {
+      Interned.Gen.insert(Interner.intern(Fact));
+    }
+    if (Form->GenSource) {
+      Interned.GenSource = Interner.intern(*Form->GenSource);
+    }
+    for (const auto &Fact : Form->Kill) {
+      Interned.Kill.insert(Interner.intern(Fact));
+    }
+    Interned.KillAll = Form->KillAll;
+    return Interned;
+  }
+
+private:
+  std::shared_ptr<FlowFunction<D, Container>> Original;
+  FactInterner<D> &Interner;
+};
+
+/**
+ * This class turns a given IDETabulationProblem into an IDETabulationProblem
+ * on FactHandles, such that a solver's tables store 32-bit handles instead
+ * of the possibly heavy data-flow facts of the original problem. The
+ * original problem only sees its own facts: flow functions, edge functions
+ * and printers translate the handles at their boundaries.
+ *
+ * The zero value is identified by its handle, i.e. the original problem
+ * must have a single zero value.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class FactInterningTabulationProblem
+    : public IDETabulationProblem<InternedAnalysisDomain<AnalysisDomainTy>> {
+  using Base = IDETabulationProblem<InternedAnalysisDomain<AnalysisDomainTy>>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::EdgeFunctionPtrType;
+  using typename Base::f_t;
+  using typename Base::FlowFunctionPtrType;
+  using typename Base::l_t;
+  using typename Base::n_t;
+
+  using fact_t = typename AnalysisDomainTy::d_t;
+
+  IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
+
+  FactInterningTabulationProblem(
+      IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : Base(Problem.getProjectIRDB(), Problem.getTypeHierarchy(),
+             Problem.getICFG(), Problem.getPointstoInfo(),
+             Problem.getEntryPoints()),
+        Problem(Problem),
+        Interner(Problem.getNumSolverThreads() > 1) {
+    this->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
+    this->ZeroValue = Interner.intern(Problem.getZeroValue());
+  }
+
+  ~FactInterningTabulationProblem() override = default;
+
+  [[nodiscard]] const FactInterner<fact_t> &getInterner() const {
+    return Interner;
+  }
+
+  /// Returns the fact of the original problem that Handle stands for.
+  [[nodiscard]] const fact_t &getFact(d_t Handle) const {
+    return Interner.get(Handle);
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    return internFlowFunction(Problem.getNormalFlowFunction(Curr, Succ));
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallStmt,
+                                          f_t DestFun) override {
+    return internFlowFunction(Problem.getCallFlowFunction(CallStmt, DestFun));
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitStmt, n_t RetSite) override {
+    return internFlowFunction(
+        Problem.getRetFlowFunction(CallSite, CalleeFun, ExitStmt, RetSite));
+  }
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               std::set<f_t> Callees) override {
+    return internFlowFunction(
+        Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees));
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t CallStmt,
+                                             f_t DestFun) override {
+    return internFlowFunction(
+        Problem.getSummaryFlowFunction(CallStmt, DestFun));
+  }
+
+  bool isRelevant(n_t Inst, d_t Fact) override {
+    return Problem.isRelevant(Inst, getFact(Fact));
+  }
+
+  std::vector<d_t> getFactUniverse() override {
+    std::vector<d_t> Universe;
+    for (const auto &Fact : Problem.getFactUniverse()) {
+      Universe.push_back(Interner.intern(Fact));
+    }
+    return Universe;
+  }
+
+  bool hasSideEffects(f_t Fun) override { return Problem.hasSideEffects(Fun); }
+
+  bool isThreadSafe() const override { return Problem.isThreadSafe(); }
+
+  std::map<n_t, std::set<d_t>> initialSeeds() override {
+    std::map<n_t, std::set<d_t>> Seeds;
+    for (const auto &[Node, Facts] : Problem.initialSeeds()) {
+      auto &Handles = Seeds[Node];
+      for (const auto &Fact : Facts) {
+        Handles.insert(Interner.intern(Fact));
+      }
+    }
+    return Seeds;
+  }
+
+  d_t createZeroValue() const override { return this->ZeroValue; }
+
+  bool isZeroValue(d_t Fact) const override { return Fact == this->ZeroValue; }
+
+  EdgeFunctionPtrType getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                                            d_t SuccNode) override {
+    return Problem.getNormalEdgeFunction(Curr, getFact(CurrNode), Succ,
+                                         getFact(SuccNode));
+  }
+
+  EdgeFunctionPtrType getCallEdgeFunction(n_t CallStmt, d_t SrcNode,
+                                          f_t DestFun, d_t DestNode) override {
+    return Problem.getCallEdgeFunction(CallStmt, getFact(SrcNode), DestFun,
+                                       getFact(DestNode));
+  }
+
+  EdgeFunctionPtrType getReturnEdgeFunction(n_t CallSite, f_t CalleeFun,
+                                            n_t ExitStmt, d_t ExitNode,
+                                            n_t RetSite,
+                                            d_t RetNode) override {
+    return Problem.getReturnEdgeFunction(CallSite, CalleeFun, ExitStmt,
+                                         getFact(ExitNode), RetSite,
+                                         getFact(RetNode));
+  }
+
+  EdgeFunctionPtrType
+  getCallToRetEdgeFunction(n_t CallSite, d_t CallNode, n_t RetSite,
+                           d_t RetSiteNode, std::set<f_t> Callees) override {
+    return Problem.getCallToRetEdgeFunction(CallSite, getFact(CallNode),
+                                            RetSite, getFact(RetSiteNode),
+                                            std::move(Callees));
+  }
+
+  EdgeFunctionPtrType getSummaryEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                                             d_t SuccNode) override {
+    return Problem.getSummaryEdgeFunction(Curr, getFact(CurrNode), Succ,
+                                          getFact(SuccNode));
+  }
+
+  l_t topElement() override { return Problem.topElement(); }
+
+  l_t bottomElement() override { return Problem.bottomElement(); }
+
+  l_t join(l_t Lhs, l_t Rhs) override { return Problem.join(Lhs, Rhs); }
+
+  EdgeFunctionPtrType allTopFunction() override {
+    return Problem.allTopFunction();
+  }
+
+  void printNode(std::ostream &OS, n_t Stmt) const override {
+    Problem.printNode(OS, Stmt);
+  }
+
+  void printDataFlowFact(std::ostream &OS, d_t Fact) const override {
+    Problem.printDataFlowFact(OS, getFact(Fact));
+  }
+
+  void printFunction(std::ostream &OS, f_t Fun) const override {
+    Problem.printFunction(OS, Fun);
+  }
+
+  void printEdgeFact(std::ostream &OS, l_t L) const override {
+    Problem.printEdgeFact(OS, L);
+  }
+
+private:
+  FactInterner<fact_t> Interner;
+
+  FlowFunctionPtrType internFlowFunction(
+      std::shared_ptr<FlowFunction<fact_t, Container>> FlowFunc) {
+    if (!FlowFunc) {
+      return nullptr;
+    }
+    // the most common flow functions do not need to look at the facts
+    if (std::dynamic_pointer_cast<Identity<fact_t, Container>>(FlowFunc)) {
+      return Identity<d_t>::getInstance();
+    }
+    if (std::dynamic_pointer_cast<KillAll<fact_t, Container>>(FlowFunc)) {
+      return KillAll<d_t>::getInstance();
+    }
+    return std::make_shared<InternedFlowFunction<fact_t, Container>>(
+        std::move(FlowFunc), Interner);
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -17,42 +17,57 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionMemoTable.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGTraceRecorder.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/Utils/ClockCache.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/PoolAllocator.h"
 #include "phasar/Utils/Table.h"
+#include "phasar/Utils/Utilities.h"
 
 namespace psr {
 
@@ -104,9 +119,13 @@ public:
   IDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
-        cachedFlowEdgeFunctions(Problem), allTop(Problem.allTopFunction()),
+        NumThreads(Problem.getNumSolverThreads()),
+        cachedFlowEdgeFunctions(Problem),
+        EdgeFunctionMemo(makeEdgeFunctionMemo(SolverConfig)),
+        SparseTargets(SolverConfig.flowEdgeFunctionCacheCapacity()),
+        ESGTrace(makeESGTrace()), allTop(Problem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+            allTop, IDEProblem, SolverConfig.denseJumpFunctions())),
         initialSeeds(Problem.initialSeeds()) {}
 
   IDESolver(const IDESolver &) = delete;
@@ -151,25 +170,7 @@ public:
    */
   virtual void solve() {
     PAMM_GET_INSTANCE;
-    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Propagation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
-
+    registerCounters();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                       << "IDE solver is solving the specified problem";
                   BOOST_LOG_SEV(lg::get(), INFO)
@@ -181,14 +182,43 @@ public:
     STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
     if (SolverConfig.computeValues()) {
       START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
-      // Computing the final values for the edge functions
+      runPhaseII();
+      STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    }
+    finishSolving();
+  }
+
+  /**
+   * Computes the final values according to the edge functions if the solver
+   * config asks for them. Solvers that run Phase I on their own, like
+   * BiDiIDESolver, call it once all path edges have been processed and
+   * completePhaseI() has been called.
+   */
+  void runPhaseII() {
+    if (SolverConfig.computeValues()) {
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Compute the final values according to the edge functions");
       computeValues();
-      STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
     }
+  }
+
+  /**
+   * Completes solving after Phase II: flushes the ESG trace, prints the
+   * statistics and emits the exploded super-graph if requested. Solvers that
+   * run the phases on their own must call it as their last step, like
+   * solve().
+   */
+  void finishSolving() {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Problem solved");
+    if (ESGTrace) {
+      ESGTrace->flush();
+      if (!ESGTrace->good()) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                      << "Cannot write ESG trace "
+                      << SolverConfig.esgTraceFile());
+      }
+    }
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
     }
@@ -197,6 +227,39 @@ public:
     }
   }
 
+  /**
+   * Registers the PAMM counters and histograms the solver reports to. Must be
+   * called exactly once before solving.
+   */
+  static void registerCounters() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Value Propagation", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Max Path-Edge Worklist Size", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Sparse Skips", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Compactions", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Dropped JumpFns", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Chain Cuts", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Path-Edge Worklist Size", PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Path-Edge Batch Size", PAMM_SEVERITY_LEVEL::Full);
+  }
+
   /**
    * Returns the V-type result for the given value at the given statement.
    * TOP values are never returned.
@@ -212,19 +275,37 @@ public:
    */
   [[nodiscard]] virtual std::unordered_map<d_t, l_t>
   resultsAt(n_t stmt, bool stripZero = false) /*TODO const*/ {
-    std::unordered_map<d_t, l_t> result = valtab.row(stmt);
-    if (stripZero) {
-      for (auto it = result.begin(); it != result.end();) {
-        if (IDEProblem.isZeroValue(it->first)) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
-    }
+    std::unordered_map<d_t, l_t> result;
+    foreachResultAt(
+        stmt, [&result](d_t fact, const l_t &value) {
+          result.emplace(fact, value);
+        },
+        stripZero);
     return result;
   }
 
+  /**
+   * Calls F(fact, value) for each result at the given statement without
+   * copying the results. The artificial zero value can be automatically
+   * stripped. TOP values are never visited.
+   */
+  template <typename Fn>
+  void foreachResultAt(n_t stmt, Fn F, bool stripZero = false) const {
+    valtab.foreachInRow(stmt, [&](d_t fact, const l_t &value) {
+      if (!stripZero || !IDEProblem.isZeroValue(fact)) {
+        F(fact, value);
+      }
+    });
+  }
+
+  /**
+   * Calls F(stmt, fact, value) for each result without copying the results.
+   * The statements are visited in no particular order.
+   */
+  template <typename Fn> void foreachResult(Fn F) const {
+    valtab.foreachCell(F);
+  }
+
   virtual void emitTextReport(std::ostream &OS = std::cout) {
     IDEProblem.emitTextReport(getSolverResults(), OS);
   }
@@ -239,41 +320,42 @@ public:
     OS << "\n***************************************************************\n"
        << "*                  Raw IDESolver results                      *\n"
        << "***************************************************************\n";
-    auto cells = this->valtab.cellVec();
-    if (cells.empty()) {
+    // only the rows are sorted, their results are streamed from valtab
+    std::vector<std::pair<n_t, const std::unordered_map<d_t, l_t> *>> rows;
+    this->valtab.foreachRow([&rows](n_t stmt, const auto &row) {
+      if (!row.empty()) {
+        rows.emplace_back(stmt, &row);
+      }
+    });
+    if (rows.empty()) {
       OS << "No results computed!" << std::endl;
     } else {
       llvmValueIDLess llvmIDLess;
       std::sort(
-          cells.begin(), cells.end(),
+          rows.begin(), rows.end(),
           [&llvmIDLess](const auto &a, const auto &b) {
             if constexpr (std::is_same_v<n_t, const llvm::Instruction *>) {
-              return llvmIDLess(a.getRowKey(), b.getRowKey());
+              return llvmIDLess(a.first, b.first);
             } else {
               // If non-LLVM IR is used
-              return a.getRowKey() < b.getRowKey();
+              return a.first < b.first;
             }
           });
-      n_t prev = n_t{};
-      n_t curr = n_t{};
       f_t prevFn = f_t{};
-      f_t currFn = f_t{};
-      for (unsigned i = 0; i < cells.size(); ++i) {
-        curr = cells[i].getRowKey();
-        currFn = ICF->getFunctionOf(curr);
+      for (const auto &[curr, row] : rows) {
+        f_t currFn = ICF->getFunctionOf(curr);
         if (prevFn != currFn) {
           prevFn = currFn;
           OS << "\n\n============ Results for function '" +
                     ICF->getFunctionName(currFn) + "' ============\n";
         }
-        if (prev != curr) {
-          prev = curr;
-          std::string NString = IDEProblem.NtoString(curr);
-          std::string line(NString.size(), '-');
-          OS << "\n\nN: " << NString << "\n---" << line << '\n';
+        std::string NString = IDEProblem.NtoString(curr);
+        std::string line(NString.size(), '-');
+        OS << "\n\nN: " << NString << "\n---" << line << '\n';
+        for (const auto &[fact, value] : *row) {
+          OS << "\tD: " << IDEProblem.DtoString(fact)
+             << " | V: " << IDEProblem.LtoString(value) << '\n';
         }
-        OS << "\tD: " << IDEProblem.DtoString(cells[i].getColumnKey())
-           << " | V: " << IDEProblem.LtoString(cells[i].getValue()) << '\n';
       }
     }
     OS << '\n';
@@ -326,19 +408,58 @@ public:
   }
 
 protected:
+  // returns the pooled memory of the edge and flow functions to the heap once
+  // all other members are destroyed
+  PooledMemoryScope PoolScope;
   // have a shared point to allow for a copy constructor of IDESolver
   IDETabulationProblem<AnalysisDomainTy, Container> &IDEProblem;
   d_t ZeroValue;
   const i_t *ICF;
   IFDSIDESolverConfig &SolverConfig;
-  unsigned PathEdgeCount = 0;
+  // the number of threads of Phase I and Phase II(ii); 1 unless the problem
+  // is thread-safe, see IFDSTabulationProblem::getNumSolverThreads()
+  const unsigned NumThreads;
+  std::atomic<unsigned> PathEdgeCount{0};
+
+  // path edges waiting to be processed; only used if the solver config
+  // requests a PathEdgeWorklistKind other than Recursive
+  std::unique_ptr<PathEdgeWorklist<n_t, d_t>> PathEdgeWL;
+  size_t MaxPathEdgeWLSize = 0;
+  // the path edges popped from PathEdgeWL that are currently processed
+  std::vector<PathEdge<n_t, d_t>> PathEdgeBatch;
+
+  // path edges waiting to be processed by the worker threads; only used if
+  // the solver config requests more than one thread
+  std::unique_ptr<WorkStealingPathEdgeQueue<n_t, d_t>> ParallelPathEdgeWL;
+  // guards endsummarytab, incomingtab and fSummaryReuse in parallel mode
+  std::mutex SummaryMutex;
+  // guards the recorded edges, intermediateEdgeFunctions and
+  // unbalancedRetSites in parallel mode
+  std::mutex EdgeRecordMutex;
 
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> cachedFlowEdgeFunctions;
 
+  // memoizes compositions and joins of edge functions; only used if the
+  // solver config requests it; may be shared with other solvers over the
+  // same value domain
+  std::shared_ptr<EdgeFunctionMemoTable<l_t>> EdgeFunctionMemo;
+
+  using SparseTargetsKey = FlowEdgeFunctionCacheKey<n_t, d_t>;
+  // caches the targets of sparse propagation for the nodes and facts that
+  // are skipped; only used if the solver config requests sparse propagation
+  ClockCache<SparseTargetsKey, std::vector<n_t>,
+             typename SparseTargetsKey::Hasher>
+      SparseTargets;
+  std::mutex SparseTargetsMutex;
+
   Table<n_t, n_t, std::map<d_t, Container>> computedIntraPathEdges;
 
   Table<n_t, n_t, std::map<d_t, Container>> computedInterPathEdges;
 
+  // appends the edges of the exploded super-graph to the solver config's
+  // ESG trace file, if any
+  std::unique_ptr<ESGTraceRecorder<AnalysisDomainTy, Container>> ESGTrace;
+
   EdgeFunctionPtrType allTop;
 
   std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> jumpFn;
@@ -364,6 +485,22 @@ protected:
 
   std::map<std::pair<n_t, d_t>, size_t> fSummaryReuse;
 
+  // the number of path edges processed between two checks of the memory
+  // budget
+  static constexpr size_t MemoryCheckInterval = 4096;
+  // whether Phase I keeps track of the functions' pending path edges to
+  // drop their jump functions if the memory budget is exceeded
+  bool BoundMemory = false;
+  size_t PathEdgesSinceMemoryCheck = 0;
+  // functions that have received jump functions since they have last been
+  // compacted, together with the number of their path edges in PathEdgeWL
+  std::unordered_map<f_t, size_t> PendingPathEdges;
+  // functions whose jump functions have been (partially) dropped and need
+  // to be recomputed in Phase II
+  std::unordered_set<f_t> CompactedFunctions;
+  // nodes of each function whose jump functions may be dropped
+  std::unordered_map<f_t, std::unordered_set<n_t>> DroppableNodes;
+
   // When transforming an IFDSTabulationProblem into an IDETabulationProblem,
   // we need to allocate dynamically, otherwise the objects lifetime runs out
   // - as a modifiable r-value reference created here that should be stored in
@@ -379,12 +516,79 @@ protected:
         IDEProblem(*this->TransformedProblem),
         ZeroValue(IDEProblem.getZeroValue()), ICF(IDEProblem.getICFG()),
         SolverConfig(IDEProblem.getIFDSIDESolverConfig()),
+        NumThreads(IDEProblem.getNumSolverThreads()),
         cachedFlowEdgeFunctions(IDEProblem),
-        allTop(IDEProblem.allTopFunction()),
+        EdgeFunctionMemo(makeEdgeFunctionMemo(SolverConfig)),
+        SparseTargets(SolverConfig.flowEdgeFunctionCacheCapacity()),
+        ESGTrace(makeESGTrace()), allTop(IDEProblem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            allTop, IDEProblem)),
+            allTop, IDEProblem, SolverConfig.denseJumpFunctions())),
         initialSeeds(IDEProblem.initialSeeds()) {}
 
+  static std::unique_ptr<EdgeFunctionMemoTable<l_t>>
+  makeEdgeFunctionMemo(const IFDSIDESolverConfig &Config) {
+    if (!Config.memoizeEdgeFunctions()) {
+      return nullptr;
+    }
+    return std::make_unique<EdgeFunctionMemoTable<l_t>>(
+        Config.flowEdgeFunctionCacheCapacity());
+  }
+
+  std::unique_ptr<ESGTraceRecorder<AnalysisDomainTy, Container>>
+  makeESGTrace() const {
+    if (SolverConfig.esgTraceFile().empty()) {
+      return nullptr;
+    }
+    return std::make_unique<ESGTraceRecorder<AnalysisDomainTy, Container>>(
+        SolverConfig.esgTraceFile(), IDEProblem, ICF);
+  }
+
+  /// Locks M if Phase I is running on multiple threads; returns an unlocked
+  /// lock otherwise.
+  std::unique_lock<std::mutex> lockIfParallel(std::mutex &M) {
+    if (ParallelPathEdgeWL) {
+      return std::unique_lock<std::mutex>(M);
+    }
+    return std::unique_lock<std::mutex>(M, std::defer_lock);
+  }
+
+  /// Locks the jump functions targeting n if Phase I is running on multiple
+  /// threads; returns an empty lock otherwise.
+  std::unique_lock<std::mutex> lockJumpFunctions(n_t n) {
+    if (ParallelPathEdgeWL) {
+      return jumpFn->lockTarget(n);
+    }
+    return std::unique_lock<std::mutex>();
+  }
+
+  /// Returns F->composeWith(G), memoized if the solver config asks for it.
+  /// Compositions longer than the configured maximum chain length are
+  /// replaced by AllBottom.
+  EdgeFunctionPtrType composeEdgeFunctions(const EdgeFunctionPtrType &F,
+                                           const EdgeFunctionPtrType &G) {
+    EdgeFunctionPtrType Result =
+        EdgeFunctionMemo ? EdgeFunctionMemo->compose(F, G) : F->composeWith(G);
+    if (size_t MaxLength = SolverConfig.maxEdgeFunctionChainLength()) {
+      if (auto *EFC =
+              dynamic_cast<EdgeFunctionComposer<l_t> *>(Result.get());
+          EFC && EFC->getChainLength() > MaxLength) {
+        PAMM_GET_INSTANCE;
+        INC_COUNTER("EF Chain Cuts", 1, PAMM_SEVERITY_LEVEL::Full);
+        return std::make_shared<AllBottom<l_t>>(IDEProblem.bottomElement());
+      }
+    }
+    return Result;
+  }
+
+  /// Returns F->joinWith(G), memoized if the solver config asks for it.
+  EdgeFunctionPtrType joinEdgeFunctions(const EdgeFunctionPtrType &F,
+                                        const EdgeFunctionPtrType &G) {
+    if (EdgeFunctionMemo) {
+      return EdgeFunctionMemo->join(F, G);
+    }
+    return F->joinWith(G);
+  }
+
   /**
    * Lines 13-20 of the algorithm; processing a call site in the caller's
    * context.
@@ -440,7 +644,8 @@ protected:
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Found and process special summary");
         for (n_t returnSiteN : returnSiteNs) {
-          container_type res = computeSummaryFlowFunction(specialSum, d1, d2);
+          const container_type res =
+              computeSummaryFlowFunction(specialSum, d1, d2);
           INC_COUNTER("SpecialSummary-FF Application", 1,
                       PAMM_SEVERITY_LEVEL::Full);
           ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
@@ -458,7 +663,8 @@ protected:
                 BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Compose: " << sumEdgFnE->str() << " * " << f->str();
                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
+            propagate(d1, returnSiteN, d3,
+                      composeEdgeFunctions(f, sumEdgFnE), n, false);
           }
         }
       } else {
@@ -466,7 +672,7 @@ protected:
         FlowFunctionPtrType function =
             cachedFlowEdgeFunctions.getCallFlowFunction(n, sCalledProcN);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type res = computeCallFlowFunction(function, d1, d2);
+        const container_type res = computeCallFlowFunction(function, d1, d2);
         ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
         // for each callee's start point(s)
@@ -493,22 +699,26 @@ protected:
                       false); // line 15
             // register the fact that <sp,d3> has an incoming edge from <n,d2>
             // line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(sP, d3, n, d2);
             // line 15.2, copy to avoid concurrent modification exceptions by
-            // other threads
-            // const std::set<TableCell> endSumm(endSummary(sP, d3));
-            // std::cout << "ENDSUMM" << std::endl;
-            // std::cout << "Size: " << endSumm.size() << std::endl;
-            // std::cout << "sP: " << IDEProblem.NtoString(sP)
-            //           << "\nd3: " << IDEProblem.DtoString(d3)
-            //           << std::endl;
-            // printEndSummaryTab();
+            // other threads; registering the incoming edge and reading the
+            // end summaries must appear atomic to processExit()
+            std::set<TableCell> endSumm;
+            {
+              auto Lock = lockIfParallel(SummaryMutex);
+              addIncoming(sP, d3, n, d2);
+              endSumm = endSummary(sP, d3);
+            }
+            if (endSumm.empty()) {
+              continue;
+            }
+            // the caller-side facts are the same for every end summary
+            const container_type callerSideDs{d2};
             // still line 15.2 of Naeem/Lhotak/Rodriguez
             // for each already-queried exit value <eP,d4> reachable from
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (const TableCell entry : endSummary(sP, d3)) {
+            for (const TableCell &entry : endSumm) {
               n_t eP = entry.getRowKey();
               d_t d4 = entry.getColumnKey();
               EdgeFunctionPtrType fCalleeSummary = entry.getValue();
@@ -520,7 +730,7 @@ protected:
                                                                eP, retSiteN);
                 INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
                 const container_type returnedFacts = computeReturnFlowFunction(
-                    retFunction, d3, d4, n, Container{d2});
+                    retFunction, d3, d4, n, callerSideDs);
                 ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
                                  PAMM_SEVERITY_LEVEL::Full);
                 saveEdges(eP, retSiteN, d4, returnedFacts, true);
@@ -541,6 +751,7 @@ protected:
                                 << "Queried Return Edge Function: "
                                 << f5->str());
                   if (SolverConfig.emitESG()) {
+                    auto Lock = lockIfParallel(EdgeRecordMutex);
                     for (auto sP : ICF->getStartPointsOf(sCalledProcN)) {
                       intermediateEdgeFunctions[std::make_tuple(n, d2, sP, d3)]
                           .push_back(f4);
@@ -557,8 +768,8 @@ protected:
                                     << f4->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG)
                                 << "         (return * calleeSummary * call)");
-                  EdgeFunctionPtrType fPrime =
-                      f4->composeWith(fCalleeSummary)->composeWith(f5);
+                  EdgeFunctionPtrType fPrime = composeEdgeFunctions(
+                      composeEdgeFunctions(f4, fCalleeSummary), f5);
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                                     << "       = " << fPrime->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -569,7 +780,7 @@ protected:
                                     << f->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
                   propagate(d1, retSiteN, d5_restoredCtx,
-                            f->composeWith(fPrime), n, false);
+                            composeEdgeFunctions(f, fPrime), n, false);
                 }
               }
             }
@@ -583,7 +794,7 @@ protected:
             cachedFlowEdgeFunctions.getCallToRetFlowFunction(n, returnSiteN,
                                                              callees);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type returnFacts =
+        const container_type returnFacts =
             computeCallToReturnFlowFunction(callToReturnFlowFunction, d1, d2);
         ADD_TO_HISTOGRAM("Data-flow facts", returnFacts.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
@@ -596,11 +807,12 @@ protected:
                         << "Queried Call-to-Return Edge Function: "
                         << edgeFnE->str());
           if (SolverConfig.emitESG()) {
+            auto Lock = lockIfParallel(EdgeRecordMutex);
             intermediateEdgeFunctions[std::make_tuple(n, d2, returnSiteN, d3)]
                 .push_back(edgeFnE);
           }
           INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          auto fPrime = f->composeWith(edgeFnE);
+          auto fPrime = composeEdgeFunctions(f, edgeFnE);
           LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                             << "Compose: " << edgeFnE->str() << " * "
                             << f->str() << " = " << fPrime->str();
@@ -640,8 +852,9 @@ protected:
             cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Queried Normal Edge Function: " << g->str());
-        EdgeFunctionPtrType fprime = f->composeWith(g);
+        EdgeFunctionPtrType fprime = composeEdgeFunctions(f, g);
         if (SolverConfig.emitESG()) {
+          auto Lock = lockIfParallel(EdgeRecordMutex);
           intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)].push_back(
               g);
         }
@@ -650,9 +863,130 @@ protected:
                           << " = " << fprime->str();
                       BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        propagate(d1, fn, d3, fprime, nullptr, false);
+        if (SolverConfig.sparsePropagation()) {
+          for (n_t target : getSparseTargets(fn, d3)) {
+            propagate(d1, target, d3, fprime, nullptr, false);
+          }
+        } else {
+          propagate(d1, fn, d3, fprime, nullptr, false);
+        }
+      }
+    }
+  }
+
+  /**
+   * Lines 33-37 of the algorithm for all path edges Edges that target the
+   * same node n: the facts at n are pushed through each normal flow function
+   * at once (see FlowFunction::computeTargetsBatch()) and the resulting
+   * edges are composed with the jump functions of all edges that carry the
+   * respective fact.
+   */
+  virtual void
+  processNormalFlowBatch(n_t n, const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Normal", Edges.size(), PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process normal at target: " << IDEProblem.NtoString(n)
+                  << " for " << Edges.size() << " path edges");
+    // the facts at n and the facts at the start point and jump functions
+    // of the edges that carry them; an edge may have been pushed more than
+    // once if its jump function has changed in between
+    container_type Sources;
+    std::map<d_t, std::vector<std::pair<d_t, EdgeFunctionPtrType>>> JumpFns;
+    for (const auto &Edge : Edges) {
+      auto &FactJumpFns = JumpFns[Edge.factAtTarget()];
+      if (std::none_of(FactJumpFns.begin(), FactJumpFns.end(),
+                       [&Edge](const auto &Entry) {
+                         return Entry.first == Edge.factAtSource();
+                       })) {
+        FactJumpFns.emplace_back(Edge.factAtSource(), jumpFunction(Edge));
+        Sources.insert(Edge.factAtTarget());
+      }
+    }
+    const bool Record = SolverConfig.recordEdges() || ESGTrace;
+    std::map<d_t, container_type> Targets;
+    for (const auto fn : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType flowFunction =
+          cachedFlowEdgeFunctions.getNormalFlowFunction(n, fn);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      Targets.clear();
+      flowFunction->computeTargetsBatch(Sources, [&](const d_t &d2,
+                                                     const d_t &d3) {
+        if (Record) {
+          Targets[d2].insert(d3);
+        }
+        EdgeFunctionPtrType g =
+            cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "Queried Normal Edge Function: " << g->str());
+        for (const auto &[d1, f] : JumpFns[d2]) {
+          EdgeFunctionPtrType fprime = composeEdgeFunctions(f, g);
+          if (SolverConfig.emitESG()) {
+            intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)]
+                .push_back(g);
+          }
+          INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+          if (SolverConfig.sparsePropagation()) {
+            for (n_t target : getSparseTargets(fn, d3)) {
+              propagate(d1, target, d3, fprime, nullptr, false);
+            }
+          } else {
+            propagate(d1, fn, d3, fprime, nullptr, false);
+          }
+        }
+      });
+      if (Record) {
+        for (const d_t &d2 : Sources) {
+          saveEdges(n, fn, d2, Targets[d2], false);
+        }
+      }
+    }
+  }
+
+  /// Sparse propagation stops at nodes that are relevant to the fact d as
+  /// well as at all nodes that are not handled by processNormalFlow().
+  bool isSparseTarget(n_t n, d_t d) {
+    return ICF->isCallStmt(n) || ICF->isExitStmt(n) || ICF->isStartPoint(n) ||
+           IDEProblem.isRelevant(n, d);
+  }
+
+  /// Returns the nodes that the fact d is propagated to when it reaches the
+  /// normal successor n: n itself if it is a sparse target for d, otherwise
+  /// the closest sparse targets that are reachable from n through nodes that
+  /// are irrelevant to d.
+  std::vector<n_t> getSparseTargets(n_t n, d_t d) {
+    PAMM_GET_INSTANCE;
+    if (isSparseTarget(n, d)) {
+      return {n};
+    }
+    SparseTargetsKey Key(n, d);
+    {
+      auto Lock = lockIfParallel(SparseTargetsMutex);
+      if (auto *Targets = SparseTargets.lookup(Key)) {
+        return *Targets;
+      }
+    }
+    std::vector<n_t> Targets;
+    std::unordered_set<n_t> Visited{n};
+    std::vector<n_t> Skipped{n};
+    while (!Skipped.empty()) {
+      n_t curr = Skipped.back();
+      Skipped.pop_back();
+      INC_COUNTER("Sparse Skips", 1, PAMM_SEVERITY_LEVEL::Full);
+      for (n_t succ : ICF->getSuccsOf(curr)) {
+        if (!Visited.insert(succ).second) {
+          continue;
+        }
+        if (isSparseTarget(succ, d)) {
+          Targets.push_back(succ);
+        } else {
+          Skipped.push_back(succ);
+        }
       }
     }
+    auto Lock = lockIfParallel(SparseTargetsMutex);
+    SparseTargets.insert(std::move(Key), Targets);
+    return Targets;
   }
 
   void propagateValueAtStart(const std::pair<n_t, d_t> nAndD, n_t n) {
@@ -711,6 +1045,15 @@ protected:
     }
   }
 
+  /// Looks up the value of <nHashN,nHashD> in Values without modifying it;
+  /// absent values are implicitly top.
+  l_t valAt(const Table<n_t, d_t, l_t> &Values, n_t nHashN, d_t nHashD) {
+    if (Values.contains(nHashN, nHashD)) {
+      return Values.get(nHashN, nHashD);
+    }
+    return IDEProblem.topElement();
+  }
+
   l_t val(n_t nHashN, d_t nHashD) {
     if (valtab.contains(nHashN, nHashD)) {
       return valtab.get(nHashN, nHashD);
@@ -752,6 +1095,7 @@ protected:
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "   Target D: " << IDEProblem.DtoString(edge.factAtTarget()));
 
+    auto Lock = lockJumpFunctions(edge.getTarget());
     auto fwdLookupRes =
         jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget());
     if (fwdLookupRes) {
@@ -812,6 +1156,33 @@ protected:
     }
   }
 
+  /**
+   * Processes the path edges Edges that all target the node n. Normal flows
+   * are processed for all edges at once, calls and exits edge by edge.
+   */
+  void pathEdgeBatchProcessingTask(
+      n_t n, const std::vector<PathEdge<n_t, d_t>> &Edges) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("JumpFn Construction", Edges.size(),
+                PAMM_SEVERITY_LEVEL::Full);
+    ADD_TO_HISTOGRAM("Path-Edge Batch Size", Edges.size(), 1,
+                     PAMM_SEVERITY_LEVEL::Full);
+    if (ICF->isCallStmt(n)) {
+      for (const auto &Edge : Edges) {
+        processCall(Edge);
+      }
+      return;
+    }
+    if (ICF->isExitStmt(n)) {
+      for (const auto &Edge : Edges) {
+        processExit(Edge);
+      }
+    }
+    if (!ICF->getSuccsOf(n).empty()) {
+      processNormalFlowBatch(n, Edges);
+    }
+  }
+
   // should be made a callable at some point
   void valuePropagationTask(const std::pair<n_t, d_t> nAndD) {
     n_t n = nAndD.first;
@@ -829,29 +1200,97 @@ protected:
 
   // should be made a callable at some point
   void valueComputationTask(const std::vector<n_t> &values) {
+    valueComputationTask(values, valtab);
+  }
+
+  /**
+   * Phase II(ii) for the given nodes. The computed values are stored in
+   * Values, which is either valtab itself or a per-thread shard of it. In the
+   * latter case valtab is only read, such that multiple tasks may run
+   * concurrently on disjoint sets of nodes.
+   */
+  void valueComputationTask(llvm::ArrayRef<n_t> values,
+                            Table<n_t, d_t, l_t> &Values) {
     PAMM_GET_INSTANCE;
+    const bool IsShard = &Values != &valtab;
+    [[maybe_unused]] size_t NumComputations = 0;
     for (n_t n : values) {
       for (n_t sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-        using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
-        Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget;
-        lookupByTarget = jumpFn->lookupByTarget(n);
-        for (const TableCell &sourceValTargetValAndFunction :
-             lookupByTarget.cellSet()) {
-          d_t dPrime = sourceValTargetValAndFunction.getRowKey();
-          d_t d = sourceValTargetValAndFunction.getColumnKey();
-          EdgeFunctionPtrType fPrime = sourceValTargetValAndFunction.getValue();
-          l_t targetVal = val(sP, dPrime);
-          setVal(n, d,
-                 IDEProblem.join(val(n, d),
-                                 fPrime->computeTarget(std::move(targetVal))));
-          INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
+        jumpFn->foreachByTarget(
+            n, [&](d_t dPrime, d_t d, const EdgeFunctionPtrType &fPrime) {
+              l_t targetVal = valAt(valtab, sP, dPrime);
+              l_t Value = IDEProblem.join(
+                  IsShard && Values.contains(n, d) ? Values.get(n, d)
+                                                   : valAt(valtab, n, d),
+                  fPrime->computeTarget(std::move(targetVal)));
+              if (IsShard) {
+                Values.insert(n, d, std::move(Value));
+              } else {
+                setVal(n, d, std::move(Value));
+              }
+              ++NumComputations;
+            });
+      }
+    }
+    INC_COUNTER("Value Computation", NumComputations,
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /**
+   * Phase II(ii) on NumThreads threads. The nodes are handed
+   * out in chunks; each thread collects its values in its own shard of
+   * valtab and the shards are merged once all threads have finished.
+   */
+  void valueComputationTaskInParallel(const std::vector<n_t> &values) {
+    static constexpr size_t ChunkSize = 64;
+    std::vector<Table<n_t, d_t, l_t>> Shards(NumThreads);
+    std::atomic<size_t> NextChunk{0};
+    std::exception_ptr WorkerException;
+    std::mutex WorkerExceptionMutex;
+    auto Work = [&](size_t Worker) {
+      try {
+        for (size_t Begin = NextChunk.fetch_add(ChunkSize);
+             Begin < values.size(); Begin = NextChunk.fetch_add(ChunkSize)) {
+          valueComputationTask(
+              llvm::ArrayRef<n_t>(values).slice(
+                  Begin, std::min(ChunkSize, values.size() - Begin)),
+              Shards[Worker]);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> Lock(WorkerExceptionMutex);
+        if (!WorkerException) {
+          WorkerException = std::current_exception();
         }
       }
+    };
+    std::vector<std::thread> Workers;
+    for (size_t I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back(Work, I);
+    }
+    Work(0);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    if (WorkerException) {
+      std::rethrow_exception(WorkerException);
+    }
+    // every node has been handled by exactly one thread and its values have
+    // already been joined with valtab's previous values
+    for (const auto &Shard : Shards) {
+      Shard.foreachCell(
+          [this](n_t n, d_t d, const l_t &l) { setVal(n, d, l); });
     }
   }
 
   virtual void saveEdges(n_t sourceNode, n_t sinkStmt, d_t sourceVal,
                          const container_type &destVals, bool interP) {
+    if (!SolverConfig.recordEdges() && !ESGTrace) {
+      return;
+    }
+    auto Lock = lockIfParallel(EdgeRecordMutex);
+    if (ESGTrace) {
+      ESGTrace->recordEdges(sourceNode, sinkStmt, sourceVal, destVals, interP);
+    }
     if (!SolverConfig.recordEdges()) {
       return;
     }
@@ -888,33 +1327,347 @@ protected:
     // we create an array of all nodes and then dispatch fractions of this
     // array to multiple threads
     const std::set<n_t> allNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(
-        {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
+    const std::vector<n_t> Nodes(allNonCallStartNodes.begin(),
+                                 allNonCallStartNodes.end());
+    if (!CompactedFunctions.empty()) {
+      valueComputationTaskWithRecomputation(Nodes);
+    } else if (NumThreads > 1) {
+      valueComputationTaskInParallel(Nodes);
+    } else {
+      valueComputationTask(Nodes);
+    }
   }
 
   /**
-   * Schedules the processing of initial seeds, initiating the analysis.
-   * Clients should only call this methods if performing synchronization on
-   * their own. Normally, solve() should be called instead.
+   * Processes path edges from the worklist until it runs empty. Processing an
+   * edge may push new edges onto the worklist (see propagate()).
    */
-  void submitInitialSeeds() {
+  void processPathEdgeWorklist() {
+    while (!PathEdgeWL->empty()) {
+      processNextWorklistPathEdge();
+    }
+  }
+
+  /**
+   * Creates the worklist of the given kind for Phase I, which batches the
+   * path edges by target node if the solver config requests it.
+   */
+  std::unique_ptr<PathEdgeWorklist<n_t, d_t>>
+  makeSolverPathEdgeWorklist(PathEdgeWorklistKind Kind) {
+    auto WL = makePathEdgeWorklist<n_t, d_t>(Kind, ICF);
+    if (WL && SolverConfig.batchFlowFunctions()) {
+      return std::make_unique<NodeBatchingPathEdgeWorklist<n_t, d_t>>(
+          std::move(WL));
+    }
+    return WL;
+  }
+
+  /**
+   * Processes the next path edge from the worklist, or the next batch of
+   * path edges that target the same node. If the memory is bounded, the
+   * jump functions of the functions without pending path edges are dropped
+   * every MemoryCheckInterval edges if the budget is exceeded.
+   */
+  void processNextWorklistPathEdge() {
+    PathEdgeBatch.clear();
+    PathEdgeWL->popBatch(PathEdgeBatch);
+    n_t Target = PathEdgeBatch.front().getTarget();
+    size_t NumEdges = PathEdgeBatch.size();
+    if (NumEdges == 1) {
+      pathEdgeProcessingTask(std::move(PathEdgeBatch.front()));
+    } else {
+      pathEdgeBatchProcessingTask(Target, PathEdgeBatch);
+    }
+    if (!BoundMemory) {
+      return;
+    }
+    PendingPathEdges[ICF->getFunctionOf(Target)] -= NumEdges;
+    PathEdgesSinceMemoryCheck += NumEdges;
+    if (PathEdgesSinceMemoryCheck < MemoryCheckInterval) {
+      return;
+    }
+    PathEdgesSinceMemoryCheck = 0;
+    if (exceedsMemoryBudget()) {
+      compactJumpFunctions();
+    }
+  }
+
+  [[nodiscard]] bool exceedsMemoryBudget() const {
+    return getResidentSetSize() > SolverConfig.memoryBudget();
+  }
+
+  /**
+   * Returns the nodes of Fun whose jump functions may be dropped: all nodes
+   * reachable from its start points except for the start points, call
+   * sites, exits and loop heads. Every cycle in the control flow passes
+   * through a kept node, so that recomputing the dropped jump functions
+   * from the kept ones terminates without iterating loops again.
+   */
+  const std::unordered_set<n_t> &getDroppableNodes(f_t Fun) {
+    auto [It, Inserted] = DroppableNodes.try_emplace(Fun);
+    if (!Inserted) {
+      return It->second;
+    }
+    // iterative DFS from the function's start points; a successor that is
+    // still on the stack is the target of a back edge, i.e. a loop head
+    std::unordered_set<n_t> Visited;
+    std::unordered_set<n_t> OnStack;
+    std::unordered_set<n_t> LoopHeads;
+    std::vector<std::pair<n_t, size_t>> Stack;
+    for (n_t StartPoint : ICF->getStartPointsOf(Fun)) {
+      if (!Visited.insert(StartPoint).second) {
+        continue;
+      }
+      Stack.emplace_back(StartPoint, 0);
+      OnStack.insert(StartPoint);
+      while (!Stack.empty()) {
+        auto &[Node, NextSucc] = Stack.back();
+        auto Succs = ICF->getSuccsOf(Node);
+        if (NextSucc < Succs.size()) {
+          n_t Succ = Succs[NextSucc++];
+          if (Visited.insert(Succ).second) {
+            Stack.emplace_back(Succ, 0);
+            OnStack.insert(Succ);
+          } else if (OnStack.count(Succ)) {
+            LoopHeads.insert(Succ);
+          }
+        } else {
+          OnStack.erase(Node);
+          Stack.pop_back();
+        }
+      }
+    }
+    for (n_t Node : Visited) {
+      if (!ICF->isStartPoint(Node) && !ICF->isCallStmt(Node) &&
+          !ICF->isExitStmt(Node) && !LoopHeads.count(Node)) {
+        It->second.insert(Node);
+      }
+    }
+    return It->second;
+  }
+
+  /// Drops the jump functions and recorded intra-procedural edges of the
+  /// droppable nodes of Fun; returns the number of dropped jump functions.
+  size_t dropJumpFunctions(f_t Fun) {
+    size_t NumDropped = 0;
+    for (n_t Node : getDroppableNodes(Fun)) {
+      // seeds are start points of their own
+      if (initialSeeds.count(Node) || unbalancedRetSites.count(Node)) {
+        continue;
+      }
+      NumDropped += jumpFn->removeFunctionsAt(Node);
+      computedIntraPathEdges.remove(Node);
+    }
+    if (NumDropped) {
+      CompactedFunctions.insert(Fun);
+    }
+    return NumDropped;
+  }
+
+  /**
+   * Drops the jump functions of all functions that have received jump
+   * functions since they have last been compacted, but have no pending path
+   * edges. All information of such a jump function has already been
+   * propagated to the successors of its node. If one of them is propagated
+   * to again, it is recreated from the new edge function only, which
+   * suffices for Phase I as the kept jump functions hold the joins.
+   */
+  void compactJumpFunctions() {
     PAMM_GET_INSTANCE;
+    size_t NumDropped = 0;
+    for (auto It = PendingPathEdges.begin(); It != PendingPathEdges.end();) {
+      if (It->second) {
+        ++It;
+        continue;
+      }
+      NumDropped += dropJumpFunctions(It->first);
+      It = PendingPathEdges.erase(It);
+    }
+    INC_COUNTER("JumpFn Compactions", 1, PAMM_SEVERITY_LEVEL::Full);
+    INC_COUNTER("Dropped JumpFns", NumDropped, PAMM_SEVERITY_LEVEL::Full);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Memory budget exceeded, dropped " << NumDropped
+                  << " jump functions");
+  }
+
+  /**
+   * Recomputes the dropped jump functions of Fun by processing the path
+   * edges of its kept nodes again. Since all other jump functions and
+   * summaries are complete, this only recreates the jump functions of Fun's
+   * droppable nodes.
+   */
+  void recomputeJumpFunctions(f_t Fun) {
+    if (!PathEdgeWL) {
+      PathEdgeWL = makeSolverPathEdgeWorklist(PathEdgeWorklistKind::FIFO);
+    }
+    std::vector<PathEdge<n_t, d_t>> Edges;
+    const auto &Droppable = getDroppableNodes(Fun);
+    for (n_t Node : ICF->getAllInstructionsOf(Fun)) {
+      if (Droppable.count(Node)) {
+        continue;
+      }
+      jumpFn->foreachByTarget(
+          Node, [&](d_t D1, d_t D2, const EdgeFunctionPtrType &) {
+            Edges.emplace_back(D1, Node, D2);
+          });
+    }
+    for (const auto &Edge : Edges) {
+      if (ICF->isCallStmt(Edge.getTarget())) {
+        processCall(Edge);
+      } else if (!ICF->getSuccsOf(Edge.getTarget()).empty()) {
+        processNormalFlow(Edge);
+      }
+    }
+    processPathEdgeWorklist();
+  }
+
+  /**
+   * Phase II(ii) for memory-bounded solving: the nodes are handled function
+   * by function, the dropped jump functions of each function are recomputed
+   * right before its values are computed and dropped again afterwards if
+   * the memory budget is still exceeded.
+   */
+  void valueComputationTaskWithRecomputation(const std::vector<n_t> &values) {
+    std::unordered_map<f_t, std::vector<n_t>> NodesOfFunction;
+    for (n_t n : values) {
+      NodesOfFunction[ICF->getFunctionOf(n)].push_back(n);
+    }
+    for (const auto &[Fun, FunNodes] : NodesOfFunction) {
+      if (!CompactedFunctions.erase(Fun)) {
+        valueComputationTask(FunNodes);
+        continue;
+      }
+      recomputeJumpFunctions(Fun);
+      valueComputationTask(FunNodes);
+      if (exceedsMemoryBudget()) {
+        dropJumpFunctions(Fun);
+      }
+    }
+  }
+
+  /**
+   * Propagates all initial seeds and constructs the exploded super-graph
+   * using NumThreads worker threads that steal path edges
+   * from each other. The calling thread acts as the first worker. If a
+   * worker throws, all workers stop and the exception is rethrown here.
+   */
+  void submitInitialSeedsInParallel() {
+    PAMM_GET_INSTANCE;
+    ParallelPathEdgeWL =
+        std::make_unique<WorkStealingPathEdgeQueue<n_t, d_t>>(NumThreads);
     for (const auto &[StartPoint, Facts] : initialSeeds) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                     << "Start point: " << IDEProblem.NtoString(StartPoint));
       for (const auto &Fact : Facts) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "\tFact: " << IDEProblem.DtoString(Fact);
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
         if (!IDEProblem.isZeroValue(Fact)) {
           INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
         }
         propagate(ZeroValue, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
                   nullptr, false);
       }
+    }
+    std::exception_ptr WorkerException;
+    std::mutex WorkerExceptionMutex;
+    auto Work = [&](size_t Worker) {
+      try {
+        ParallelPathEdgeWL->run(Worker, [this](PathEdge<n_t, d_t> Edge) {
+          pathEdgeProcessingTask(std::move(Edge));
+        });
+      } catch (...) {
+        std::lock_guard<std::mutex> Lock(WorkerExceptionMutex);
+        if (!WorkerException) {
+          WorkerException = std::current_exception();
+        }
+        ParallelPathEdgeWL->abort();
+      }
+    };
+    std::vector<std::thread> Workers;
+    for (size_t I = 1; I < ParallelPathEdgeWL->getNumWorkers(); ++I) {
+      Workers.emplace_back(Work, I);
+    }
+    Work(0);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    ParallelPathEdgeWL.reset();
+    if (WorkerException) {
+      std::rethrow_exception(WorkerException);
+    }
+    for (const auto &Seed : initialSeeds) {
+      jumpFn->addFunction(ZeroValue, Seed.first, ZeroValue,
+                          EdgeIdentity<l_t>::getInstance());
+    }
+  }
+
+  /**
+   * Schedules the processing of initial seeds, initiating the analysis.
+   * Clients should only call this methods if performing synchronization on
+   * their own. Normally, solve() should be called instead.
+   */
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    if (NumThreads > 1) {
+      submitInitialSeedsInParallel();
+      return;
+    }
+    preparePhaseI(false);
+    for (const auto &[StartPoint, Facts] : initialSeeds) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                    << "Start point: " << IDEProblem.NtoString(StartPoint));
+      for (const auto &Fact : Facts) {
+        submitSeed(StartPoint, Fact);
+        if (PathEdgeWL) {
+          processPathEdgeWorklist();
+        }
+      }
       jumpFn->addFunction(ZeroValue, StartPoint, ZeroValue,
                           EdgeIdentity<l_t>::getInstance());
     }
+    completePhaseI();
+  }
+
+  /**
+   * Creates the path-edge worklist of Phase I as configured and enables the
+   * memory budget. The path edges are processed recursively if the config
+   * asks for it, unless NeedsWorklist is set, the memory is bounded or the
+   * flow functions are batched.
+   */
+  void preparePhaseI(bool NeedsWorklist) {
+    PathEdgeWorklistKind Kind = SolverConfig.pathEdgeWorklistKind();
+    BoundMemory = SolverConfig.memoryBudget() > 0;
+    if ((NeedsWorklist || BoundMemory || SolverConfig.batchFlowFunctions()) &&
+        Kind == PathEdgeWorklistKind::Recursive) {
+      // jump functions may only be dropped, and path edges only be batched,
+      // in between path edges
+      Kind = PathEdgeWorklistKind::FIFO;
+    }
+    PathEdgeWL = makeSolverPathEdgeWorklist(Kind);
+  }
+
+  /// Propagates the initial seed Fact at StartPoint.
+  void submitSeed(n_t StartPoint, d_t Fact) {
+    PAMM_GET_INSTANCE;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "\tFact: " << IDEProblem.DtoString(Fact);
+                  BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+    if (!IDEProblem.isZeroValue(Fact)) {
+      INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
+    }
+    propagate(ZeroValue, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
+              nullptr, false);
+  }
+
+  /**
+   * Completes Phase I once all path edges have been processed: all jump
+   * functions except for the kept ones may be dropped before Phase II
+   * recomputes them function by function.
+   */
+  void completePhaseI() {
+    if (BoundMemory && exceedsMemoryBudget()) {
+      compactJumpFunctions();
+    }
+    BoundMemory = false;
+    PendingPathEdges.clear();
   }
 
   /**
@@ -941,19 +1694,24 @@ protected:
     const std::set<n_t> startPointsOf =
         ICF->getStartPointsOf(functionThatNeedsSummary);
     std::map<n_t, container_type> inc;
-    for (n_t sP : startPointsOf) {
-      // line 21.1 of Naeem/Lhotak/Rodriguez
-      // register end-summary
-      addEndSummary(sP, d1, n, d2, f);
-      for (auto entry : incoming(d1, sP)) {
-        inc[entry.first] = Container{entry.second};
+    {
+      // registering the end summary and reading the incoming edges must
+      // appear atomic to processCall()
+      auto Lock = lockIfParallel(SummaryMutex);
+      for (n_t sP : startPointsOf) {
+        // line 21.1 of Naeem/Lhotak/Rodriguez
+        // register end-summary
+        addEndSummary(sP, d1, n, d2, f);
+        for (auto &entry : incoming(d1, sP)) {
+          inc[entry.first] = std::move(entry.second);
+        }
       }
+      printEndSummaryTab();
+      printIncomingTab();
     }
-    printEndSummaryTab();
-    printIncomingTab();
     // for each incoming call edge already processed
     //(see processCall(..))
-    for (auto entry : inc) {
+    for (const auto &entry : inc) {
       // line 22
       n_t c = entry.first;
       // for each return site
@@ -963,13 +1721,15 @@ protected:
             cachedFlowEdgeFunctions.getRetFlowFunction(
                 c, functionThatNeedsSummary, n, retSiteC);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        // the return-flow function only depends on the exit fact d2, so it is
+        // computed once rather than for each incoming-call value
+        const container_type targets =
+            computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
+        ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
+                         PAMM_SEVERITY_LEVEL::Full);
+        saveEdges(n, retSiteC, d2, targets, true);
         // for each incoming-call value
         for (d_t d4 : entry.second) {
-          const container_type targets =
-              computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
-          ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
-                           PAMM_SEVERITY_LEVEL::Full);
-          saveEdges(n, retSiteC, d2, targets, true);
           // for each target value at the return site
           // line 23
           for (d_t d5 : targets) {
@@ -987,6 +1747,7 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
+              auto Lock = lockIfParallel(EdgeRecordMutex);
               for (auto sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
                 intermediateEdgeFunctions[std::make_tuple(c, d4, sP, d1)]
                     .push_back(f4);
@@ -1001,26 +1762,32 @@ protected:
                               << " * " << f4->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "         (return * function * call)");
-            EdgeFunctionPtrType fPrime = f4->composeWith(f)->composeWith(f5);
+            EdgeFunctionPtrType fPrime =
+                composeEdgeFunctions(composeEdgeFunctions(f4, f), f5);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "       = " << fPrime->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
             // for each jump function coming into the call, propagate to
             // return site using the composed function
-            auto revLookupResult = jumpFn->reverseLookup(c, d4);
-            if (revLookupResult) {
-              for (auto valAndFunc : revLookupResult->get()) {
-                EdgeFunctionPtrType f3 = valAndFunc.second;
-                if (!f3->equal_to(allTop)) {
-                  d_t d3 = valAndFunc.first;
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                                    << "Compose: " << fPrime->str() << " * "
-                                    << f3->str();
-                                BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-                  propagate(d3, retSiteC, d5_restoredCtx,
-                            f3->composeWith(fPrime), c, false);
-                }
+            llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>
+                JumpFnsIntoCall;
+            {
+              auto Lock = lockJumpFunctions(c);
+              if (auto revLookupResult = jumpFn->reverseLookup(c, d4)) {
+                JumpFnsIntoCall = revLookupResult->get();
+              }
+            }
+            for (const auto &valAndFunc : JumpFnsIntoCall) {
+              EdgeFunctionPtrType f3 = valAndFunc.second;
+              if (!f3->equal_to(allTop)) {
+                d_t d3 = valAndFunc.first;
+                d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
+                LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                                  << "Compose: " << fPrime->str() << " * "
+                                  << f3->str();
+                              BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+                propagate(d3, retSiteC, d5_restoredCtx,
+                          composeEdgeFunctions(f3, fPrime), c, false);
               }
             }
           }
@@ -1054,6 +1821,7 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
+              auto Lock = lockIfParallel(EdgeRecordMutex);
               intermediateEdgeFunctions[std::make_tuple(n, d2, retSiteC, d5)]
                   .push_back(f5);
             }
@@ -1061,9 +1829,8 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "Compose: " << f5->str() << " * " << f->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-            propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
-            // register for value processing (2nd IDE phase)
-            unbalancedRetSites.insert(retSiteC);
+            propagteUnbalancedReturnFlow(retSiteC, d5,
+                                         composeEdgeFunctions(f, f5), c);
           }
         }
       }
@@ -1081,11 +1848,16 @@ protected:
     }
   }
 
-  void propagteUnbalancedReturnFlow(n_t retSiteC, d_t targetVal,
-                                    EdgeFunctionPtrType edgeFunction,
-                                    n_t relatedCallSite) {
+  /// Propagates targetVal from the zero value into the caller's return site
+  /// retSiteC of an unbalanced return. Subclasses may hold such returns back.
+  virtual void propagteUnbalancedReturnFlow(n_t retSiteC, d_t targetVal,
+                                            EdgeFunctionPtrType edgeFunction,
+                                            n_t relatedCallSite) {
     propagate(ZeroValue, retSiteC, targetVal, std::move(edgeFunction),
               relatedCallSite, true);
+    // register for value processing (2nd IDE phase)
+    auto Lock = lockIfParallel(EdgeRecordMutex);
+    unbalancedRetSites.insert(retSiteC);
   }
 
   /**
@@ -1214,6 +1986,8 @@ protected:
                   << " (result of previous compose)";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
 
+    // looking up, joining and updating the jump function must be atomic
+    auto Lock = lockJumpFunctions(target);
     EdgeFunctionPtrType jumpFnE = [&]() {
       const auto revLookupResult = jumpFn->reverseLookup(target, targetVal);
       if (revLookupResult) {
@@ -1228,8 +2002,8 @@ protected:
       // jump function is initialized to all-top if no entry was found
       return allTop;
     }();
-    EdgeFunctionPtrType fPrime = jumpFnE->joinWith(f);
-    bool newFunction = !(fPrime->equal_to(jumpFnE));
+    EdgeFunctionPtrType fPrime = joinEdgeFunctions(jumpFnE, f);
+    bool newFunction = fPrime != jumpFnE && !(fPrime->equal_to(jumpFnE));
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Join: " << jumpFnE->str() << " & " << f.get()->str()
@@ -1240,9 +2014,32 @@ protected:
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
     if (newFunction) {
       jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
-      const PathEdge<n_t, d_t> edge(sourceVal, target, targetVal);
+      if (Lock.owns_lock()) {
+        Lock.unlock();
+      }
+      PathEdge<n_t, d_t> edge(sourceVal, target, targetVal);
       PathEdgeCount++;
-      pathEdgeProcessingTask(edge);
+      if (ParallelPathEdgeWL) {
+        ParallelPathEdgeWL->push(std::move(edge));
+      } else if (PathEdgeWL) {
+        if (BoundMemory) {
+          ++PendingPathEdges[ICF->getFunctionOf(target)];
+        }
+        PathEdgeWL->push(std::move(edge));
+        if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+          PAMM_GET_INSTANCE;
+          ADD_TO_HISTOGRAM("Path-Edge Worklist Size", PathEdgeWL->size(), 1,
+                           PAMM_SEVERITY_LEVEL::Full);
+          if (PathEdgeWL->size() > MaxPathEdgeWLSize) {
+            INC_COUNTER("Max Path-Edge Worklist Size",
+                        PathEdgeWL->size() - MaxPathEdgeWLSize,
+                        PAMM_SEVERITY_LEVEL::Full);
+            MaxPathEdgeWLSize = PathEdgeWL->size();
+          }
+        }
+      } else {
+        pathEdgeProcessingTask(edge);
+      }
 
       LOG_IF_ENABLE(if (!IDEProblem.isZeroValue(targetVal)) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -1605,6 +2402,9 @@ protected:
           BOOST_LOG_SEV(lg::get(), INFO) << "Jump function construciton count: "
                                          << GET_COUNTER("JumpFn Construction");
           BOOST_LOG_SEV(lg::get(), INFO)
+          << "Max. path-edge worklist size: "
+          << GET_COUNTER("Max Path-Edge Worklist Size");
+          BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase I duration: " << PRINT_TIMER("DFA Phase I");
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase II duration: " << PRINT_TIMER("DFA Phase II");
@@ -14,6 +14,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
@@ -65,13 +66,15 @@ public:
   IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem;
 
   IFDSToIDETabulationProblem(
-      IFDSTabulationProblem<AnalysisDomainTy> &IFDSProblem)
-      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>>(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem)
+      : IDETabulationProblem<AnalysisDomainExtender<AnalysisDomainTy>,
+                             Container>(
             IFDSProblem.getProjectIRDB(), IFDSProblem.getTypeHierarchy(),
             IFDSProblem.getICFG(), IFDSProblem.getPointstoInfo(),
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    this->setIFDSIDESolverConfig(IFDSProblem.getIFDSIDESolverConfig());
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override {
@@ -97,6 +100,18 @@ public:
     return Problem.getSummaryFlowFunction(callStmt, destFun);
   }
 
+  bool isRelevant(n_t Inst, d_t Fact) override {
+    return Problem.isRelevant(Inst, Fact);
+  }
+
+  std::vector<d_t> getFactUniverse() override {
+    return Problem.getFactUniverse();
+  }
+
+  bool hasSideEffects(f_t Fun) override { return Problem.hasSideEffects(Fun); }
+
+  bool isThreadSafe() const override { return Problem.isThreadSafe(); }
+
   std::map<n_t, std::set<d_t>> initialSeeds() override {
     return Problem.initialSeeds();
   }
@@ -0,0 +1,303 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INCREMENTALIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INCREMENTALIFDSSOLVER_H_
+
+#include <optional>
+#include <set>
+#include <unordered_map>
+
+#include "llvm/ADT/BitVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ProgramVersionMapping.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+/**
+ * Solves an IFDSTabulationProblem for a new version of a program and reuses
+ * the results of a solver that solved the same problem for the previous
+ * version.
+ *
+ * A function is reusable if neither it nor any function it (transitively)
+ * calls has changed and all of its call sites still call the same functions.
+ * The results of a reusable function in context d1, i.e. its path edges and
+ * end summaries for fact d1 at its start point, are the same in both
+ * versions. They are restored as soon as the function is entered with d1
+ * instead of being computed again. Only the calls of a restored context are
+ * processed again to restore the contexts of the callees and to reproduce
+ * the side effects of the call, return and call-to-return flow functions;
+ * the normal flow functions of reusable functions are never evaluated.
+ *
+ * Results are reused only if the flow functions of the unchanged functions
+ * do not depend on the changed ones. In particular, the flow functions may
+ * query points-to information, which a change of one function can alter for
+ * others. If the problem provides points-to information, the mapping must
+ * therefore treat functions whose points-to sets changed as changed, cf.
+ * ProgramVersionMapping::comparesPointsToInfo(); otherwise no results are
+ * reused at all. Other whole-program information the flow functions depend
+ * on is not tracked. Unbalanced returns (FollowReturnsPastSeeds) are not
+ * supported and disable reuse.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class IncrementalIFDSSolver
+    : public CompactIFDSSolver<AnalysisDomainTy, Container> {
+  using Base = CompactIFDSSolver<AnalysisDomainTy, Container>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::f_t;
+  using typename Base::i_t;
+  using typename Base::n_t;
+
+  using MappingTy = ProgramVersionMapping<AnalysisDomainTy>;
+
+  /**
+   * Solves the problem for the first version of a program.
+   */
+  IncrementalIFDSSolver(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : Base(Problem) {}
+
+  /**
+   * Solves the problem for the current version of a program and reuses the
+   * results of Previous for its unchanged functions. Previous, its problem
+   * and the previous version of the program must stay alive until solve()
+   * has returned. If Problem provides points-to information, Mapping must
+   * compare the points-to sets of both versions for any results to be
+   * reused.
+   */
+  IncrementalIFDSSolver(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem,
+      const IncrementalIFDSSolver &Previous, const MappingTy &Mapping)
+      : Base(Problem), Previous(&Previous), Mapping(&Mapping) {
+    if (this->SolverConfig.followReturnsPastSeeds()) {
+      return;
+    }
+    if (Problem.getPointstoInfo() && !Mapping.comparesPointsToInfo()) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Results are not reused, the version mapping ignores "
+                       "changes of the points-to information");
+      return;
+    }
+    collectReusableContexts();
+  }
+
+  ~IncrementalIFDSSolver() override = default;
+
+  void solve() override {
+    Base::solve();
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Reused " << NumReusedContexts << " contexts of "
+                  << ReusableFunctions.size() << " unchanged functions");
+    // the previous results are not needed anymore
+    Previous = nullptr;
+    Mapping = nullptr;
+    PreviousContexts.clear();
+    MappedFacts.clear();
+  }
+
+  /// Returns the number of functions whose previous results may be reused.
+  [[nodiscard]] size_t getNumReusableFunctions() const {
+    return ReusableFunctions.size();
+  }
+
+  /// Returns the number of function contexts that have been restored from the
+  /// previous results.
+  [[nodiscard]] size_t getNumReusedContexts() const {
+    return NumReusedContexts;
+  }
+
+protected:
+  using typename Base::ContextFacts;
+  using typename Base::FactID;
+  using typename Base::NodeFacts;
+
+  const IncrementalIFDSSolver *Previous = nullptr;
+  const MappingTy *Mapping = nullptr;
+  // the previous counterpart of every reusable function
+  std::unordered_map<f_t, f_t> ReusableFunctions;
+  // the previous fact d1 for every fact d1 at the start point of a reusable
+  // function in whose context it has not been entered yet
+  std::unordered_map<f_t, std::unordered_map<FactID, FactID>> PreviousContexts;
+  // the current counterparts of previous facts that have been mapped so far
+  std::unordered_map<FactID, std::optional<FactID>> MappedFacts;
+  size_t NumReusedContexts = 0;
+
+  bool admitPathEdge(FactID D1, n_t Target, FactID D2) override {
+    // a function is entered in context D1 with the path edge (D1, sP, D1)
+    if (D1 == D2 && !PreviousContexts.empty() &&
+        this->ICF->isStartPoint(Target)) {
+      restoreContext(this->ICF->getFunctionOf(Target), D1);
+    }
+    return true;
+  }
+
+  std::optional<FactID> mapFactID(FactID PreviousD) {
+    if (PreviousD == Previous->ZeroID) {
+      return this->ZeroID;
+    }
+    auto [It, Inserted] = MappedFacts.try_emplace(PreviousD);
+    if (Inserted) {
+      if (auto D = Mapping->mapFact(Previous->Facts[PreviousD])) {
+        It->second = this->getFactID(*D);
+      }
+    }
+    return It->second;
+  }
+
+  /// Returns whether the counterparts of the call sites of PreviousFun call
+  /// the counterparts of their previous callees, all of them reusable.
+  bool hasReusableCallees(f_t PreviousFun) const {
+    const i_t *PreviousICF = Previous->ICF;
+    for (n_t PreviousCallSite : PreviousICF->getCallsFromWithin(PreviousFun)) {
+      auto CallSite = Mapping->mapStatement(PreviousCallSite);
+      if (!CallSite) {
+        return false;
+      }
+      const std::set<f_t> Callees = this->ICF->getCalleesOfCallAt(*CallSite);
+      const std::set<f_t> PreviousCallees =
+          PreviousICF->getCalleesOfCallAt(PreviousCallSite);
+      if (Callees.size() != PreviousCallees.size()) {
+        return false;
+      }
+      for (f_t PreviousCallee : PreviousCallees) {
+        auto Callee = Mapping->mapFunction(PreviousCallee);
+        if (!Callee || !Callees.count(*Callee) ||
+            !ReusableFunctions.count(*Callee)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void collectReusableContexts() {
+    for (f_t PreviousFun : Previous->ICF->getAllFunctions()) {
+      if (auto Fun = Mapping->mapFunction(PreviousFun)) {
+        ReusableFunctions[*Fun] = PreviousFun;
+      }
+    }
+    // drop functions that (transitively) call changed functions
+    bool Changed = true;
+    while (Changed) {
+      Changed = false;
+      for (auto It = ReusableFunctions.begin();
+           It != ReusableFunctions.end();) {
+        if (hasReusableCallees(It->second)) {
+          ++It;
+        } else {
+          It = ReusableFunctions.erase(It);
+          Changed = true;
+        }
+      }
+    }
+    for (const auto &[Fun, PreviousFun] : ReusableFunctions) {
+      auto Search = Previous->PathEdges.find(PreviousFun);
+      if (Search == Previous->PathEdges.end()) {
+        continue;
+      }
+      for (const auto &[PreviousD1, Nodes] : Search->second) {
+        if (auto D1 = mapFactID(PreviousD1)) {
+          PreviousContexts[Fun][*D1] = PreviousD1;
+        }
+      }
+    }
+  }
+
+  /// Maps the previous facts per node of PreviousFun in context PreviousD1
+  /// in Table to Result; returns false if a node or fact has no counterpart.
+  bool mapNodeFacts(const std::unordered_map<f_t, ContextFacts> &Table,
+                    f_t PreviousFun, FactID PreviousD1, NodeFacts &Result) {
+    auto Search = Table.find(PreviousFun);
+    if (Search == Table.end()) {
+      return true;
+    }
+    auto ContextSearch = Search->second.find(PreviousD1);
+    if (ContextSearch == Search->second.end()) {
+      return true;
+    }
+    for (const auto &[PreviousN, PreviousReached] : ContextSearch->second) {
+      auto N = Mapping->mapStatement(PreviousN);
+      if (!N) {
+        return false;
+      }
+      llvm::BitVector &Reached = Result[*N];
+      for (unsigned PreviousD : PreviousReached.set_bits()) {
+        auto D = mapFactID(PreviousD);
+        if (!D) {
+          return false;
+        }
+        Base::setBit(Reached, *D);
+      }
+    }
+    return true;
+  }
+
+  /// Restores the path edges and end summaries of Fun in context D1 from the
+  /// previous results, if there are any.
+  void restoreContext(f_t Fun, FactID D1) {
+    auto FunSearch = PreviousContexts.find(Fun);
+    if (FunSearch == PreviousContexts.end()) {
+      return;
+    }
+    auto Search = FunSearch->second.find(D1);
+    if (Search == FunSearch->second.end()) {
+      return;
+    }
+    FactID PreviousD1 = Search->second;
+    FunSearch->second.erase(Search);
+    f_t PreviousFun = ReusableFunctions.at(Fun);
+    // a context is either restored completely or computed from scratch
+    NodeFacts Nodes;
+    NodeFacts Exits;
+    if (!mapNodeFacts(Previous->PathEdges, PreviousFun, PreviousD1, Nodes) ||
+        !mapNodeFacts(Previous->EndSummaries, PreviousFun, PreviousD1,
+                      Exits)) {
+      return;
+    }
+    ++NumReusedContexts;
+    NodeFacts &Context = this->PathEdges[Fun][D1];
+    for (const auto &[N, Reached] : Nodes) {
+      llvm::BitVector &Bits = Context[N];
+      size_t Known = Bits.count();
+      Bits |= Reached;
+      this->PathEdgeCount += Bits.count() - Known;
+    }
+    NodeFacts &Summary = this->EndSummaries[Fun][D1];
+    for (const auto &[EP, Reached] : Exits) {
+      Summary[EP] |= Reached;
+    }
+    // the calls restore the contexts of the callees in turn
+    for (const auto &[N, Reached] : Nodes) {
+      if (this->ICF->isCallStmt(N)) {
+        for (unsigned D2 : Reached.set_bits()) {
+          this->processCall(PathEdge<n_t, FactID>(D1, N, D2));
+        }
+      }
+    }
+  }
+};
+
+template <typename Problem>
+IncrementalIFDSSolver(Problem &)
+    -> IncrementalIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using IncrementalIFDSSolver_P =
+    IncrementalIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
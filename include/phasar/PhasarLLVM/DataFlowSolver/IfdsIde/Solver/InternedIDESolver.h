@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INTERNEDIDESOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INTERNEDIDESOLVER_H_
+
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FactInterner.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactInterningTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+template <typename AnalysisDomainTy, typename Container>
+struct FactInterningExtension {
+  FactInterningExtension(
+      IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : InterningProblem(std::make_unique<FactInterningTabulationProblem<
+                             AnalysisDomainTy, Container>>(Problem)) {}
+
+  std::unique_ptr<FactInterningTabulationProblem<AnalysisDomainTy, Container>>
+      InterningProblem;
+};
+
+/**
+ * Solves the given IDETabulationProblem like the IDESolver, but interns
+ * its data-flow facts, see FactInterningTabulationProblem: all of the
+ * solver's tables work on FactHandles, which pays off for problems whose
+ * facts are expensive to copy, compare or hash.
+ *
+ * The results of the inherited interface refer to FactHandles; use
+ * getFact() to obtain the facts they stand for or query the results for
+ * the original facts using factResultAt() and factResultsAt().
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class InternedIDESolver
+    : protected FactInterningExtension<AnalysisDomainTy, Container>,
+      public IDESolver<InternedAnalysisDomain<AnalysisDomainTy>> {
+  using Base = IDESolver<InternedAnalysisDomain<AnalysisDomainTy>>;
+
+public:
+  using ProblemTy = IDETabulationProblem<AnalysisDomainTy, Container>;
+  using typename Base::d_t;
+  using typename Base::l_t;
+  using typename Base::n_t;
+  using fact_t = typename AnalysisDomainTy::d_t;
+
+  InternedIDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : FactInterningExtension<AnalysisDomainTy, Container>(Problem),
+        Base(*this->InterningProblem) {}
+
+  ~InternedIDESolver() override = default;
+
+  /// Returns the fact of the original problem that Handle stands for.
+  [[nodiscard]] const fact_t &getFact(d_t Handle) const {
+    return this->InterningProblem->getFact(Handle);
+  }
+
+  /// Returns the handle of Fact if the solver has come across it.
+  [[nodiscard]] std::optional<d_t> getFactHandle(const fact_t &Fact) const {
+    return this->InterningProblem->getInterner().lookup(Fact);
+  }
+
+  /// Returns the number of distinct facts that the solver has come across.
+  [[nodiscard]] size_t getNumFacts() const {
+    return this->InterningProblem->getInterner().size();
+  }
+
+  /**
+   * Returns the V-type result for the given fact at the given statement.
+   * TOP values are never returned.
+   */
+  [[nodiscard]] l_t factResultAt(n_t Stmt, const fact_t &Fact) {
+    if (auto Handle = getFactHandle(Fact)) {
+      return this->resultAt(Stmt, *Handle);
+    }
+    return l_t{};
+  }
+
+  /**
+   * Returns the resulting environment for the given statement in terms of
+   * the original facts. The artificial zero value can be automatically
+   * stripped.
+   */
+  [[nodiscard]] std::unordered_map<fact_t, l_t>
+  factResultsAt(n_t Stmt, bool StripZero = false) {
+    std::unordered_map<fact_t, l_t> Results;
+    this->foreachResultAt(
+        Stmt,
+        [this, &Results](d_t Handle, const l_t &Value) {
+          Results.emplace(getFact(Handle), Value);
+        },
+        StripZero);
+    return Results;
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) override {
+    auto FactResults = getFactResults();
+    this->InterningProblem->Problem.emitTextReport(
+        SolverResults<n_t, fact_t, l_t>(FactResults, getOriginalZeroValue()),
+        OS);
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) override {
+    auto FactResults = getFactResults();
+    this->InterningProblem->Problem.emitGraphicalReport(
+        SolverResults<n_t, fact_t, l_t>(FactResults, getOriginalZeroValue()),
+        OS);
+  }
+
+private:
+  fact_t getOriginalZeroValue() const {
+    return this->InterningProblem->Problem.getZeroValue();
+  }
+
+  Table<n_t, fact_t, l_t> getFactResults() const {
+    Table<n_t, fact_t, l_t> FactResults;
+    this->valtab.foreachCell([this, &FactResults](n_t Stmt, d_t Handle,
+                                                  const l_t &Value) {
+      FactResults.insert(Stmt, getFact(Handle), Value);
+    });
+    return FactResults;
+  }
+};
+
+template <typename Problem>
+InternedIDESolver(Problem &)
+    -> InternedIDESolver<typename Problem::ProblemAnalysisDomain,
+                         typename Problem::container_type>;
+
+template <typename Problem>
+using InternedIDESolver_P =
+    InternedIDESolver<typename Problem::ProblemAnalysisDomain,
+                      typename Problem::container_type>;
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INTERNEDIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_INTERNEDIFDSSOLVER_H_
+
+#include <set>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/InternedIDESolver.h"
+
+namespace psr {
+
+/**
+ * Solves the given IFDSTabulationProblem like the IFDSSolver, but interns
+ * its data-flow facts, see InternedIDESolver.
+ */
+template <typename AnalysisDomainTy>
+class InternedIFDSSolver
+    : protected IFDSExtension<AnalysisDomainExtender<AnalysisDomainTy>,
+                              std::set<typename AnalysisDomainTy::d_t>>,
+      public InternedIDESolver<AnalysisDomainExtender<AnalysisDomainTy>> {
+  using Base = InternedIDESolver<AnalysisDomainExtender<AnalysisDomainTy>>;
+  using Extension = IFDSExtension<AnalysisDomainExtender<AnalysisDomainTy>,
+                                  std::set<typename AnalysisDomainTy::d_t>>;
+
+public:
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy>;
+  using D = typename AnalysisDomainTy::d_t;
+  using N = typename AnalysisDomainTy::n_t;
+
+  InternedIFDSSolver(IFDSTabulationProblem<AnalysisDomainTy> &IFDSProblem)
+      : Extension(IFDSProblem), Base(*this->TransformedProblem) {}
+
+  ~InternedIFDSSolver() override = default;
+
+  std::set<D> ifdsResultsAt(N Stmt) {
+    std::set<D> KeySet;
+    this->foreachResultAt(Stmt, [this, &KeySet](FactHandle Handle,
+                                                const BinaryDomain &) {
+      KeySet.insert(this->getFact(Handle));
+    });
+    return KeySet;
+  }
+};
+
+template <typename Problem>
+InternedIFDSSolver(Problem &)
+    -> InternedIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using InternedIFDSSolver_P =
+    InternedIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
@@ -17,12 +17,16 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_JUMPFUNCTIONS_H_
 
+#include <array>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "llvm/ADT/SmallVector.h"
 
@@ -47,38 +51,302 @@ public:
   using EdgeFunctionType = EdgeFunction<l_t>;
   using EdgeFunctionPtrType = std::shared_ptr<EdgeFunctionType>;
 
+  // list of facts and their associated functions
+  using JumpFunctionList =
+      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>;
+
+  // number of shards the jump functions are partitioned into
+  static constexpr size_t NumShards = 64;
+
 private:
+  struct Shard {
+    // mapping from target node and value to a list of all source values and
+    // associated functions where the list is implemented as a mapping from
+    // the source value to the function we exclude empty default functions
+    Table<n_t, d_t, JumpFunctionList> nonEmptyReverseLookup;
+    // mapping from source value and target node to a list of all target
+    // values and associated functions where the list is implemented as a
+    // mapping from the source value to the function we exclude empty default
+    // functions
+    Table<d_t, n_t, JumpFunctionList> nonEmptyForwardLookup;
+    // a mapping from target node to a list of triples consisting of source
+    // value, target value and associated function; the triple is implemented
+    // by a table we exclude empty default functions
+    std::unordered_map<n_t, Table<d_t, d_t, EdgeFunctionPtrType>>
+        nonEmptyLookupByTargetNode;
+
+    JumpFunctionList &getReverse(n_t target, d_t targetVal) {
+      return nonEmptyReverseLookup.get(target, targetVal);
+    }
+
+    JumpFunctionList &getForward(d_t sourceVal, n_t target) {
+      return nonEmptyForwardLookup.get(sourceVal, target);
+    }
+
+    JumpFunctionList *findReverse(n_t target, d_t targetVal) {
+      if (!nonEmptyReverseLookup.contains(target, targetVal)) {
+        return nullptr;
+      }
+      return &nonEmptyReverseLookup.get(target, targetVal);
+    }
+
+    JumpFunctionList *findForward(d_t sourceVal, n_t target) {
+      if (!nonEmptyForwardLookup.contains(sourceVal, target)) {
+        return nullptr;
+      }
+      return &nonEmptyForwardLookup.get(sourceVal, target);
+    }
+
+    void addByTarget(d_t sourceVal, n_t target, d_t targetVal,
+                     EdgeFunctionPtrType function) {
+      // V Table::insert(R r, C c, V v) always overrides
+      nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal,
+                                                std::move(function));
+    }
+
+    void removeByTarget(d_t sourceVal, n_t target, d_t targetVal) {
+      if (auto Search = nonEmptyLookupByTargetNode.find(target);
+          Search != nonEmptyLookupByTargetNode.end() &&
+          Search->second.contains(sourceVal, targetVal)) {
+        Search->second.remove(sourceVal, targetVal);
+      }
+    }
+
+    template <typename Fn> void foreachByTarget(n_t target, Fn F) const {
+      if (auto Search = nonEmptyLookupByTargetNode.find(target);
+          Search != nonEmptyLookupByTargetNode.end()) {
+        Search->second.foreachCell(F);
+      }
+    }
+
+    size_t removeTarget(n_t target) {
+      auto Search = nonEmptyLookupByTargetNode.find(target);
+      if (Search == nonEmptyLookupByTargetNode.end()) {
+        return 0;
+      }
+      size_t NumRemoved = 0;
+      Search->second.foreachCell(
+          [&](d_t sourceVal, d_t /*targetVal*/, const auto & /*function*/) {
+            ++NumRemoved;
+            if (nonEmptyForwardLookup.contains(sourceVal, target)) {
+              nonEmptyForwardLookup.remove(sourceVal, target);
+            }
+          });
+      nonEmptyReverseLookup.remove(target);
+      nonEmptyLookupByTargetNode.erase(Search);
+      return NumRemoved;
+    }
+
+    template <typename Fn> void foreachTarget(Fn F) const {
+      for (const auto &Entry : nonEmptyLookupByTargetNode) {
+        F(Entry.first);
+      }
+    }
+
+    template <typename Fn> void foreachReverse(Fn F) const {
+      nonEmptyReverseLookup.foreachCell(F);
+    }
+
+    template <typename Fn> void foreachForward(Fn F) const {
+      nonEmptyForwardLookup.foreachCell(F);
+    }
+
+    void clear() {
+      nonEmptyReverseLookup.clear();
+      nonEmptyForwardLookup.clear();
+      nonEmptyLookupByTargetNode.clear();
+    }
+  };
+
+  // Stores the jump functions of each target node together. The facts that
+  // occur at a target node are numbered by a node-local ID that indexes the
+  // reverse and forward lists, so that a lookup hashes the target node and
+  // the fact only once and no separate by-target index has to be maintained.
+  struct DenseShard {
+    struct FactLists {
+      d_t Fact;
+      // source values and functions of the jump functions to Fact
+      JumpFunctionList Reverse;
+      // target values and functions of the jump functions from Fact
+      JumpFunctionList Forward;
+    };
+
+    struct NodeEntry {
+      std::unordered_map<d_t, uint32_t> LocalIDs;
+      // a deque keeps references to the lists valid while facts are added
+      std::deque<FactLists> Facts;
+
+      FactLists &get(d_t Fact) {
+        auto [It, Inserted] = LocalIDs.try_emplace(Fact, Facts.size());
+        if (Inserted) {
+          Facts.push_back({Fact, {}, {}});
+        }
+        return Facts[It->second];
+      }
+
+      FactLists *find(d_t Fact) {
+        auto Search = LocalIDs.find(Fact);
+        return Search == LocalIDs.end() ? nullptr : &Facts[Search->second];
+      }
+    };
+
+    std::unordered_map<n_t, NodeEntry> Nodes;
+
+    JumpFunctionList &getReverse(n_t target, d_t targetVal) {
+      return Nodes[target].get(targetVal).Reverse;
+    }
+
+    JumpFunctionList &getForward(d_t sourceVal, n_t target) {
+      return Nodes[target].get(sourceVal).Forward;
+    }
+
+    FactLists *findFact(n_t target, d_t Fact) {
+      auto Search = Nodes.find(target);
+      return Search == Nodes.end() ? nullptr : Search->second.find(Fact);
+    }
+
+    JumpFunctionList *findReverse(n_t target, d_t targetVal) {
+      auto *Lists = findFact(target, targetVal);
+      return Lists && !Lists->Reverse.empty() ? &Lists->Reverse : nullptr;
+    }
+
+    JumpFunctionList *findForward(d_t sourceVal, n_t target) {
+      auto *Lists = findFact(target, sourceVal);
+      return Lists && !Lists->Forward.empty() ? &Lists->Forward : nullptr;
+    }
+
+    // the reverse lists already hold all records of a target node
+    void addByTarget(d_t /*sourceVal*/, n_t /*target*/, d_t /*targetVal*/,
+                     const EdgeFunctionPtrType & /*function*/) {}
+
+    void removeByTarget(d_t /*sourceVal*/, n_t /*target*/,
+                        d_t /*targetVal*/) {}
+
+    template <typename Fn> void foreachByTarget(n_t target, Fn F) const {
+      if (auto Search = Nodes.find(target); Search != Nodes.end()) {
+        for (const auto &Lists : Search->second.Facts) {
+          for (const auto &[SourceVal, Function] : Lists.Reverse) {
+            F(SourceVal, Lists.Fact, Function);
+          }
+        }
+      }
+    }
+
+    size_t removeTarget(n_t target) {
+      auto Search = Nodes.find(target);
+      if (Search == Nodes.end()) {
+        return 0;
+      }
+      size_t NumRemoved = 0;
+      for (const auto &Lists : Search->second.Facts) {
+        NumRemoved += Lists.Reverse.size();
+      }
+      Nodes.erase(Search);
+      return NumRemoved;
+    }
+
+    template <typename Fn> void foreachTarget(Fn F) const {
+      for (const auto &Entry : Nodes) {
+        F(Entry.first);
+      }
+    }
+
+    template <typename Fn> void foreachReverse(Fn F) const {
+      for (const auto &[Target, Entry] : Nodes) {
+        for (const auto &Lists : Entry.Facts) {
+          if (!Lists.Reverse.empty()) {
+            F(Target, Lists.Fact, Lists.Reverse);
+          }
+        }
+      }
+    }
+
+    template <typename Fn> void foreachForward(Fn F) const {
+      for (const auto &[Target, Entry] : Nodes) {
+        for (const auto &Lists : Entry.Facts) {
+          if (!Lists.Forward.empty()) {
+            F(Lists.Fact, Target, Lists.Forward);
+          }
+        }
+      }
+    }
+
+    void clear() { Nodes.clear(); }
+  };
+
   EdgeFunctionPtrType allTop;
   const IDETabulationProblem<AnalysisDomainTy, Container> &problem;
 
-protected:
-  // mapping from target node and value to a list of all source values and
-  // associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<n_t, d_t, llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>
-      nonEmptyReverseLookup;
-  // mapping from source value and target node to a list of all target values
-  // and associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<d_t, n_t, llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>
-      nonEmptyForwardLookup;
-  // a mapping from target node to a list of triples consisting of source value,
-  // target value and associated function; the triple is implemented by a table
-  // we exclude empty default functions
-  std::unordered_map<n_t, Table<d_t, d_t, EdgeFunctionPtrType>>
-      nonEmptyLookupByTargetNode;
+  // All jump functions that share the same target node are stored in the same
+  // shard. This allows concurrent solver threads to work on different target
+  // nodes without synchronizing with each other (see lockTarget()).
+  std::array<Shard, NumShards> Shards;
+  std::array<DenseShard, NumShards> DenseShards;
+  bool Dense;
+  std::array<std::mutex, NumShards> Mutexes;
+
+  static size_t getShardIndex(n_t target) {
+    // mix the bits as the hash of a pointer is its (aligned) address
+    size_t H = std::hash<n_t>{}(target) * 0x9E3779B97F4A7C15ULL;
+    return (H >> 32) % NumShards;
+  }
+
+  /// Calls F with the shard that holds the jump functions targeting target.
+  template <typename Fn> decltype(auto) withShard(n_t target, Fn F) {
+    if (Dense) {
+      return F(DenseShards[getShardIndex(target)]);
+    }
+    return F(Shards[getShardIndex(target)]);
+  }
+
+  template <typename Fn> decltype(auto) withShard(n_t target, Fn F) const {
+    if (Dense) {
+      return F(DenseShards[getShardIndex(target)]);
+    }
+    return F(Shards[getShardIndex(target)]);
+  }
+
+  /// Calls F with every shard.
+  template <typename Fn> void withShards(Fn F) {
+    if (Dense) {
+      for (auto &S : DenseShards) {
+        F(S);
+      }
+      return;
+    }
+    for (auto &S : Shards) {
+      F(S);
+    }
+  }
 
 public:
+  /**
+   * If Dense is set, the jump functions of each target node are stored
+   * together and indexed by node-local fact IDs instead of in three tables.
+   * @see IFDSIDESolverConfig::setDenseJumpFunctions()
+   */
   JumpFunctions(EdgeFunctionPtrType allTop,
-                const IDETabulationProblem<AnalysisDomainTy, Container> &p)
-      : allTop(std::move(allTop)), problem(p) {}
+                const IDETabulationProblem<AnalysisDomainTy, Container> &p,
+                bool Dense = false)
+      : allTop(std::move(allTop)), problem(p), Dense(Dense) {}
 
   ~JumpFunctions() = default;
 
-  JumpFunctions(const JumpFunctions &JFs) = default;
-  JumpFunctions &operator=(const JumpFunctions &JFs) = default;
-  JumpFunctions(JumpFunctions &&JFs) noexcept = default;
-  JumpFunctions &operator=(JumpFunctions &&JFs) noexcept = default;
+  JumpFunctions(const JumpFunctions &JFs) = delete;
+  JumpFunctions &operator=(const JumpFunctions &JFs) = delete;
+  JumpFunctions(JumpFunctions &&JFs) = delete;
+  JumpFunctions &operator=(JumpFunctions &&JFs) = delete;
+
+  /**
+   * Locks the shard that holds all jump functions with the given target node.
+   * The member functions of this class do not synchronize themselves;
+   * concurrent users must hold this lock while adding or looking up jump
+   * functions with that target and must not acquire a second shard lock
+   * while doing so.
+   */
+  [[nodiscard]] std::unique_lock<std::mutex> lockTarget(n_t target) {
+    return std::unique_lock<std::mutex>(Mutexes[getShardIndex(target)]);
+  }
 
   /**
    * Records a jump function. The source statement is implicit.
@@ -100,35 +368,37 @@ public:
     if (function->equal_to(allTop)) {
       return;
     }
+    withShard(target, [&](auto &S) {
+      auto &SourceValToFunc = S.getReverse(target, targetVal);
+      if (auto Find = std::find_if(
+              SourceValToFunc.begin(), SourceValToFunc.end(),
+              [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
+                return sourceVal == Entry.first;
+              });
+          Find != SourceValToFunc.end()) {
+        // it is important that existing values in JumpFunctions are
+        // overwritten
+        Find->second = function;
+      } else {
+        SourceValToFunc.emplace_back(sourceVal, function);
+      }
 
-    auto &SourceValToFunc = nonEmptyReverseLookup.get(target, targetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return sourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      // it is important that existing values in JumpFunctions are overwritten
-      Find->second = function;
-    } else {
-      SourceValToFunc.emplace_back(sourceVal, function);
-    }
-
-    auto &TargetValToFunc = nonEmptyForwardLookup.get(sourceVal, target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return targetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
-      // it is important that existing values in JumpFunctions are overwritten
-      Find->second = function;
-    } else {
-      TargetValToFunc.emplace_back(targetVal, function);
-    }
+      auto &TargetValToFunc = S.getForward(sourceVal, target);
+      if (auto Find = std::find_if(
+              TargetValToFunc.begin(), TargetValToFunc.end(),
+              [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
+                return targetVal == Entry.first;
+              });
+          Find != TargetValToFunc.end()) {
+        // it is important that existing values in JumpFunctions are
+        // overwritten
+        Find->second = function;
+      } else {
+        TargetValToFunc.emplace_back(targetVal, function);
+      }
 
-    // V Table::insert(R r, C c, V v) always overrides (see comments above)
-    nonEmptyLookupByTargetNode[target].insert(sourceVal, targetVal, function);
+      S.addByTarget(sourceVal, target, targetVal, function);
+    });
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "End adding new jump function";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -139,14 +409,14 @@ public:
    * source values, and for each the associated edge function.
    * The return value is a mapping from source value to function.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
+  std::optional<std::reference_wrapper<JumpFunctionList>>
   reverseLookup(n_t target, d_t targetVal) {
-    if (!nonEmptyReverseLookup.contains(target, targetVal)) {
+    JumpFunctionList *List = withShard(
+        target, [&](auto &S) { return S.findReverse(target, targetVal); });
+    if (!List) {
       return std::nullopt;
-    } else {
-      return {nonEmptyReverseLookup.get(target, targetVal)};
     }
+    return {*List};
   }
 
   /**
@@ -154,24 +424,23 @@ public:
    * associated target values, and for each the associated edge function.
    * The return value is a mapping from target value to function.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
+  std::optional<std::reference_wrapper<JumpFunctionList>>
   forwardLookup(d_t sourceVal, n_t target) {
-    if (!nonEmptyForwardLookup.contains(sourceVal, target)) {
+    JumpFunctionList *List = withShard(
+        target, [&](auto &S) { return S.findForward(sourceVal, target); });
+    if (!List) {
       return std::nullopt;
-    } else {
-      return {nonEmptyForwardLookup.get(sourceVal, target)};
     }
+    return {*List};
   }
 
   /**
-   * Returns for a given target statement all jump function records with this
-   * target.
-   * The return value is a set of records of the form
-   * (sourceVal,targetVal,edgeFunction).
+   * Calls F(sourceVal, targetVal, edgeFunction) for all jump function records
+   * with the given target statement. Does not modify the jump functions, so
+   * that it may be called from multiple threads once they are complete.
    */
-  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) {
-    return nonEmptyLookupByTargetNode[target];
+  template <typename Fn> void foreachByTarget(n_t target, Fn F) const {
+    withShard(target, [&](const auto &S) { S.foreachByTarget(target, F); });
   }
 
   /**
@@ -181,96 +450,113 @@ public:
    * there anyway.
    */
   bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) {
-    auto &SourceValToFunc = nonEmptyReverseLookup.get(target, targetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return sourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      SourceValToFunc.erase(Find);
-    }
-    auto &TargetValToFunc = nonEmptyForwardLookup.get(sourceVal, target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
-              return targetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
-      TargetValToFunc.erase(Find);
-    }
-    return nonEmptyLookupByTargetNode.erase(target);
+    return withShard(target, [&](auto &S) {
+      bool Removed = false;
+      if (auto *SourceValToFunc = S.findReverse(target, targetVal)) {
+        if (auto Find = std::find_if(
+                SourceValToFunc->begin(), SourceValToFunc->end(),
+                [sourceVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
+                  return sourceVal == Entry.first;
+                });
+            Find != SourceValToFunc->end()) {
+          SourceValToFunc->erase(Find);
+          Removed = true;
+        }
+      }
+      if (auto *TargetValToFunc = S.findForward(sourceVal, target)) {
+        if (auto Find = std::find_if(
+                TargetValToFunc->begin(), TargetValToFunc->end(),
+                [targetVal](const std::pair<d_t, EdgeFunctionPtrType> &Entry) {
+                  return targetVal == Entry.first;
+                });
+            Find != TargetValToFunc->end()) {
+          TargetValToFunc->erase(Find);
+        }
+      }
+      S.removeByTarget(sourceVal, target, targetVal);
+      return Removed;
+    });
+  }
+
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of removed functions.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    return withShard(target, [&](auto &S) { return S.removeTarget(target); });
   }
 
   /**
    * Removes all jump functions
    */
   void clear() {
-    nonEmptyReverseLookup.clear();
-    nonEmptyForwardLookup.clear();
-    nonEmptyLookupByTargetNode.clear();
+    withShards([](auto &S) { S.clear(); });
   }
 
   void printJumpFunctions(std::ostream &os) {
     os << "\n******************************************************";
     os << "\n*              Print all Jump Functions              *";
     os << "\n******************************************************\n";
-    for (auto &entry : nonEmptyLookupByTargetNode) {
-      std::string nLabel = problem.NtoString(entry.first);
-      os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
-         << '\n';
-      for (auto cell : entry.second.cellSet()) {
-        os << "D1: " << problem.DtoString(cell.r) << '\n'
-           << "\tD2: " << problem.DtoString(cell.c) << '\n'
-           << "\tEF: " << cell.v->str() << "\n\n";
-      }
-    }
+    withShards([&](auto &S) {
+      S.foreachTarget([&](n_t N) {
+        std::string nLabel = problem.NtoString(N);
+        os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
+           << '\n';
+        S.foreachByTarget(N, [&](d_t D1, d_t D2, const auto &EF) {
+          os << "D1: " << problem.DtoString(D1) << '\n'
+             << "\tD2: " << problem.DtoString(D2) << '\n'
+             << "\tEF: " << EF->str() << "\n\n";
+        });
+      });
+    });
   }
 
   void printNonEmptyReverseLookup(std::ostream &os) {
     os << "DUMP nonEmptyReverseLookup\nTable<N, D, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
-    auto cellvec = nonEmptyReverseLookup.cellVec();
-    for (auto cell : cellvec) {
-      os << "N : " << problem.NtoString(cell.r)
-         << "\nD1: " << problem.DtoString(cell.c) << '\n';
-      for (auto D2ToEF : cell.v) {
-        os << "D2: " << problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second->str() << '\n';
-      }
-      os << '\n';
-    }
+    withShards([&](auto &S) {
+      S.foreachReverse([&](n_t N, d_t D1, const JumpFunctionList &List) {
+        os << "N : " << problem.NtoString(N)
+           << "\nD1: " << problem.DtoString(D1) << '\n';
+        for (const auto &D2ToEF : List) {
+          os << "D2: " << problem.DtoString(D2ToEF.first)
+             << "\nEF: " << D2ToEF.second->str() << '\n';
+        }
+        os << '\n';
+      });
+    });
   }
 
   void printNonEmptyForwardLookup(std::ostream &os) {
     os << "DUMP nonEmptyForwardLookup\nTable<D, N, std::unordered_map<D, "
           "EdgeFunctionPtrType>>\n";
-    auto cellvec = nonEmptyForwardLookup.cellVec();
-    for (auto cell : cellvec) {
-      os << "D1: " << problem.DtoString(cell.r)
-         << "\nN : " << problem.NtoString(cell.c) << '\n';
-      for (auto D2ToEF : cell.v) {
-        os << "D2: " << problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second->str() << '\n';
-      }
-      os << '\n';
-    }
+    withShards([&](auto &S) {
+      S.foreachForward([&](d_t D1, n_t N, const JumpFunctionList &List) {
+        os << "D1: " << problem.DtoString(D1)
+           << "\nN : " << problem.NtoString(N) << '\n';
+        for (const auto &D2ToEF : List) {
+          os << "D2: " << problem.DtoString(D2ToEF.first)
+             << "\nEF: " << D2ToEF.second->str() << '\n';
+        }
+        os << '\n';
+      });
+    });
   }
 
   void printNonEmptyLookupByTargetNode(std::ostream &os) {
     os << "DUMP nonEmptyLookupByTargetNode\nstd::unordered_map<N, Table<D, D, "
           "EdgeFunctionPtrType>>\n";
-    for (auto node : nonEmptyLookupByTargetNode) {
-      os << "\nN : " << problem.NtoString(node.first) << '\n';
-      auto table = nonEmptyLookupByTargetNode[node.first];
-      auto cellvec = table.cellVec();
-      for (auto cell : cellvec) {
-        os << "D1: " << problem.DtoString(cell.r)
-           << "\nD2: " << problem.DtoString(cell.c) << "\nEF: " << cell.v->str()
-           << '\n';
-      }
-      os << '\n';
-    }
+    withShards([&](auto &S) {
+      S.foreachTarget([&](n_t N) {
+        os << "\nN : " << problem.NtoString(N) << '\n';
+        S.foreachByTarget(N, [&](d_t D1, d_t D2, const auto &EF) {
+          os << "D1: " << problem.DtoString(D1)
+             << "\nD2: " << problem.DtoString(D2) << "\nEF: " << EF->str()
+             << '\n';
+        });
+        os << '\n';
+      });
+    });
   }
 };
 
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_MODULEWISEIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_MODULEWISEIFDSSOLVER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+/**
+ * Solves an IFDSTabulationProblem for a single module of a program whose
+ * modules are analyzed separately, bottom-up along their dependencies.
+ *
+ * The interprocedural control-flow graph of the problem only covers the
+ * functions of the module. Calls of functions that another module exports
+ * are not descended into. Instead, the solver of the defining module is
+ * asked for the summary of the callee, i.e. the facts at its exit points
+ * that are reached from the fact at its start point that the call flow
+ * function produces. That solver computes a summary the first time it is
+ * asked for it and keeps it together with its other results; summaries that
+ * have been imported once are reused for all further calls. The call and
+ * return flow functions are evaluated by this solver's problem with the
+ * callee's definition, so that they map between the caller's and the
+ * callee's facts just like in a whole-program analysis.
+ *
+ * Functions are imported from the solvers in the given export table. A
+ * module's functions should only be exported once its solver has solved its
+ * problem. Calls of functions that are not exported (yet) only have
+ * call-to-return flow.
+ *
+ * Modules that (transitively) depend on each other form a component whose
+ * solvers export their functions to each other before solving. They never
+ * compute summaries for each other on demand, as that could recurse into a
+ * solver that is still propagating. Instead, a solver imports the summaries
+ * that the defining solver has computed so far and remembers the calls that
+ * use them. stabilizeComponent() then repeatedly asks the defining solvers
+ * for the summaries and applies those that have grown to the remembered
+ * calls until no summary changes anymore.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class ModuleWiseIFDSSolver
+    : public CompactIFDSSolver<AnalysisDomainTy, Container> {
+  using Base = CompactIFDSSolver<AnalysisDomainTy, Container>;
+
+public:
+  using typename Base::d_t;
+  using typename Base::f_t;
+  using typename Base::n_t;
+
+  /// The facts per exit point of a function that are reached from one fact
+  /// at its start point.
+  using SummaryTy = std::map<n_t, std::set<d_t>>;
+  /// The solver of the defining module and the definition of every exported
+  /// function, by name.
+  using ExportTableTy =
+      std::unordered_map<std::string, std::pair<ModuleWiseIFDSSolver *, f_t>>;
+  /// The solvers of modules that (transitively) depend on each other.
+  using ComponentTy = std::vector<ModuleWiseIFDSSolver *>;
+
+  /// Component must contain this solver if it is given; it is only required
+  /// if the module depends on a module that depends on it in turn.
+  ModuleWiseIFDSSolver(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem,
+      const ExportTableTy &Exports, const ComponentTy *Component = nullptr)
+      : Base(Problem), Exports(Exports), Component(Component) {}
+
+  ~ModuleWiseIFDSSolver() override = default;
+
+  void solve() override {
+    Base::solve();
+    Solved = true;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Imported " << NumImportedSummaries << " summaries");
+  }
+
+  /**
+   * Returns the summary of the given function of this module for fact D1 at
+   * its start point and computes it first if necessary. Must not be called
+   * before solve().
+   */
+  SummaryTy summarize(f_t Fun, d_t D1) {
+    assert(Solved && "Summaries are only available after solve()!");
+    computeSummary(Fun, D1);
+    if (Component) {
+      stabilizeComponent();
+    }
+    return getSummary(Fun, D1);
+  }
+
+  /**
+   * Iterates the summaries that the solvers of this solver's component
+   * import from each other to a fixpoint. Must not be called before all of
+   * them have been solved.
+   */
+  void stabilizeComponent() {
+    assert(Component && "Solver is not part of a component!");
+    size_t Iterations = 0;
+    bool Changed;
+    do {
+      ++Iterations;
+      Changed = false;
+      for (auto *Solver : *Component) {
+        Changed |= Solver->refreshComponentImports();
+      }
+      // refreshing a solver may import further summaries into the solvers
+      // that have been refreshed before
+      for (auto *Solver : *Component) {
+        Changed |= Solver->HasNewComponentImports;
+      }
+    } while (Changed);
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Component of " << Component->size()
+                  << " modules is stable after " << Iterations
+                  << " iterations");
+  }
+
+  /// Returns the number of summaries that have been imported from the
+  /// solvers of other modules.
+  [[nodiscard]] size_t getNumImportedSummaries() const {
+    return NumImportedSummaries;
+  }
+
+protected:
+  using typename Base::FactID;
+
+  // a call that uses a summary imported from a solver of the component
+  struct ComponentCall {
+    FactID D1;
+    n_t CallSite;
+    std::set<n_t> ReturnSites;
+  };
+  struct ComponentImport {
+    ModuleWiseIFDSSolver *Definer = nullptr;
+    std::vector<ComponentCall> Calls;
+  };
+
+  const ExportTableTy &Exports;
+  const ComponentTy *Component;
+  bool Solved = false;
+  // the summaries imported so far, per callee definition and fact at its
+  // start point
+  std::unordered_map<f_t, std::unordered_map<d_t, SummaryTy>> Imported;
+  size_t NumImportedSummaries = 0;
+  // the summaries imported from solvers of the component, which may still
+  // grow, and the calls that use them
+  std::map<std::pair<f_t, d_t>, ComponentImport> ComponentImports;
+  bool HasNewComponentImports = false;
+
+  [[nodiscard]] bool isInComponent(const ModuleWiseIFDSSolver &Solver) const {
+    return Component && std::find(Component->begin(), Component->end(),
+                                  &Solver) != Component->end();
+  }
+
+  /// Propagates fact D1 from the start points of Fun.
+  void computeSummary(f_t Fun, d_t D1) {
+    FactID D1ID = this->getFactID(D1);
+    size_t KnownPathEdges = this->PathEdgeCount;
+    for (n_t SP : this->ICF->getStartPointsOf(Fun)) {
+      this->propagate(D1ID, SP, D1ID);
+    }
+    processPending(KnownPathEdges);
+  }
+
+  /// Returns the summary of Fun for fact D1 computed so far.
+  [[nodiscard]] SummaryTy getSummary(f_t Fun, d_t D1) const {
+    SummaryTy Summary;
+    auto Search = this->FactIDs.find(D1);
+    if (Search == this->FactIDs.end()) {
+      return Summary;
+    }
+    for (const auto &[EP, ExitFacts] :
+         Base::factsByNode(this->EndSummaries, Fun, Search->second)) {
+      for (unsigned D : ExitFacts.set_bits()) {
+        Summary[EP].insert(this->Facts[D]);
+      }
+    }
+    return Summary;
+  }
+
+  void processPending(size_t KnownPathEdges) {
+    if (this->PathEdgeWL) {
+      this->processPathEdgeWorklist();
+    }
+    if (this->PathEdgeCount != KnownPathEdges) {
+      // the new path edges invalidate the tabulated results
+      this->ResultsTabulated = false;
+      this->valtab.clear();
+    }
+  }
+
+  const SummaryTy &getImportedSummary(ModuleWiseIFDSSolver &Definer,
+                                      f_t Definition, d_t D3) {
+    auto [It, Inserted] = Imported[Definition].try_emplace(D3);
+    if (Inserted) {
+      if (isInComponent(Definer)) {
+        // the definer may still be propagating; the summary is completed by
+        // stabilizeComponent()
+        It->second = Definer.getSummary(Definition, D3);
+        ComponentImports[{Definition, D3}].Definer = &Definer;
+        HasNewComponentImports = true;
+      } else {
+        It->second = Definer.summarize(Definition, D3);
+      }
+      ++NumImportedSummaries;
+    }
+    return It->second;
+  }
+
+  void applySummary(FactID D1, n_t N, f_t Definition, const SummaryTy &Summary,
+                    const std::set<n_t> &ReturnSites) {
+    for (const auto &[EP, ExitFacts] : Summary) {
+      for (n_t RetSite : ReturnSites) {
+        auto RetFF = this->getRetFlowFunction(N, Definition, EP, RetSite);
+        for (d_t D4 : ExitFacts) {
+          for (d_t D5 : RetFF->computeTargets(D4)) {
+            this->propagate(D1, RetSite, this->getFactID(D5));
+          }
+        }
+      }
+    }
+  }
+
+  /// Asks the solvers of the component for the summaries imported from them
+  /// again and applies those that have grown. Returns true if any summary
+  /// has grown or has been imported since the last refresh.
+  bool refreshComponentImports() {
+    bool Changed = std::exchange(HasNewComponentImports, false);
+    size_t KnownPathEdges = this->PathEdgeCount;
+    // applying a summary may import further ones
+    std::vector<std::pair<f_t, d_t>> Keys;
+    Keys.reserve(ComponentImports.size());
+    for (const auto &Entry : ComponentImports) {
+      Keys.push_back(Entry.first);
+    }
+    for (const auto &Key : Keys) {
+      const auto &[Definition, D3] = Key;
+      ModuleWiseIFDSSolver *Definer = ComponentImports[Key].Definer;
+      Definer->computeSummary(Definition, D3);
+      SummaryTy Summary = Definer->getSummary(Definition, D3);
+      SummaryTy &Known = Imported[Definition][D3];
+      if (Summary == Known) {
+        continue;
+      }
+      Known = Summary;
+      Changed = true;
+      std::vector<ComponentCall> Calls = ComponentImports[Key].Calls;
+      for (const auto &Call : Calls) {
+        applySummary(Call.D1, Call.CallSite, Definition, Summary,
+                     Call.ReturnSites);
+      }
+    }
+    processPending(KnownPathEdges);
+    return Changed;
+  }
+
+  bool applyCalleeSummary(FactID D1, n_t N, FactID D2, f_t Callee,
+                          const std::set<n_t> &ReturnSites) override {
+    // callees of this module are analyzed as usual
+    if (!this->ICF->getStartPointsOf(Callee).empty()) {
+      return false;
+    }
+    auto Search = Exports.find(this->ICF->getFunctionName(Callee));
+    if (Search == Exports.end() || Search->second.first == this) {
+      return false;
+    }
+    auto [Definer, Definition] = Search->second;
+    for (d_t D3 : this->getCallFlowFunction(N, Definition)
+                      ->computeTargets(this->Facts[D2])) {
+      // copied, as applying it may import further summaries
+      SummaryTy Summary = getImportedSummary(*Definer, Definition, D3);
+      if (isInComponent(*Definer)) {
+        ComponentImports[{Definition, D3}].Calls.push_back(
+            {D1, N, ReturnSites});
+      }
+      applySummary(D1, N, Definition, Summary, ReturnSites);
+    }
+    return true;
+  }
+};
+
+template <typename Problem, typename ExportTable>
+ModuleWiseIFDSSolver(Problem &, const ExportTable &)
+    -> ModuleWiseIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+template <typename Problem>
+using ModuleWiseIFDSSolver_P =
+    ModuleWiseIFDSSolver<typename Problem::ProblemAnalysisDomain>;
+
+} // namespace psr
+
+#endif
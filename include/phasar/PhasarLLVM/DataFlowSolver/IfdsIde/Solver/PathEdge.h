@@ -23,9 +23,9 @@ namespace psr {
 
 template <typename N, typename D> class PathEdge {
 private:
-  const N target;
-  const D dSource;
-  const D dTarget;
+  N target;
+  D dSource;
+  D dTarget;
 
 public:
   PathEdge(D dSource, N target, D dTarget)
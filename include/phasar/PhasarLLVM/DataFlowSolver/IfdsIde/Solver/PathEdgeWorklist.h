@@ -0,0 +1,385 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/**
+ * Holds the path edges that still have to be processed by the IDESolver's
+ * Phase I. Using an explicit worklist rather than the recursive
+ * propagate()/pathEdgeProcessingTask() scheme keeps the stack depth constant,
+ * independent of the size of the exploded super-graph.
+ */
+template <typename N, typename D> class PathEdgeWorklist {
+public:
+  virtual ~PathEdgeWorklist() = default;
+
+  virtual void push(PathEdge<N, D> Edge) = 0;
+
+  virtual PathEdge<N, D> pop() = 0;
+
+  /// Pops the next path edge and appends it to Edges. Worklists that group
+  /// their edges by target node append all pending edges of the next node
+  /// instead.
+  virtual void popBatch(std::vector<PathEdge<N, D>> &Edges) {
+    Edges.push_back(pop());
+  }
+
+  [[nodiscard]] virtual bool empty() const = 0;
+
+  [[nodiscard]] virtual size_t size() const = 0;
+};
+
+/// Processes path edges in the order in which they have been discovered,
+/// i.e. the exploded super-graph is explored breadth-first.
+template <typename N, typename D>
+class FIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::deque<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = std::move(Edges.front());
+    Edges.pop_front();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/// Processes the most recently discovered path edge first, i.e. the exploded
+/// super-graph is explored depth-first, which most closely resembles the
+/// order of the recursive solver.
+template <typename N, typename D>
+class LIFOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  std::vector<PathEdge<N, D>> Edges;
+
+public:
+  void push(PathEdge<N, D> Edge) override { Edges.push_back(std::move(Edge)); }
+
+  PathEdge<N, D> pop() override {
+    PathEdge<N, D> Edge = std::move(Edges.back());
+    Edges.pop_back();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/// Processes path edges ordered by the reverse post-order (RPO) of their
+/// target nodes within the ICFG. All facts flowing into a node are thus
+/// likely to be present before the node is processed, which reduces the
+/// number of re-visits at control-flow merge points. The RPO numbering is
+/// computed lazily for each function when the first edge targeting one of its
+/// nodes is pushed. Functions discovered later receive higher numbers. Edges
+/// with equal priority are processed in FIFO order.
+template <typename N, typename D, typename ICFGTy>
+class RPOPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  using F = decltype(std::declval<const ICFGTy *>()->getFunctionOf(
+      std::declval<N>()));
+
+  struct Entry {
+    uint64_t Priority;
+    uint64_t Sequence;
+    PathEdge<N, D> Edge;
+  };
+
+  struct EntryGreater {
+    bool operator()(const Entry &LHS, const Entry &RHS) const {
+      return std::tie(LHS.Priority, LHS.Sequence) >
+             std::tie(RHS.Priority, RHS.Sequence);
+    }
+  };
+
+  const ICFGTy *ICF;
+  // a binary heap ordered by EntryGreater rather than a std::priority_queue,
+  // whose top() is const and would force pop() to copy the edge
+  std::vector<Entry> Edges;
+  std::unordered_map<N, uint64_t> RPONumbers;
+  std::unordered_set<F> NumberedFunctions;
+  uint64_t NextNumber = 0;
+  uint64_t Sequence = 0;
+
+  void numberFunction(F Fun) {
+    // iterative DFS from the function's start points; the post-order is
+    // reversed afterwards to obtain the RPO
+    std::vector<N> PostOrder;
+    std::unordered_set<N> Visited;
+    std::vector<std::pair<N, size_t>> Stack;
+    for (N StartPoint : ICF->getStartPointsOf(Fun)) {
+      if (!Visited.insert(StartPoint).second) {
+        continue;
+      }
+      Stack.emplace_back(StartPoint, 0);
+      while (!Stack.empty()) {
+        auto &[Node, NextSucc] = Stack.back();
+        auto Succs = ICF->getSuccsOf(Node);
+        if (NextSucc < Succs.size()) {
+          N Succ = Succs[NextSucc++];
+          if (Visited.insert(Succ).second) {
+            Stack.emplace_back(Succ, 0);
+          }
+        } else {
+          PostOrder.push_back(Node);
+          Stack.pop_back();
+        }
+      }
+    }
+    for (auto It = PostOrder.rbegin(); It != PostOrder.rend(); ++It) {
+      RPONumbers[*It] = NextNumber++;
+    }
+  }
+
+  uint64_t getPriority(N Node) {
+    if (auto Search = RPONumbers.find(Node); Search != RPONumbers.end()) {
+      return Search->second;
+    }
+    F Fun = ICF->getFunctionOf(Node);
+    if (NumberedFunctions.insert(Fun).second) {
+      numberFunction(Fun);
+      if (auto Search = RPONumbers.find(Node); Search != RPONumbers.end()) {
+        return Search->second;
+      }
+    }
+    // node is not reachable from its function's start points
+    return RPONumbers[Node] = NextNumber++;
+  }
+
+public:
+  RPOPathEdgeWorklist(const ICFGTy *ICF) : ICF(ICF) {}
+
+  void push(PathEdge<N, D> Edge) override {
+    uint64_t Priority = getPriority(Edge.getTarget());
+    Edges.push_back(Entry{Priority, Sequence++, std::move(Edge)});
+    std::push_heap(Edges.begin(), Edges.end(), EntryGreater{});
+  }
+
+  PathEdge<N, D> pop() override {
+    std::pop_heap(Edges.begin(), Edges.end(), EntryGreater{});
+    PathEdge<N, D> Edge = std::move(Edges.back().Edge);
+    Edges.pop_back();
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const override { return Edges.empty(); }
+
+  [[nodiscard]] size_t size() const override { return Edges.size(); }
+};
+
+/// Groups path edges by their target node. The nodes are scheduled by
+/// another worklist, which receives the first pending edge of each node as
+/// its representative; edges that arrive while their node is pending join
+/// the node's batch. popBatch() thus yields all facts that have reached a
+/// node until it is processed, in the order given by the scheduling
+/// worklist.
+template <typename N, typename D>
+class NodeBatchingPathEdgeWorklist : public PathEdgeWorklist<N, D> {
+private:
+  // the pending edges of a node; pop() advances Next rather than erasing
+  // the front of Edges
+  struct Batch {
+    std::vector<PathEdge<N, D>> Edges;
+    size_t Next = 0;
+  };
+
+  std::unique_ptr<PathEdgeWorklist<N, D>> Nodes;
+  std::unordered_map<N, Batch> Pending;
+  size_t NumEdges = 0;
+
+public:
+  explicit NodeBatchingPathEdgeWorklist(
+      std::unique_ptr<PathEdgeWorklist<N, D>> Nodes)
+      : Nodes(std::move(Nodes)) {}
+
+  void push(PathEdge<N, D> Edge) override {
+    auto &Edges = Pending[Edge.getTarget()].Edges;
+    if (Edges.empty()) {
+      Nodes->push(Edge);
+    }
+    Edges.push_back(std::move(Edge));
+    ++NumEdges;
+  }
+
+  PathEdge<N, D> pop() override {
+    auto Search = Pending.find(Nodes->pop().getTarget());
+    auto &[Edges, Next] = Search->second;
+    PathEdge<N, D> Edge = std::move(Edges[Next++]);
+    --NumEdges;
+    if (Next == Edges.size()) {
+      Pending.erase(Search);
+    } else {
+      Nodes->push(Edges[Next]);
+    }
+    return Edge;
+  }
+
+  void popBatch(std::vector<PathEdge<N, D>> &Edges) override {
+    auto Search = Pending.find(Nodes->pop().getTarget());
+    auto &Batch = Search->second;
+    NumEdges -= Batch.Edges.size() - Batch.Next;
+    Edges.insert(Edges.end(),
+                 std::make_move_iterator(Batch.Edges.begin() + Batch.Next),
+                 std::make_move_iterator(Batch.Edges.end()));
+    Pending.erase(Search);
+  }
+
+  [[nodiscard]] bool empty() const override { return NumEdges == 0; }
+
+  [[nodiscard]] size_t size() const override { return NumEdges; }
+};
+
+/// Creates the path-edge worklist for the given kind. Returns a nullptr for
+/// PathEdgeWorklistKind::Recursive, which does not use an explicit worklist.
+template <typename N, typename D, typename ICFGTy>
+std::unique_ptr<PathEdgeWorklist<N, D>>
+makePathEdgeWorklist(PathEdgeWorklistKind Kind, const ICFGTy *ICF) {
+  switch (Kind) {
+  case PathEdgeWorklistKind::FIFO:
+    return std::make_unique<FIFOPathEdgeWorklist<N, D>>();
+  case PathEdgeWorklistKind::LIFO:
+    return std::make_unique<LIFOPathEdgeWorklist<N, D>>();
+  case PathEdgeWorklistKind::ReversePostOrder:
+    return std::make_unique<RPOPathEdgeWorklist<N, D, ICFGTy>>(ICF);
+  default:
+    return nullptr;
+  }
+}
+
+/**
+ * Distributes the path edges of a parallel Phase I over a fixed number of
+ * workers. Each worker owns a deque from which it pops the most recently
+ * pushed edge; a worker whose deque has run empty steals the oldest edge of
+ * another worker. Edges pushed from a worker thread end up in that worker's
+ * deque, edges pushed from any other thread are distributed round-robin.
+ *
+ * The queue counts all edges that have been pushed but not yet completely
+ * processed. Workers terminate once that number drops to zero, i.e. once no
+ * edge is queued and no worker can produce new edges anymore.
+ */
+template <typename N, typename D> class WorkStealingPathEdgeQueue {
+private:
+  struct WorkerQueue {
+    std::mutex Mutex;
+    std::deque<PathEdge<N, D>> Edges;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+  std::atomic<size_t> Pending{0};
+  std::atomic<size_t> NextQueue{0};
+  std::atomic<bool> Aborted{false};
+
+  // identifies the queue and worker the current thread is running for
+  inline static thread_local const WorkStealingPathEdgeQueue *CurrentQueue =
+      nullptr;
+  inline static thread_local size_t CurrentWorker = 0;
+
+  std::optional<PathEdge<N, D>> popOwn(size_t Worker) {
+    WorkerQueue &Q = *Queues[Worker];
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Edges.empty()) {
+      return std::nullopt;
+    }
+    PathEdge<N, D> Edge = std::move(Q.Edges.back());
+    Q.Edges.pop_back();
+    return Edge;
+  }
+
+  std::optional<PathEdge<N, D>> steal(size_t Worker) {
+    for (size_t I = 1; I < Queues.size(); ++I) {
+      WorkerQueue &Q = *Queues[(Worker + I) % Queues.size()];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (!Q.Edges.empty()) {
+        PathEdge<N, D> Edge = std::move(Q.Edges.front());
+        Q.Edges.pop_front();
+        return Edge;
+      }
+    }
+    return std::nullopt;
+  }
+
+public:
+  explicit WorkStealingPathEdgeQueue(size_t NumWorkers) {
+    for (size_t I = 0; I < std::max<size_t>(NumWorkers, 1); ++I) {
+      Queues.push_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
+  [[nodiscard]] size_t getNumWorkers() const { return Queues.size(); }
+
+  void push(PathEdge<N, D> Edge) {
+    size_t Worker = CurrentQueue == this
+                        ? CurrentWorker
+                        : NextQueue.fetch_add(1) % Queues.size();
+    Pending.fetch_add(1);
+    WorkerQueue &Q = *Queues[Worker];
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    Q.Edges.push_back(std::move(Edge));
+  }
+
+  /// Number of edges that have been pushed but not completely processed yet.
+  [[nodiscard]] size_t size() const { return Pending.load(); }
+
+  /// Makes all workers return from run() as soon as they have finished their
+  /// current edge; the remaining edges are dropped.
+  void abort() { Aborted.store(true); }
+
+  /// Processes path edges as the given worker until all workers have run out
+  /// of edges. ProcessEdge may push new edges onto this queue.
+  template <typename Fn> void run(size_t Worker, Fn ProcessEdge) {
+    CurrentQueue = this;
+    CurrentWorker = Worker;
+    while (!Aborted.load()) {
+      std::optional<PathEdge<N, D>> Edge = popOwn(Worker);
+      if (!Edge) {
+        Edge = steal(Worker);
+      }
+      if (Edge) {
+        ProcessEdge(std::move(*Edge));
+        Pending.fetch_sub(1);
+      } else if (Pending.load() == 0) {
+        break;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    CurrentQueue = nullptr;
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -39,19 +39,33 @@ public:
   L resultAt(N stmt, D node) const { return results.get(stmt, node); }
 
   std::unordered_map<D, L> resultsAt(N stmt, bool stripZero = false) const {
-    std::unordered_map<D, L> result = results.row(stmt);
-    if (stripZero) {
-      for (auto it = result.begin(); it != result.end();) {
-        if (it->first == zeroValue) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
-    }
+    std::unordered_map<D, L> result;
+    foreachResultAt(
+        stmt, [&result](const D &fact, const L &value) {
+          result.emplace(fact, value);
+        },
+        stripZero);
     return result;
   }
 
+  // Calls F(fact, value) for each result at the given statement without
+  // copying the results. The artificial zero value can be automatically
+  // stripped.
+  template <typename Fn>
+  void foreachResultAt(N stmt, Fn F, bool stripZero = false) const {
+    results.foreachInRow(stmt, [&](const D &fact, const L &value) {
+      if (!stripZero || fact != zeroValue) {
+        F(fact, value);
+      }
+    });
+  }
+
+  // Calls F(stmt, fact, value) for each result without copying the results.
+  // The statements are visited in no particular order.
+  template <typename Fn> void foreachResult(Fn F) const {
+    results.foreachCell(F);
+  }
+
   // this function only exists for IFDS problems which use BinaryDomain as their
   // value domain L
   template <typename ValueDomain = L,
@@ -59,10 +73,9 @@ public:
                 std::is_same_v<ValueDomain, BinaryDomain>>>
   std::set<D> ifdsResultsAt(N stmt) const {
     std::set<D> KeySet;
-    std::unordered_map<D, BinaryDomain> ResultMap = this->resultsAt(stmt);
-    for (auto FlowFact : ResultMap) {
-      KeySet.insert(FlowFact.first);
-    }
+    foreachResultAt(stmt, [&KeySet](const D &FlowFact, const BinaryDomain &) {
+      KeySet.insert(FlowFact);
+    });
     return KeySet;
   }
 };
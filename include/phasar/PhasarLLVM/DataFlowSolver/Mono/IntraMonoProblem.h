@@ -61,6 +61,8 @@ protected:
   const PointsToInfo<v_t, n_t> *PT;
   std::set<std::string> EntryPoints;
   [[maybe_unused]] SoundnessFlag SF = SoundnessFlag::UNUSED;
+  // assigns the data-flow facts of this problem their bits in BitVectorSets
+  BitVectorSetIndex<d_t> FactIndex;
 
 public:
   // denote that a problem does not require a configuration (type/file)
@@ -85,6 +87,11 @@ public:
 
   std::set<std::string> getEntryPoints() const { return EntryPoints; }
 
+  /// Returns the index of the data-flow facts of this problem. Sets that use
+  /// it only span the facts of this problem and do not compete with other
+  /// analyses for the global index of d_t.
+  BitVectorSetIndex<d_t> &getFactIndex() { return FactIndex; }
+
   const ProjectIRDB *getProjectIRDB() const { return IRDB; }
 
   const TypeHierarchy<t_t, f_t> *getTypeHierarchy() const { return TH; }
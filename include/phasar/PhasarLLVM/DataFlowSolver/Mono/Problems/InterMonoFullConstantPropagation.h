@@ -41,6 +41,32 @@ struct InterMonoFullConstantPropagationAnalysisDomain
   using i_t = LLVMBasedICFG;
 };
 
+} // namespace psr
+
+// the fact index of the problem hashes the facts, so std::hash must be
+// specialized before the problem is defined
+namespace std {
+
+template <>
+struct hash<psr::InterMonoFullConstantPropagationAnalysisDomain::d_t> {
+  size_t operator()(
+      const psr::InterMonoFullConstantPropagationAnalysisDomain::d_t &P) const {
+    std::hash<const llvm::Value *> hash_ptr;
+    std::hash<int64_t> hash_unsigned;
+    size_t hp = hash_ptr(P.first);
+    size_t hu = 0;
+    // returns nullptr if P.second is Top or Bottom, a valid pointer otherwise
+    if (const auto *Ptr = std::get_if<int64_t>(&P.second)) {
+      hu = *Ptr;
+    }
+    return hp ^ (hu << 1);
+  }
+};
+
+} // namespace std
+
+namespace psr {
+
 class InterMonoFullConstantPropagation
     : public InterMonoProblem<InterMonoFullConstantPropagationAnalysisDomain> {
 public:
@@ -85,28 +111,4 @@ public:
 
 } // namespace psr
 
-namespace std {
-
-template <>
-struct hash<std::pair<
-    const llvm::Value *,
-    psr::LatticeDomain<psr::InterMonoFullConstantPropagation::plain_d_t>>> {
-  size_t operator()(const std::pair<const llvm::Value *,
-                                    psr::LatticeDomain<int64_t>> &P) const {
-    std::hash<const llvm::Value *> hash_ptr;
-    std::hash<int64_t> hash_unsigned;
-    size_t hp = hash_ptr(P.first);
-    size_t hu = 0;
-    // returns nullptr if P.second is Top or Bottom, a valid pointer otherwise
-    if (const auto *Ptr =
-            std::get_if<psr::InterMonoFullConstantPropagation::plain_d_t>(
-                &P.second)) {
-      hu = *Ptr;
-    }
-    return hp ^ (hu << 1);
-  }
-};
-
-} // namespace std
-
 #endif
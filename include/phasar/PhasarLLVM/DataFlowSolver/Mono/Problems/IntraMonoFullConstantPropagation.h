@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_MONO_PROBLEMS_INTRAMONOFULLCONSTANTPROPAGATION_H_
 #define PHASAR_PHASARLLVM_MONO_PROBLEMS_INTRAMONOFULLCONSTANTPROPAGATION_H_
 
+#include <functional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -46,6 +47,24 @@ struct IntraMonoFullConstantPropagationAnalysisDomain
   using i_t = LLVMBasedCFG;
 };
 
+} // namespace psr
+
+// the fact index of the problem hashes the facts, so std::hash must be
+// specialized before the problem is defined
+namespace std {
+template <> struct hash<pair<const llvm::Value *, unsigned>> {
+  size_t operator()(const pair<const llvm::Value *, unsigned> &P) const {
+    std::hash<const llvm::Value *> HashPtr;
+    std::hash<unsigned> HashUnsigned;
+    size_t HP = HashPtr(P.first);
+    size_t HU = HashUnsigned(P.second);
+    return HP ^ (HU << 1);
+  }
+};
+} // namespace std
+
+namespace psr {
+
 class IntraMonoFullConstantPropagation
     : public IntraMonoProblem<IntraMonoFullConstantPropagationAnalysisDomain> {
 public:
@@ -274,7 +274,7 @@ public:
   }
 
   BitVectorSet<d_t> getResultsAt(n_t n) {
-    BitVectorSet<d_t> Result;
+    BitVectorSet<d_t> Result(IMProblem.getFactIndex());
     for (auto &[CTX, Facts] : Analysis[n]) {
       Result.insert(Facts);
     }
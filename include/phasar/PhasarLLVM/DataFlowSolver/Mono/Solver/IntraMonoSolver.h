@@ -56,7 +56,8 @@ protected:
                       ControlFlowEdges.end());
       // set all analysis information to the empty set
       for (auto s : CFG->getAllInstructionsOf(Function)) {
-        Analysis.insert(std::make_pair(s, BitVectorSet<d_t>()));
+        Analysis.insert(
+            std::make_pair(s, BitVectorSet<d_t>(IMProblem.getFactIndex())));
       }
     }
     // insert initial seeds
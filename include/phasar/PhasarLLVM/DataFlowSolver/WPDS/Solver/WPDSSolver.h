@@ -17,6 +17,7 @@
 #include <set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/raw_ostream.h"
@@ -192,6 +193,14 @@ public:
     }
   }
 
+  // the PDS rules are added per path edge
+  void processNormalFlowBatch(
+      n_t n, const std::vector<PathEdge<n_t, d_t>> &Edges) override {
+    for (const auto &Edge : Edges) {
+      processNormalFlow(Edge);
+    }
+  }
+
   void processNormalFlow(PathEdge<n_t, d_t> edge) override {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "WPDS::processNormal");
     PAMM_GET_INSTANCE;
@@ -11,10 +11,16 @@
 #define PHASAR_UTILS_BITVECTORSET_H_
 
 #include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
 #include <initializer_list>
-
-#include "boost/bimap.hpp"
-#include "boost/bimap/unordered_set_of.hpp"
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "llvm/ADT/BitVector.h"
 
@@ -44,137 +50,220 @@ inline bool isLess(const llvm::BitVector &Lhs, const llvm::BitVector &Rhs) {
   }
   return false;
 }
+
+// compares the bits of Lhs and Rhs, treating missing upper bits as zeros
+inline bool isEqual(const llvm::BitVector &Lhs, const llvm::BitVector &Rhs) {
+  unsigned LhsBits = Lhs.size();
+  unsigned RhsBits = Rhs.size();
+  if (LhsBits > RhsBits && Lhs.find_first_in(RhsBits, LhsBits) != -1) {
+    return false;
+  }
+  if (RhsBits > LhsBits && Rhs.find_first_in(LhsBits, RhsBits) != -1) {
+    return false;
+  }
+  for (unsigned I = 0, E = std::min(LhsBits, RhsBits); I < E; ++I) {
+    if (Lhs[I] != Rhs[I]) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace internal
 
 /**
- * BitVectorSet implements a set that requires minimal space. Elements are
- * kept in a static map and the set itself only stores a vector of bits which
- * indicate whether elements are contained in the set.
+ * Assigns the elements of BitVectorSets their positions in the sets' bit
+ * vectors. An index can be shared by any number of sets; only sets that
+ * share an index can be combined by plain bitwise operations. Lookups may
+ * run concurrently with each other and with insertions.
  *
- * @brief Implements a set that requires minimal space.
+ * Sets that are not given an index use the global index of their element
+ * type. Analyses that run concurrently, or that want their bit vectors to
+ * only span their own elements, should use an index of their own that
+ * outlives all of their sets.
  */
-template <typename T> class BitVectorSet {
+template <typename T> class BitVectorSetIndex {
+public:
+  BitVectorSetIndex() = default;
+  BitVectorSetIndex(const BitVectorSetIndex &) = delete;
+  BitVectorSetIndex &operator=(const BitVectorSetIndex &) = delete;
+  BitVectorSetIndex(BitVectorSetIndex &&) = delete;
+  BitVectorSetIndex &operator=(BitVectorSetIndex &&) = delete;
+  ~BitVectorSetIndex() = default;
+
+  /// Returns the index that is used by sets without an explicit one.
+  static BitVectorSetIndex &getGlobal() {
+    static BitVectorSetIndex Global;
+    return Global;
+  }
+
+  /// Returns the position of Elem or std::nullopt if it has none yet.
+  [[nodiscard]] std::optional<size_t> find(const T &Elem) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    auto Search = Positions.find(Elem);
+    if (Search == Positions.end()) {
+      return std::nullopt;
+    }
+    return Search->second;
+  }
+
+  /// Returns the position of Elem, which is assigned if it has none yet.
+  size_t insert(const T &Elem) {
+    if (auto Pos = find(Elem)) {
+      return *Pos;
+    }
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    auto [It, Inserted] = Positions.try_emplace(Elem, Elements.size());
+    if (Inserted) {
+      Elements.push_back(Elem);
+    }
+    return It->second;
+  }
+
+  /// Returns the element at position Pos. Elements are never moved, such
+  /// that the reference stays valid while other elements are inserted.
+  [[nodiscard]] const T &operator[](size_t Pos) const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    assert(Pos < Elements.size() && "Position out of range!");
+    return Elements[Pos];
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    return Elements.size();
+  }
+
 private:
+  mutable std::shared_mutex Mutex;
   // Using boost::hash<T> causes ambiguity for hash_value():
   //  -<llvm/ADT/Hashing.h>
   //  -<boost/functional/hash/extensions.hpp>
   //  -<boost/graph/adjacency_list.hpp>
-  using bimap_t = boost::bimap<boost::bimaps::unordered_set_of<T, std::hash<T>>,
-                               boost::bimaps::unordered_set_of<size_t>>;
-  inline static bimap_t Position;
+  std::unordered_map<T, size_t, std::hash<T>> Positions;
+  // a deque does not move its elements when it grows
+  std::deque<T> Elements;
+};
+
+/**
+ * BitVectorSet implements a set that requires minimal space. Elements are
+ * kept in an index (see BitVectorSetIndex) and the set itself only stores a
+ * vector of bits which indicate whether elements are contained in the set.
+ *
+ * Sets of different indices can be combined, compared and hashed as well,
+ * but element by element, and only sets of the same index are ordered.
+ *
+ * @brief Implements a set that requires minimal space.
+ */
+template <typename T> class BitVectorSet {
+private:
+  BitVectorSetIndex<T> *Index = &BitVectorSetIndex<T>::getGlobal();
   llvm::BitVector Bits;
 
-  template <typename D> class BitVectorSetIterator {
-    llvm::BitVector Bits;
+  class BitVectorSetIterator {
+    const BitVectorSetIndex<T> *Index = nullptr;
+    const llvm::BitVector *Bits = nullptr;
+    // the current position or -1 at the end
+    int Pos = -1;
 
   public:
     using iterator_category = std::forward_iterator_tag;
-    using value_type = D;
+    using value_type = T;
     using difference_type = std::ptrdiff_t;
-    using pointer = D *;
-    using reference = D &;
-    BitVectorSetIterator(D ptr = nullptr) : pos_ptr(ptr) {}
+    using pointer = const T *;
+    using reference = const T &;
 
-    BitVectorSetIterator<D> &operator=(D *Ptr) {
-      pos_ptr = Ptr;
-      return *this;
-    }
+    BitVectorSetIterator() = default;
 
-    void setBits(const llvm::BitVector &OtherBits) { Bits = OtherBits; }
+    BitVectorSetIterator(const BitVectorSetIndex<T> *Index,
+                         const llvm::BitVector *Bits, int Pos)
+        : Index(Index), Bits(Bits), Pos(Pos) {}
 
-    bool operator==(const BitVectorSetIterator<D> &OtherIterator) const {
-      return pos_ptr == OtherIterator.getPtr();
+    bool operator==(const BitVectorSetIterator &OtherIterator) const {
+      return Pos == OtherIterator.Pos;
     }
 
-    bool operator!=(const BitVectorSetIterator<D> &OtherIterator) const {
+    bool operator!=(const BitVectorSetIterator &OtherIterator) const {
       return !(*this == OtherIterator);
     }
 
-    BitVectorSetIterator<D> &operator+=(const difference_type &Movement) {
-      for (difference_type i = 0; i < Movement; i++) {
-        pos_ptr++;
-      }
-      return *this;
-    }
-
-    BitVectorSetIterator<D> &operator++() {
-      do {
-        int NextIdx = Bits.find_next(pos_ptr->first);
-
-        if (NextIdx <= static_cast<int>(pos_ptr->first)) {
-          pos_ptr = Position.right.find(Bits.size());
-          break;
-        }
-
-        pos_ptr = Position.right.find(NextIdx);
-
-        assert(pos_ptr->first < Bits.size() &&
-               "pos_ptr->first index into BitVector out of range");
-      } while (!Bits[pos_ptr->first]);
-
+    BitVectorSetIterator &operator++() {
+      Pos = Bits->find_next(Pos);
       return *this;
     }
 
-    BitVectorSetIterator<D> operator++(int) {
+    BitVectorSetIterator operator++(int) {
       auto Temp(*this);
       ++*this;
       return Temp;
     }
 
-    BitVectorSetIterator<D> operator+(const difference_type &Movement) {
-      auto OldPtr = pos_ptr;
-      for (difference_type i = 0; i < Movement; i++) {
-        pos_ptr++;
+    BitVectorSetIterator &operator+=(difference_type Movement) {
+      for (difference_type I = 0; I < Movement; ++I) {
+        ++*this;
       }
-      auto Temp(*this);
-      pos_ptr = OldPtr;
-      return Temp;
+      return *this;
     }
 
-    difference_type operator-(const BitVectorSetIterator<D> &OtherIterator) {
-      return std::distance(OtherIterator.getPtr(), this->getPtr());
+    BitVectorSetIterator operator+(difference_type Movement) const {
+      auto Temp(*this);
+      Temp += Movement;
+      return Temp;
     }
 
-    // T& operator*(){return pos_ptr->second;}
-
-    const T &operator*() const { return pos_ptr->second; }
-
-    D *operator->() { return pos_ptr; }
-
-    D getPtr() const { return pos_ptr; }
-
-    // const D* getConstPtr()const{return pos_ptr;}
-
-    // T getPos() {return pos_ptr->first;}
+    const T &operator*() const { return (*Index)[Pos]; }
 
-    // T getVal() {return pos_ptr->second;}
-
-    [[nodiscard]] llvm::BitVector getBits() const { return Bits; }
-
-  private:
-    D pos_ptr;
+    const T *operator->() const { return &(*Index)[Pos]; }
   };
 
-  using iterator = BitVectorSetIterator<typename bimap_t::right_iterator>;
-  using const_iterator =
-      BitVectorSetIterator<typename bimap_t::right_const_iterator>;
+  /// Returns whether the bits of this set and Other denote the same
+  /// elements, which also holds if one of them is empty.
+  [[nodiscard]] bool sharesIndexWith(const BitVectorSet &Other) const {
+    return Index == Other.Index || Bits.none() || Other.Bits.none();
+  }
 
 public:
+  using iterator = BitVectorSetIterator;
+  using const_iterator = BitVectorSetIterator;
+
   BitVectorSet() = default;
 
+  explicit BitVectorSet(BitVectorSetIndex<T> &Index) : Index(&Index) {}
+
   explicit BitVectorSet(size_t Count) : Bits(Count, false) {}
 
   BitVectorSet(std::initializer_list<T> IList) {
     insert(IList.begin(), IList.end());
   }
 
+  BitVectorSet(std::initializer_list<T> IList, BitVectorSetIndex<T> &Index)
+      : Index(&Index) {
+    insert(IList.begin(), IList.end());
+  }
+
   template <typename InputIt> BitVectorSet(InputIt First, InputIt Last) {
     insert(First, Last);
   }
 
+  template <typename InputIt>
+  BitVectorSet(InputIt First, InputIt Last, BitVectorSetIndex<T> &Index)
+      : Index(&Index) {
+    insert(First, Last);
+  }
+
+  /// Returns the index that assigns the elements of this set their bits.
+  [[nodiscard]] BitVectorSetIndex<T> &getIndex() const { return *Index; }
+
   BitVectorSet<T> setUnion(const BitVectorSet<T> &Other) const {
+    if (Index != Other.Index) {
+      if (Bits.none()) {
+        return Other;
+      }
+      BitVectorSet<T> Res(*this);
+      Res.insert(Other);
+      return Res;
+    }
     size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
     BitVectorSet<T> Res(MaxSize);
+    Res.Index = Index;
     // temp variable necessary because return type of |= is not const
     llvm::BitVector Temp = Bits;
     Res.Bits = Temp |= Other.Bits;
@@ -182,8 +271,18 @@ public:
   }
 
   BitVectorSet<T> setIntersect(const BitVectorSet<T> &Other) const {
+    if (!sharesIndexWith(Other)) {
+      BitVectorSet<T> Res(*Index);
+      for (const auto &Elem : *this) {
+        if (Other.count(Elem)) {
+          Res.insert(Elem);
+        }
+      }
+      return Res;
+    }
     size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
     BitVectorSet<T> Res(MaxSize);
+    Res.Index = Index;
     // temp variable necessary because return type of &= is not const
     llvm::BitVector Temp = Bits;
     Res.Bits = Temp &= Other.Bits;
@@ -191,6 +290,14 @@ public:
   }
 
   bool includes(const BitVectorSet<T> &Other) const {
+    if (!sharesIndexWith(Other)) {
+      for (const auto &Elem : Other) {
+        if (!count(Elem)) {
+          return false;
+        }
+      }
+      return true;
+    }
     // check if Other contains 1's at positions where this does not
     // Other is longer
     if (Bits.size() < Other.Bits.size()) {
@@ -221,31 +328,28 @@ public:
   }
 
   void insert(const T &Data) {
-    auto Search = Position.left.find(Data);
-    // Data already known
-    if (Search != Position.left.end()) {
-      if (Bits.size() <= Search->second) {
-        Bits.resize(Search->second + 1);
-      }
-      Bits[Search->second] = true;
-    } else {
-      // Data unknown
-      size_t Idx = Position.left.size();
-      Position.left.insert(std::make_pair(Data, Position.left.size()));
-      if (Bits.size() <= Position.left.size()) {
-        Bits.resize(Position.left.size());
-      }
-      Bits[Idx] = true;
+    size_t Pos = Index->insert(Data);
+    if (Bits.size() <= Pos) {
+      Bits.resize(Pos + 1);
     }
+    Bits[Pos] = true;
   }
 
   void insert(const BitVectorSet<T> &Other) {
+    if (Index != Other.Index) {
+      if (Bits.none()) {
+        *this = Other;
+        return;
+      }
+      for (const auto &Elem : Other) {
+        insert(Elem);
+      }
+      return;
+    }
     if (Other.Bits.size() > Bits.size()) {
       Bits.resize(Other.Bits.size());
     }
-    for (size_t idx = 0; idx < Other.Bits.size(); ++idx) {
-      Bits[idx] = (Bits[idx] || Other.Bits[idx]);
-    }
+    Bits |= Other.Bits;
   }
 
   template <typename InputIt> void insert(InputIt First, InputIt Last) {
@@ -255,12 +359,10 @@ public:
     }
   }
 
-  void erase(const T &Data) noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (!(Bits.size() < Search->second - 1)) {
-        Bits[Search->second] = false;
-      }
+  void erase(const T &Data) {
+    auto Pos = Index->find(Data);
+    if (Pos && *Pos < Bits.size()) {
+      Bits[*Pos] = false;
     }
   }
 
@@ -270,14 +372,12 @@ public:
 
   void reserve(size_t NewCap) { Bits.reserve(NewCap); }
 
-  [[nodiscard]] bool find(const T &Data) const noexcept { return count(Data); }
+  [[nodiscard]] bool find(const T &Data) const { return count(Data); }
 
-  [[nodiscard]] size_t count(const T &Data) const noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        return Bits[Search->second];
-      }
+  [[nodiscard]] size_t count(const T &Data) const {
+    auto Pos = Index->find(Data);
+    if (Pos && *Pos < Bits.size()) {
+      return Bits[*Pos];
     }
     return 0;
   }
@@ -285,7 +385,10 @@ public:
   [[nodiscard]] size_t size() const noexcept { return Bits.count(); }
 
   friend bool operator==(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
-    return Lhs.Bits == Rhs.Bits;
+    if (Lhs.Index != Rhs.Index) {
+      return Lhs.size() == Rhs.size() && Lhs.includes(Rhs);
+    }
+    return internal::isEqual(Lhs.Bits, Rhs.Bits);
   }
 
   friend bool operator!=(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
@@ -293,58 +396,51 @@ public:
   }
 
   friend bool operator<(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
+    assert(Lhs.sharesIndexWith(Rhs) &&
+           "Only sets of the same index are ordered!");
     return internal::isLess(Lhs.Bits, Rhs.Bits);
   }
 
   friend std::ostream &operator<<(std::ostream &OS, const BitVectorSet &B) {
     OS << '<';
     size_t Idx = 0;
-    for (auto &Position : B.Position.left) {
-      if (Position.second < B.Bits.size() && B.Bits[Position.second]) {
-        ++Idx;
-        OS << Position.first;
-        if (Idx < B.size()) {
-          OS << ", ";
-        }
+    for (const auto &Elem : B) {
+      ++Idx;
+      OS << Elem;
+      if (Idx < B.size()) {
+        OS << ", ";
       }
     }
     OS << '>';
     return OS;
   }
 
-  [[nodiscard]] iterator begin() {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
-    }
-    iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
-  }
-
-  [[nodiscard]] iterator end() {
-    iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
-  }
-
   [[nodiscard]] const_iterator begin() const {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
-    }
-    const_iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return const_iterator(Index, &Bits, Bits.find_first());
   }
 
   [[nodiscard]] const_iterator end() const {
-    const_iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+    return const_iterator(Index, &Bits, -1);
   }
 };
 
 } // namespace psr
 
+namespace std {
+template <typename T> struct hash<psr::BitVectorSet<T>> {
+  size_t operator()(const psr::BitVectorSet<T> &S) const {
+    // Hashes the elements rather than their positions, such that equal sets
+    // of different indices are hashed alike. The elements are visited in the
+    // order of their positions, so they are combined commutatively.
+    std::hash<T> HashElem;
+    size_t Hash = 0;
+    for (const auto &Elem : S) {
+      size_t H = HashElem(Elem);
+      Hash += H ^ (H >> 17) ^ (H << 31) ^ 0x9e3779b97f4a7c15ULL;
+    }
+    return Hash;
+  }
+};
+} // namespace std
+
 #endif
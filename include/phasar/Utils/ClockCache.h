@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_CLOCKCACHE_H_
+#define PHASAR_UTILS_CLOCKCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/**
+ * A hash-based cache that optionally holds at most a fixed number of
+ * entries. If the capacity is exceeded, an entry is evicted using the CLOCK
+ * (second chance) approximation of LRU: every lookup marks the entry as
+ * referenced; the clock hand sweeps over the entries, clears the marks and
+ * evicts the first entry that has not been referenced since its last sweep.
+ *
+ * A capacity of 0 means that the cache is unbounded.
+ */
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>>
+class ClockCache {
+private:
+  struct Entry {
+    KeyT Key;
+    ValueT Value;
+    bool Referenced;
+  };
+
+  std::vector<Entry> Entries;
+  std::unordered_map<KeyT, size_t, HashT> Index;
+  size_t Hand = 0;
+  size_t Capacity;
+
+public:
+  explicit ClockCache(size_t Capacity = 0) : Capacity(Capacity) {}
+
+  /// Returns the cached value for Key or nullptr if there is none. The
+  /// pointer is invalidated by the next insertion.
+  ValueT *lookup(const KeyT &Key) {
+    auto Search = Index.find(Key);
+    if (Search == Index.end()) {
+      return nullptr;
+    }
+    Entry &E = Entries[Search->second];
+    E.Referenced = true;
+    return &E.Value;
+  }
+
+  /// Inserts a value for a key that is not cached yet. Returns true if
+  /// another entry had to be evicted to make room for it.
+  bool insert(KeyT Key, ValueT Value) {
+    if (Capacity == 0 || Entries.size() < Capacity) {
+      Index.emplace(Key, Entries.size());
+      Entries.push_back({std::move(Key), std::move(Value), false});
+      return false;
+    }
+    while (Entries[Hand].Referenced) {
+      Entries[Hand].Referenced = false;
+      Hand = (Hand + 1) % Entries.size();
+    }
+    Entry &Victim = Entries[Hand];
+    Index.erase(Victim.Key);
+    Index.emplace(Key, Hand);
+    Victim = {std::move(Key), std::move(Value), false};
+    Hand = (Hand + 1) % Entries.size();
+    return true;
+  }
+
+  [[nodiscard]] size_t size() const { return Entries.size(); }
+
+  [[nodiscard]] bool empty() const { return Entries.empty(); }
+
+  [[nodiscard]] size_t capacity() const { return Capacity; }
+
+  void clear() {
+    Entries.clear();
+    Index.clear();
+    Hand = 0;
+  }
+};
+
+} // namespace psr
+
+#endif
@@ -78,6 +78,13 @@ std::string llvmIRToShortString(const llvm::Value *V);
 std::vector<const llvm::Value *>
 globalValuesUsedinFunction(const llvm::Function *F);
 
+/**
+ * @brief Returns the global variables of the given LLVM Module as well as the
+ * formal arguments and the value-producing instructions of its function
+ * definitions, i.e. the values that most data-flow facts are drawn from.
+ */
+std::vector<const llvm::Value *> getAllValuesOf(const llvm::Module &M);
+
 /**
  * Only Instructions and GlobalVariables have 'real' ID's, i.e. annotated meta
  * data. Formal arguments cannot be annotated with metadata in LLVM. Therefore,
@@ -192,6 +199,16 @@ std::size_t computeModuleHash(llvm::Module *M, bool considerIdentifier);
  */
 std::size_t computeModuleHash(const llvm::Module *M);
 
+/**
+ * @brief Computes a hash value for a given LLVM Function.
+ * @note Metadata and attribute group numbers are ignored, as they are assigned
+ * module-wide and change along with other functions of the module. The hash
+ * is stable across runs and may therefore be persisted.
+ * @param F LLVM Function.
+ * @return Hash value.
+ */
+std::size_t computeFunctionHash(const llvm::Function *F);
+
 } // namespace psr
 
 #endif
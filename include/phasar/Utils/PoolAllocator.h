@@ -0,0 +1,327 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_POOLALLOCATOR_H_
+#define PHASAR_UTILS_POOLALLOCATOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+namespace detail {
+
+using PoolReleaseFn = size_t (*)();
+
+inline std::mutex &getPoolRegistryMutex() {
+  // intentionally leaked, see FixedSizeBlockPool::getGlobalBlocks()
+  static auto *Mutex = new std::mutex();
+  return *Mutex;
+}
+
+/// The release functions of all FixedSizeBlockPools that have been used.
+inline std::vector<PoolReleaseFn> &getPoolRegistry() {
+  static auto *Registry = new std::vector<PoolReleaseFn>();
+  return *Registry;
+}
+
+inline void registerPool(PoolReleaseFn Release) {
+  std::lock_guard<std::mutex> Lock(getPoolRegistryMutex());
+  getPoolRegistry().push_back(Release);
+}
+
+} // namespace detail
+
+/**
+ * Hands out memory blocks of a fixed size. Blocks are carved from larger
+ * chunks; freed blocks are kept in a per-thread free list and reused by
+ * subsequent allocations of the same size, so that allocating and freeing
+ * does not need to go to the heap nor to synchronize in the common case. A
+ * block may be freed by a different thread than the one that allocated it.
+ * Chunks stay allocated until release() finds all of their blocks free.
+ */
+template <size_t BlockSize> class FixedSizeBlockPool {
+  static_assert(BlockSize >= sizeof(void *) &&
+                    BlockSize % alignof(std::max_align_t) == 0,
+                "Blocks must be able to hold a pointer and be aligned");
+
+private:
+  struct FreeBlock {
+    FreeBlock *Next;
+  };
+
+  static constexpr size_t BlocksPerChunk = 128;
+  // a thread returns half of its cached blocks once it holds more than this
+  static constexpr size_t MaxCachedBlocks = 4 * BlocksPerChunk;
+
+  struct FreeList {
+    FreeBlock *Head = nullptr;
+    size_t Size = 0;
+
+    void push(FreeBlock *Block) {
+      Block->Next = Head;
+      Head = Block;
+      ++Size;
+    }
+
+    FreeBlock *pop() {
+      FreeBlock *Block = Head;
+      Head = Block->Next;
+      --Size;
+      return Block;
+    }
+  };
+
+  struct GlobalFreeList {
+    std::mutex Mutex;
+    FreeList Blocks;
+    // all chunks of this pool
+    std::vector<char *> Chunks;
+
+    // Requires Mutex to be held.
+    void addChunk() {
+      auto *Chunk =
+          static_cast<char *>(::operator new(BlockSize * BlocksPerChunk));
+      Chunks.push_back(Chunk);
+      for (size_t I = BlocksPerChunk; I > 0; --I) {
+        Blocks.push(reinterpret_cast<FreeBlock *>(Chunk + (I - 1) * BlockSize));
+      }
+    }
+  };
+
+  // Trivially destructible, hence still usable while static objects are
+  // destroyed after the thread has terminated.
+  struct ThreadFreeList {
+    FreeList Blocks;
+    bool Retired = false;
+  };
+
+  // Hands the blocks of a terminating thread back to the global free list.
+  struct ThreadFreeListRetirer {
+    ~ThreadFreeListRetirer() {
+      releaseCachedBlocks(LocalBlocks.Blocks.Size);
+      LocalBlocks.Retired = true;
+    }
+  };
+
+  inline static thread_local ThreadFreeList LocalBlocks;
+  inline static thread_local ThreadFreeListRetirer Retirer;
+
+  static GlobalFreeList &getGlobalBlocks() {
+    // intentionally leaked, blocks may still be freed during static
+    // destruction
+    static auto *Global = [] {
+      detail::registerPool(&release);
+      return new GlobalFreeList();
+    }();
+    return *Global;
+  }
+
+  static void releaseCachedBlocks(size_t N) {
+    if (N == 0) {
+      return;
+    }
+    GlobalFreeList &Global = getGlobalBlocks();
+    std::lock_guard<std::mutex> Lock(Global.Mutex);
+    for (size_t I = 0; I < N; ++I) {
+      Global.Blocks.push(LocalBlocks.Blocks.pop());
+    }
+  }
+
+  static void refill() {
+    GlobalFreeList &Global = getGlobalBlocks();
+    std::lock_guard<std::mutex> Lock(Global.Mutex);
+    if (!Global.Blocks.Head) {
+      Global.addChunk();
+    }
+    while (Global.Blocks.Head && LocalBlocks.Blocks.Size < BlocksPerChunk) {
+      LocalBlocks.Blocks.push(Global.Blocks.pop());
+    }
+  }
+
+public:
+  static void *allocate() {
+    if (LocalBlocks.Retired) {
+      GlobalFreeList &Global = getGlobalBlocks();
+      std::lock_guard<std::mutex> Lock(Global.Mutex);
+      if (!Global.Blocks.Head) {
+        Global.addChunk();
+      }
+      return Global.Blocks.pop();
+    }
+    // registers the retirer for the current thread
+    (void)&Retirer;
+    if (!LocalBlocks.Blocks.Head) {
+      refill();
+    }
+    return LocalBlocks.Blocks.pop();
+  }
+
+  static void deallocate(void *Ptr) {
+    auto *Block = static_cast<FreeBlock *>(Ptr);
+    if (LocalBlocks.Retired) {
+      GlobalFreeList &Global = getGlobalBlocks();
+      std::lock_guard<std::mutex> Lock(Global.Mutex);
+      Global.Blocks.push(Block);
+      return;
+    }
+    (void)&Retirer;
+    LocalBlocks.Blocks.push(Block);
+    if (LocalBlocks.Blocks.Size > MaxCachedBlocks) {
+      releaseCachedBlocks(MaxCachedBlocks / 2);
+    }
+  }
+
+  /**
+   * Returns the chunks of which all blocks are free to the heap, after the
+   * calling thread has handed back the blocks it caches. Blocks cached by
+   * other threads are left alone and keep their chunks alive, hence this may
+   * be called while other threads use the pool.
+   * @return The number of bytes returned to the heap.
+   */
+  static size_t release() {
+    releaseCachedBlocks(LocalBlocks.Blocks.Size);
+    GlobalFreeList &Global = getGlobalBlocks();
+    std::lock_guard<std::mutex> Lock(Global.Mutex);
+    auto &Chunks = Global.Chunks;
+    if (Chunks.empty()) {
+      return 0;
+    }
+    std::sort(Chunks.begin(), Chunks.end(), std::less<char *>());
+    auto getChunkIndex = [&Chunks](FreeBlock *Block) {
+      return std::upper_bound(Chunks.begin(), Chunks.end(),
+                              reinterpret_cast<char *>(Block),
+                              std::less<char *>()) -
+             Chunks.begin() - 1;
+    };
+    std::vector<size_t> NumFree(Chunks.size());
+    for (FreeBlock *Block = Global.Blocks.Head; Block; Block = Block->Next) {
+      ++NumFree[getChunkIndex(Block)];
+    }
+    FreeList Kept;
+    while (Global.Blocks.Head) {
+      FreeBlock *Block = Global.Blocks.pop();
+      if (NumFree[getChunkIndex(Block)] != BlocksPerChunk) {
+        Kept.push(Block);
+      }
+    }
+    Global.Blocks = Kept;
+    size_t NumReleased = 0;
+    for (size_t I = 0; I < Chunks.size(); ++I) {
+      if (NumFree[I] == BlocksPerChunk) {
+        ::operator delete(Chunks[I]);
+        Chunks[I] = nullptr;
+        ++NumReleased;
+      }
+    }
+    Chunks.erase(std::remove(Chunks.begin(), Chunks.end(), nullptr),
+                 Chunks.end());
+    return NumReleased * BlockSize * BlocksPerChunk;
+  }
+};
+
+/**
+ * Returns the memory of all FixedSizeBlockPools that is no longer in use to
+ * the heap (see FixedSizeBlockPool::release()).
+ * @return The number of bytes returned to the heap.
+ */
+inline size_t releasePooledMemory() {
+  std::vector<detail::PoolReleaseFn> Pools;
+  {
+    std::lock_guard<std::mutex> Lock(detail::getPoolRegistryMutex());
+    Pools = detail::getPoolRegistry();
+  }
+  size_t NumReleased = 0;
+  for (auto Release : Pools) {
+    NumReleased += Release();
+  }
+  return NumReleased;
+}
+
+/**
+ * Ties the pooled memory to the lifetime of an owner, such as a solver: when
+ * the scope is destroyed, the pooled memory that is no longer in use is
+ * returned to the heap. Declare it as the first data member so that it is
+ * destroyed after all other members have freed their pooled objects.
+ */
+class PooledMemoryScope {
+public:
+  PooledMemoryScope() = default;
+  PooledMemoryScope(const PooledMemoryScope &) = delete;
+  PooledMemoryScope &operator=(const PooledMemoryScope &) = delete;
+  ~PooledMemoryScope() { releasePooledMemory(); }
+};
+
+/**
+ * A standard allocator that serves single-object allocations from a
+ * FixedSizeBlockPool matching the object's size. Object sizes are rounded up
+ * to the fundamental alignment such that types of similar size share a pool.
+ * Array and over-aligned allocations fall back to std::allocator.
+ */
+template <typename T> class PoolAllocator {
+private:
+  static constexpr size_t BlockSize =
+      (sizeof(T) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+  static constexpr bool UsePool = alignof(T) <= alignof(std::max_align_t);
+
+public:
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+
+  template <typename U> PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T *allocate(size_t N) {
+    if constexpr (UsePool) {
+      if (N == 1) {
+        return static_cast<T *>(FixedSizeBlockPool<BlockSize>::allocate());
+      }
+    }
+    return std::allocator<T>().allocate(N);
+  }
+
+  void deallocate(T *Ptr, size_t N) noexcept {
+    if constexpr (UsePool) {
+      if (N == 1) {
+        FixedSizeBlockPool<BlockSize>::deallocate(Ptr);
+        return;
+      }
+    }
+    std::allocator<T>().deallocate(Ptr, N);
+  }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
+
+  template <typename U> bool operator!=(const PoolAllocator<U> &) const {
+    return false;
+  }
+};
+
+/// Creates a shared object, similar to std::make_shared, whose object and
+/// reference counts are stored in a single pooled block. Meant for small
+/// objects that are created and destroyed at a high rate, such as edge and
+/// flow functions.
+template <typename T, typename... ArgTs>
+std::shared_ptr<T> makePooledShared(ArgTs &&... Args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(),
+                                 std::forward<ArgTs>(Args)...);
+}
+
+} // namespace psr
+
+#endif
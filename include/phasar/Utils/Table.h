@@ -93,6 +93,36 @@ public:
     return s;
   }
 
+  template <typename Fn> void foreachCell(Fn F) const {
+    // Calls F(row key, column key, value) for each triplet without copying the
+    // table's contents.
+    for (const auto &m1 : table) {
+      for (const auto &m2 : m1.second) {
+        F(m1.first, m2.first, m2.second);
+      }
+    }
+  }
+
+  template <typename Fn> void foreachRow(Fn F) const {
+    // Calls F(row key, row) for each row, where row maps the column keys to
+    // the values, without copying the table's contents.
+    for (const auto &m1 : table) {
+      F(m1.first, m1.second);
+    }
+  }
+
+  template <typename Fn> void foreachInRow(R rowKey, Fn F) const {
+    // Calls F(column key, value) for each mapping that has the given row key
+    // without copying it; unlike row(), this does not insert an empty row.
+    auto search = table.find(rowKey);
+    if (search == table.end()) {
+      return;
+    }
+    for (const auto &m2 : search->second) {
+      F(m2.first, m2.second);
+    }
+  }
+
   [[nodiscard]] std::vector<Cell> cellVec() const {
     // Returns a vector of all row key / column key / value triplets.
     std::vector<Cell> v;
@@ -181,6 +211,12 @@ public:
     return table[rowKey][columnKey];
   }
 
+  [[nodiscard]] const V &get(R rowKey, C columnKey) const {
+    // Returns the value corresponding to the given row and column keys; the
+    // mapping must exist.
+    return table.at(rowKey).at(columnKey);
+  }
+
   V remove(R rowKey, C columnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V v = table[rowKey][columnKey];
@@ -10,6 +10,7 @@
 #ifndef PHASAR_UTILS_UTILITIES_H_
 #define PHASAR_UTILS_UTILITIES_H_
 
+#include <cstddef>
 #include <iosfwd>
 #include <set>
 #include <string>
@@ -23,6 +24,10 @@ namespace psr {
 
 std::string createTimeStamp();
 
+/// Returns the resident set size of the current process in bytes, or 0 if
+/// it cannot be determined on this platform.
+size_t getResidentSetSize();
+
 std::string cxxDemangle(const std::string &MangledName);
 
 bool isConstructor(const std::string &MangledName);
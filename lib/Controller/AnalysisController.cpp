@@ -18,6 +18,8 @@
 
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/WholeProgramAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEInstInteractionAnalysis.h"
@@ -38,6 +40,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/InternedIFDSSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoSolverTest.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoTaintAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoFullConstantPropagation.h"
@@ -51,20 +54,6 @@
 using namespace std;
 using namespace psr;
 
-namespace std {
-
-template <> struct hash<pair<const llvm::Value *, unsigned>> {
-  size_t operator()(const pair<const llvm::Value *, unsigned> &P) const {
-    std::hash<const llvm::Value *> HashPtr;
-    std::hash<unsigned> HashUnsigned;
-    size_t Hp = HashPtr(P.first);
-    size_t Hu = HashUnsigned(P.second);
-    return Hp ^ (Hu << 1);
-  }
-};
-
-} // namespace std
-
 namespace psr {
 
 bool needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
@@ -98,13 +87,13 @@ AnalysisController::AnalysisController(
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   switch (Strategy) {
   case AnalysisStrategy::DemandDriven:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeDemandDriven();
     break;
   case AnalysisStrategy::Incremental:
     llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
     break;
   case AnalysisStrategy::ModuleWise:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeModuleWise();
     break;
   case AnalysisStrategy::Variational:
     llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
@@ -117,11 +106,65 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   }
 }
 
-void AnalysisController::executeDemandDriven() {}
+void AnalysisController::executeDemandDriven() {
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+      switch (DataFlowAnalysis) {
+      case DataFlowAnalysisType::IFDSTaintAnalysis: {
+        DemandDrivenAnalysis<IFDSTaintAnalysis> DDA(
+            IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
+        // leaks can only be observed at the sink call sites
+        auto SinkCallSites = DDA.getProblem().getSinkCallSites();
+        DDA.demand({SinkCallSites.begin(), SinkCallSites.end()});
+        emitRequestedDataFlowResults(DDA);
+        DDA.releaseAllHelperAnalyses();
+      } break;
+      default:
+        llvm::report_fatal_error(
+            "DataFlowAnalysisType not supported demand-driven, yet!");
+        break;
+      }
+    } else {
+      llvm::report_fatal_error(
+          "DataFlowAnalysisType not supported demand-driven, yet!");
+    }
+    ++ConfigIdx;
+  }
+}
 
 void AnalysisController::executeIncremental() {}
 
-void AnalysisController::executeModuleWise() {}
+void AnalysisController::executeModuleWise() {
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+      switch (DataFlowAnalysis) {
+      case DataFlowAnalysisType::IFDSTaintAnalysis: {
+        ModuleWiseAnalysis<IFDSTaintAnalysis> MWA(IRDB, AnalysisConfigPath,
+                                                  EntryPoints, &PT, &TH);
+        MWA.solve();
+        emitRequestedDataFlowResults(MWA);
+        MWA.releaseAllHelperAnalyses();
+      } break;
+      default:
+        llvm::report_fatal_error(
+            "DataFlowAnalysisType not supported module-wise, yet!");
+        break;
+      }
+    } else {
+      llvm::report_fatal_error(
+          "DataFlowAnalysisType not supported module-wise, yet!");
+    }
+    ++ConfigIdx;
+  }
+}
 
 void AnalysisController::executeVariational() {}
 
@@ -192,7 +235,8 @@ void AnalysisController::executeWholeProgram() {
         WPA.releaseAllHelperAnalyses();
       } break;
       case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+        // its facts are expensive to copy and compare, so intern them
+        WholeProgramAnalysis<InternedIFDSSolver_P<IFDSFieldSensTaintAnalysis>,
                              IFDSFieldSensTaintAnalysis>
             WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
         WPA.solve();
@@ -0,0 +1,374 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ESGTrace.h"
+#include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+// the number of bytes that are buffered before they are written
+constexpr size_t BufferCapacity = 1 << 20;
+
+template <typename T> void write(std::vector<char> &Buffer, T Value) {
+  const char *Bytes = reinterpret_cast<const char *>(&Value);
+  Buffer.insert(Buffer.end(), Bytes, Bytes + sizeof(T));
+}
+
+void write(std::vector<char> &Buffer, llvm::StringRef S) {
+  write<uint32_t>(Buffer, S.size());
+  Buffer.insert(Buffer.end(), S.begin(), S.end());
+}
+
+// decodes the records of a mapped trace; fails at the end of the trace
+class Cursor {
+public:
+  Cursor(llvm::StringRef Data, size_t Offset) : Data(Data), Offset(Offset) {}
+
+  template <typename T> bool read(T &Value) {
+    if (Data.size() - Offset < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&Value, Data.data() + Offset, sizeof(T));
+    Offset += sizeof(T);
+    return true;
+  }
+
+  bool read(llvm::StringRef &S) {
+    uint32_t Size;
+    if (!read(Size) || Data.size() - Offset < Size) {
+      return false;
+    }
+    S = Data.substr(Offset, Size);
+    Offset += Size;
+    return true;
+  }
+
+  [[nodiscard]] size_t getOffset() const { return Offset; }
+
+private:
+  llvm::StringRef Data;
+  size_t Offset;
+};
+
+// defines the next ID; fails for any other ID, which a valid trace never has
+template <typename T> bool define(std::vector<T> &Defs, uint32_t ID, T Def) {
+  if (ID != Defs.size()) {
+    return false;
+  }
+  Defs.push_back(std::move(Def));
+  return true;
+}
+
+} // anonymous namespace
+
+ESGTraceWriter::ESGTraceWriter(const std::string &TraceFile)
+    : OS(TraceFile, std::ios::binary | std::ios::trunc) {
+  Buffer.reserve(BufferCapacity);
+  Buffer.insert(Buffer.end(), ESGTraceFormat::Magic,
+                ESGTraceFormat::Magic + sizeof(ESGTraceFormat::Magic));
+  write(Buffer, ESGTraceFormat::FormatVersion);
+}
+
+ESGTraceWriter::~ESGTraceWriter() { flush(); }
+
+void ESGTraceWriter::addFunction(uint32_t ID, llvm::StringRef Name) {
+  write(Buffer, ESGTraceFormat::FunctionRecord);
+  write(Buffer, ID);
+  write(Buffer, Name);
+}
+
+void ESGTraceWriter::addNode(uint32_t ID, uint32_t Function,
+                             llvm::StringRef StmtID, llvm::StringRef Label) {
+  write(Buffer, ESGTraceFormat::NodeRecord);
+  write(Buffer, ID);
+  write(Buffer, Function);
+  write(Buffer, StmtID);
+  write(Buffer, Label);
+}
+
+void ESGTraceWriter::addFact(uint32_t ID, bool IsZero, llvm::StringRef Label) {
+  write(Buffer, ESGTraceFormat::FactRecord);
+  write(Buffer, ID);
+  write<uint8_t>(Buffer, IsZero);
+  write(Buffer, Label);
+}
+
+void ESGTraceWriter::addEdge(bool InterP, uint32_t SrcNode, uint32_t SrcFact,
+                             uint32_t DstNode, uint32_t DstFact) {
+  write(Buffer, InterP ? ESGTraceFormat::InterEdgeRecord
+                       : ESGTraceFormat::IntraEdgeRecord);
+  write(Buffer, SrcNode);
+  write(Buffer, SrcFact);
+  write(Buffer, DstNode);
+  write(Buffer, DstFact);
+  if (Buffer.size() >= BufferCapacity) {
+    flush();
+  }
+}
+
+void ESGTraceWriter::flush() {
+  OS.write(Buffer.data(), Buffer.size());
+  OS.flush();
+  Buffer.clear();
+}
+
+ESGTraceReader::ESGTraceReader() = default;
+
+ESGTraceReader::~ESGTraceReader() = default;
+
+bool ESGTraceReader::load(const std::string &TraceFile) {
+  Functions.clear();
+  Nodes.clear();
+  Facts.clear();
+  NumEdges = 0;
+  auto File = llvm::MemoryBuffer::getFile(TraceFile, /*FileSize=*/-1,
+                                          /*RequiresNullTerminator=*/false);
+  if (!File) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                  << "Cannot read ESG trace " << TraceFile << ": "
+                  << File.getError().message());
+    return false;
+  }
+  Trace = std::move(*File);
+  llvm::StringRef Data = Trace->getBuffer();
+  llvm::StringRef Magic(ESGTraceFormat::Magic, sizeof(ESGTraceFormat::Magic));
+  Cursor C(Data, std::min(Data.size(), Magic.size()));
+  uint32_t Version;
+  if (!Data.startswith(Magic) || !C.read(Version) ||
+      Version != ESGTraceFormat::FormatVersion) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                  << "Unsupported ESG trace format: " << TraceFile);
+    return false;
+  }
+  FirstRecord = End = C.getOffset();
+  uint8_t Kind;
+  while (C.read(Kind)) {
+    uint32_t ID;
+    bool Complete = false;
+    switch (Kind) {
+    case ESGTraceFormat::FunctionRecord: {
+      llvm::StringRef Name;
+      Complete = C.read(ID) && C.read(Name) && define(Functions, ID, Name);
+      break;
+    }
+    case ESGTraceFormat::NodeRecord: {
+      Node N;
+      Complete = C.read(ID) && C.read(N.Function) && C.read(N.StmtID) &&
+                 C.read(N.Label) && N.Function < Functions.size() &&
+                 define(Nodes, ID, N);
+      break;
+    }
+    case ESGTraceFormat::FactRecord: {
+      uint8_t IsZero;
+      llvm::StringRef Label;
+      Complete = C.read(ID) && C.read(IsZero) && C.read(Label) &&
+                 define(Facts, ID, Fact{IsZero != 0, Label});
+      break;
+    }
+    case ESGTraceFormat::IntraEdgeRecord:
+    case ESGTraceFormat::InterEdgeRecord: {
+      uint32_t SrcNode;
+      uint32_t SrcFact;
+      uint32_t DstNode;
+      uint32_t DstFact;
+      Complete = C.read(SrcNode) && C.read(SrcFact) && C.read(DstNode) &&
+                 C.read(DstFact) && SrcNode < Nodes.size() &&
+                 DstNode < Nodes.size() && SrcFact < Facts.size() &&
+                 DstFact < Facts.size();
+      NumEdges += Complete;
+      break;
+    }
+    default:
+      break;
+    }
+    if (!Complete) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Ignoring the incomplete or corrupt tail of ESG trace "
+                    << TraceFile << " from offset " << End);
+      break;
+    }
+    End = C.getOffset();
+  }
+  return true;
+}
+
+bool ESGTraceReader::nextEdge(size_t &Offset, Edge &E) const {
+  if (!Trace) {
+    return false;
+  }
+  // load() has verified that all records up to End are complete
+  Cursor C(Trace->getBuffer().substr(0, End), Offset);
+  uint8_t Kind;
+  while (C.read(Kind)) {
+    uint32_t ID;
+    uint32_t Function;
+    uint8_t IsZero;
+    llvm::StringRef S;
+    switch (Kind) {
+    case ESGTraceFormat::FunctionRecord:
+      C.read(ID);
+      C.read(S);
+      break;
+    case ESGTraceFormat::NodeRecord:
+      C.read(ID);
+      C.read(Function);
+      C.read(S);
+      C.read(S);
+      break;
+    case ESGTraceFormat::FactRecord:
+      C.read(ID);
+      C.read(IsZero);
+      C.read(S);
+      break;
+    default:
+      E.InterP = Kind == ESGTraceFormat::InterEdgeRecord;
+      C.read(E.SrcNode);
+      C.read(E.SrcFact);
+      C.read(E.DstNode);
+      C.read(E.DstFact);
+      Offset = C.getOffset();
+      return true;
+    }
+  }
+  Offset = C.getOffset();
+  return false;
+}
+
+std::vector<bool>
+ESGTraceReader::selectFunctions(const std::set<std::string> &Names) const {
+  std::vector<bool> Selected(Functions.size());
+  for (size_t ID = 0; ID < Functions.size(); ++ID) {
+    Selected[ID] = Names.count(Functions[ID].str());
+  }
+  return Selected;
+}
+
+void ESGTraceReader::printAsDot(
+    std::ostream &OS, const std::set<std::string> &SelectedFunctions) const {
+  DOTGraph<uint32_t> G;
+  // creates the DOT node of a fact, which is a lambda node for zero
+  auto MakeFactNode = [this, &G](const Node &N, uint32_t FactID) {
+    const Fact &D = Facts[FactID];
+    std::string FunName = Functions[N.Function].str();
+    if (D.IsZero) {
+      return DOTNode(FunName, "Λ", N.StmtID.str(), 0, false, true);
+    }
+    return DOTNode(FunName, D.Label.str(), N.StmtID.str(),
+                   G.getFactID(FactID), false, true);
+  };
+  // adds the fact node to the fact subgraph of its function
+  auto AddFactNode = [this, &G](const DOTNode &D, uint32_t FactID) {
+    std::string Label = Facts[FactID].Label.str();
+    auto *FSG = G.functions[D.funcName].getOrCreateFactSG(D.factId, Label);
+    FSG->nodes.emplace(D.stmtId, D);
+    return FSG;
+  };
+  foreachEdgeOf(SelectedFunctions, [&](const Edge &E) {
+    const Node &Src = Nodes[E.SrcNode];
+    const Node &Dst = Nodes[E.DstNode];
+    std::string SrcFun = Functions[Src.Function].str();
+    std::string DstFun = Functions[Dst.Function].str();
+    DOTNode N1(SrcFun, Src.Label.str(), Src.StmtID.str());
+    DOTNode N2(DstFun, Dst.Label.str(), Dst.StmtID.str());
+    DOTNode D1 = MakeFactNode(Src, E.SrcFact);
+    DOTNode D2 = MakeFactNode(Dst, E.DstFact);
+    bool ZeroD1 = Facts[E.SrcFact].IsZero;
+    bool ZeroD2 = Facts[E.DstFact].IsZero;
+    for (const auto *N : {&N1, &N2}) {
+      auto &FG = G.functions[N->funcName];
+      FG.id = N->funcName;
+      FG.stmts.insert(*N);
+    }
+    if (!E.InterP) {
+      auto &FG = G.functions[SrcFun];
+      FG.intraCFEdges.emplace(N1, N2);
+      // the intra-procedural edges of zero are generated automatically
+      if (ZeroD2) {
+        return;
+      }
+      if (!ZeroD1) {
+        auto *D1FSG = AddFactNode(D1, E.SrcFact);
+        if (D1.factId == D2.factId) {
+          D1FSG->nodes.emplace(D2.stmtId, D2);
+          D1FSG->edges.emplace(D1, D2, true);
+          return;
+        }
+      }
+      AddFactNode(D2, E.DstFact);
+      FG.crossFactEdges.emplace(D1, D2, true);
+      return;
+    }
+    // recursive calls and returns remain within their function subgraph
+    if (SrcFun == DstFun) {
+      G.functions[SrcFun].intraCFEdges.emplace(N1, N2);
+    } else {
+      G.interCFEdges.emplace(N1, N2);
+    }
+    if (!ZeroD1) {
+      AddFactNode(D1, E.SrcFact);
+    }
+    if (!ZeroD2) {
+      AddFactNode(D2, E.DstFact);
+    }
+    if (ZeroD1 && ZeroD2) {
+      if (SrcFun != DstFun) {
+        G.interLambdaEdges.emplace(D1, D2, true, "AllBottom", "BOT");
+      }
+    } else {
+      G.interFactEdges.emplace(D1, D2, true);
+    }
+  });
+  OS << G;
+}
+
+nlohmann::json ESGTraceReader::getAsJson(
+    const std::set<std::string> &SelectedFunctions) const {
+  nlohmann::json J;
+  J["edges"] = nlohmann::json::array();
+  std::set<uint32_t> UsedNodes;
+  std::set<uint32_t> UsedFacts;
+  foreachEdgeOf(SelectedFunctions, [&](const Edge &E) {
+    J["edges"].push_back({{"inter", E.InterP},
+                          {"source", {E.SrcNode, E.SrcFact}},
+                          {"target", {E.DstNode, E.DstFact}}});
+    UsedNodes.insert({E.SrcNode, E.DstNode});
+    UsedFacts.insert({E.SrcFact, E.DstFact});
+  });
+  // nodes and facts are referred to by their IDs
+  J["nodes"] = nlohmann::json::object();
+  for (uint32_t ID : UsedNodes) {
+    const Node &N = Nodes[ID];
+    J["nodes"][std::to_string(ID)] = {
+        {"function", Functions[N.Function].str()},
+        {"statement", N.StmtID.str()},
+        {"label", N.Label.str()}};
+  }
+  J["facts"] = nlohmann::json::object();
+  for (uint32_t ID : UsedFacts) {
+    J["facts"][std::to_string(ID)] = {{"zero", Facts[ID].IsZero},
+                                      {"label", Facts[ID].Label.str()}};
+  }
+  return J;
+}
+
+} // namespace psr
@@ -7,7 +7,10 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <ostream>
+#include <thread>
+#include <utility>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 
@@ -16,10 +19,45 @@ using namespace psr;
 
 namespace psr {
 
+std::string toString(const PathEdgeWorklistKind &Kind) {
+  switch (Kind) {
+  case PathEdgeWorklistKind::Recursive:
+    return "Recursive";
+  case PathEdgeWorklistKind::FIFO:
+    return "FIFO";
+  case PathEdgeWorklistKind::LIFO:
+    return "LIFO";
+  case PathEdgeWorklistKind::ReversePostOrder:
+    return "ReversePostOrder";
+  }
+  return "Recursive";
+}
+
+PathEdgeWorklistKind toPathEdgeWorklistKind(const std::string &S) {
+  if (S == "FIFO" || S == "fifo") {
+    return PathEdgeWorklistKind::FIFO;
+  }
+  if (S == "LIFO" || S == "lifo") {
+    return PathEdgeWorklistKind::LIFO;
+  }
+  if (S == "ReversePostOrder" || S == "rpo") {
+    return PathEdgeWorklistKind::ReversePostOrder;
+  }
+  return PathEdgeWorklistKind::Recursive;
+}
+
+ostream &operator<<(ostream &OS, const PathEdgeWorklistKind &Kind) {
+  return OS << toString(Kind);
+}
+
 IFDSIDESolverConfig::IFDSIDESolverConfig() {
   setFlag(
       Options, SolverConfigOptions::EmitESG,
       PhasarConfig::getPhasarConfig().VariablesMap().count("emit-esg-as-dot"));
+  if (PhasarConfig::getPhasarConfig().VariablesMap().count(
+          "right-to-ludicrous-speed")) {
+    NumThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
 }
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options)
     : Options(Options) {}
@@ -42,6 +80,32 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::denseJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::DenseJumpFunctions);
+}
+bool IFDSIDESolverConfig::memoizeEdgeFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::MemoizeEdgeFunctions);
+}
+bool IFDSIDESolverConfig::sparsePropagation() const {
+  return hasFlag(Options, SolverConfigOptions::SparsePropagation);
+}
+bool IFDSIDESolverConfig::batchFlowFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::BatchFlowFunctions);
+}
+PathEdgeWorklistKind IFDSIDESolverConfig::pathEdgeWorklistKind() const {
+  return WorklistKind;
+}
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
+size_t IFDSIDESolverConfig::flowEdgeFunctionCacheCapacity() const {
+  return FlowEdgeFunctionCacheCapacity;
+}
+size_t IFDSIDESolverConfig::maxEdgeFunctionChainLength() const {
+  return MaxEdgeFunctionChainLength;
+}
+size_t IFDSIDESolverConfig::memoryBudget() const { return MemoryBudget; }
+const std::string &IFDSIDESolverConfig::esgTraceFile() const {
+  return ESGTraceFile;
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -61,6 +125,36 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setDenseJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::DenseJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setMemoizeEdgeFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::MemoizeEdgeFunctions, Set);
+}
+void IFDSIDESolverConfig::setSparsePropagation(bool Set) {
+  setFlag(Options, SolverConfigOptions::SparsePropagation, Set);
+}
+void IFDSIDESolverConfig::setBatchFlowFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::BatchFlowFunctions, Set);
+}
+void IFDSIDESolverConfig::setPathEdgeWorklistKind(PathEdgeWorklistKind Kind) {
+  WorklistKind = Kind;
+}
+void IFDSIDESolverConfig::setNumThreads(unsigned N) {
+  NumThreads = std::max(1u, N);
+}
+void IFDSIDESolverConfig::setFlowEdgeFunctionCacheCapacity(size_t Capacity) {
+  FlowEdgeFunctionCacheCapacity = Capacity;
+}
+void IFDSIDESolverConfig::setMaxEdgeFunctionChainLength(size_t Length) {
+  MaxEdgeFunctionChainLength = Length;
+}
+void IFDSIDESolverConfig::setMemoryBudget(size_t Bytes) {
+  MemoryBudget = Bytes;
+}
+void IFDSIDESolverConfig::setESGTraceFile(std::string File) {
+  ESGTraceFile = std::move(File);
+}
 
 ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
   return OS << "IFDSIDESolverConfig:\n"
@@ -71,7 +165,19 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tdenseJumpFunctions: " << SC.denseJumpFunctions() << "\n"
+            << "\tmemoizeEdgeFunctions: " << SC.memoizeEdgeFunctions() << "\n"
+            << "\tsparsePropagation: " << SC.sparsePropagation() << "\n"
+            << "\tbatchFlowFunctions: " << SC.batchFlowFunctions() << "\n"
+            << "\tpathEdgeWorklistKind: " << SC.pathEdgeWorklistKind() << "\n"
+            << "\tnumThreads: " << SC.numThreads() << "\n"
+            << "\tflowEdgeFunctionCacheCapacity: "
+            << SC.flowEdgeFunctionCacheCapacity() << "\n"
+            << "\tmaxEdgeFunctionChainLength: "
+            << SC.maxEdgeFunctionChainLength() << "\n"
+            << "\tmemoryBudget: " << SC.memoryBudget() << "\n"
+            << "\tesgTraceFile: " << SC.esgTraceFile();
 }
 
 } // namespace psr
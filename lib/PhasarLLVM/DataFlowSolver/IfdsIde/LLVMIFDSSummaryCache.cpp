@@ -0,0 +1,347 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <utility>
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Casting.h"
+#include "llvm/Support/MD5.h"
+
+#include "boost/filesystem.hpp"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMIFDSSummaryCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+const char Magic[8] = {'P', 'S', 'R', 'S', 'U', 'M', 'M', '\0'};
+
+template <typename T> void write(std::ostream &OS, T Value) {
+  OS.write(reinterpret_cast<const char *>(&Value), sizeof(T));
+}
+
+void write(std::ostream &OS, const std::string &S) {
+  write<uint32_t>(OS, S.size());
+  OS.write(S.data(), S.size());
+}
+
+template <typename T> bool read(std::istream &IS, T &Value) {
+  return static_cast<bool>(
+      IS.read(reinterpret_cast<char *>(&Value), sizeof(T)));
+}
+
+/// Returns the number of bytes between the read position of IS and End.
+uint64_t remaining(std::istream &IS, std::streamoff End) {
+  std::streamoff Pos = IS.tellg();
+  return Pos < 0 || Pos > End ? 0 : End - Pos;
+}
+
+bool read(std::istream &IS, std::string &S, std::streamoff End) {
+  uint32_t Size;
+  if (!read(IS, Size) || Size > remaining(IS, End)) {
+    return false;
+  }
+  S.resize(Size);
+  return static_cast<bool>(IS.read(S.data(), Size));
+}
+
+} // anonymous namespace
+
+bool LLVMIFDSSummaryCache::isStdLibraryFunction(const llvm::Function *F) {
+  std::string Demangled = cxxDemangle(F->getName().str());
+  llvm::StringRef Name(Demangled);
+  return Name.startswith("std::") || Name.startswith("__gnu_cxx::");
+}
+
+LLVMIFDSSummaryCache::LLVMIFDSSummaryCache(
+    std::string AnalysisID, std::string CacheFile,
+    std::function<bool(const llvm::Function *)> IsLibraryFunction)
+    : AnalysisID(std::move(AnalysisID)), CacheFile(std::move(CacheFile)),
+      IsLibraryFunction(std::move(IsLibraryFunction)) {
+  if (boost::filesystem::exists(this->CacheFile)) {
+    load();
+  }
+}
+
+bool LLVMIFDSSummaryCache::isCacheable(f_t Fun) {
+  return !Fun->isDeclaration() && IsLibraryFunction(Fun) &&
+         computeHash(Fun).has_value();
+}
+
+std::optional<uint64_t> LLVMIFDSSummaryCache::computeHash(f_t Fun) {
+  auto Search = Hashes.find(Fun);
+  if (Search != Hashes.end()) {
+    return Search->second;
+  }
+  std::optional<uint64_t> &Hash = Hashes[Fun];
+  // the summary depends on all functions that Fun (transitively) calls
+  std::set<std::string> Callees;
+  std::vector<const llvm::Function *> WorkList = {Fun};
+  std::set<const llvm::Function *> Visited = {Fun};
+  llvm::MD5 MD5;
+  while (!WorkList.empty()) {
+    const llvm::Function *F = WorkList.back();
+    WorkList.pop_back();
+    if (F->isDeclaration()) {
+      // declarations are identified by their name only
+      Callees.insert(F->getName().str());
+      continue;
+    }
+    Callees.insert(F->getName().str() + "#" +
+                   std::to_string(computeFunctionHash(F)));
+    for (const auto &I : llvm::instructions(F)) {
+      if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        const llvm::Function *Callee = Call->getCalledFunction();
+        if (!Callee) {
+          return Hash;
+        }
+        if (Visited.insert(Callee).second) {
+          WorkList.push_back(Callee);
+        }
+      }
+    }
+  }
+  MD5.update(Fun->getName());
+  for (const auto &Callee : Callees) {
+    MD5.update(Callee);
+  }
+  llvm::MD5::MD5Result Result;
+  MD5.final(Result);
+  Hash = Result.low();
+  return Hash;
+}
+
+const std::vector<const llvm::Instruction *> &
+LLVMIFDSSummaryCache::getInstructions(f_t Fun) {
+  auto [It, Inserted] = Instructions.try_emplace(Fun);
+  if (Inserted) {
+    for (const auto &I : llvm::instructions(Fun)) {
+      It->second.push_back(&I);
+    }
+  }
+  return It->second;
+}
+
+std::optional<LLVMIFDSSummaryCache::PersistedFact>
+LLVMIFDSSummaryCache::persist(f_t Fun, d_t Fact) {
+  PersistedFact Result;
+  if (LLVMZeroValue::getInstance()->isLLVMZeroValue(Fact)) {
+    Result.FactKind = PersistedFact::Zero;
+  } else if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(Fact)) {
+    if (Arg->getParent() != Fun) {
+      return std::nullopt;
+    }
+    Result.FactKind = PersistedFact::Argument;
+    Result.Index = Arg->getArgNo();
+  } else if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(Fact)) {
+    if (Inst->getFunction() != Fun) {
+      return std::nullopt;
+    }
+    const auto &Insts = getInstructions(Fun);
+    Result.FactKind = PersistedFact::Instruction;
+    Result.Index = std::find(Insts.begin(), Insts.end(), Inst) - Insts.begin();
+  } else if (const auto *Global = llvm::dyn_cast<llvm::GlobalValue>(Fact)) {
+    if (!Global->hasName() || Global->hasLocalLinkage()) {
+      return std::nullopt;
+    }
+    Result.FactKind = PersistedFact::Global;
+    Result.Name = Global->getName().str();
+  } else {
+    return std::nullopt;
+  }
+  return Result;
+}
+
+LLVMIFDSSummaryCache::d_t
+LLVMIFDSSummaryCache::restore(f_t Fun, const PersistedFact &Fact) {
+  switch (Fact.FactKind) {
+  case PersistedFact::Zero:
+    return LLVMZeroValue::getInstance();
+  case PersistedFact::Argument:
+    return Fact.Index < Fun->arg_size() ? Fun->arg_begin() + Fact.Index
+                                        : nullptr;
+  case PersistedFact::Instruction: {
+    const auto &Insts = getInstructions(Fun);
+    return Fact.Index < Insts.size() ? Insts[Fact.Index] : nullptr;
+  }
+  case PersistedFact::Global:
+    return Fun->getParent()->getNamedValue(Fact.Name);
+  default:
+    return nullptr;
+  }
+}
+
+std::optional<LLVMIFDSSummaryCache::SummaryTy>
+LLVMIFDSSummaryCache::lookup(f_t Fun, d_t D1) {
+  auto Hash = computeHash(Fun);
+  auto PersistedD1 = persist(Fun, D1);
+  if (!Hash || !PersistedD1) {
+    return std::nullopt;
+  }
+  auto Search = Summaries.find({AnalysisID, *Hash, *PersistedD1});
+  if (Search == Summaries.end()) {
+    return std::nullopt;
+  }
+  const auto &Insts = getInstructions(Fun);
+  SummaryTy Summary;
+  for (const auto &[ExitIdx, ExitFacts] : Search->second) {
+    if (ExitIdx >= Insts.size()) {
+      return std::nullopt;
+    }
+    auto &Facts = Summary[Insts[ExitIdx]];
+    for (const auto &Fact : ExitFacts) {
+      d_t Restored = restore(Fun, Fact);
+      if (!Restored) {
+        return std::nullopt;
+      }
+      Facts.insert(Restored);
+    }
+  }
+  ++NumHits;
+  return Summary;
+}
+
+bool LLVMIFDSSummaryCache::insert(f_t Fun, d_t D1, const SummaryTy &Summary) {
+  auto Hash = computeHash(Fun);
+  auto PersistedD1 = persist(Fun, D1);
+  if (!Hash || !PersistedD1) {
+    return false;
+  }
+  PersistedSummary Persisted;
+  for (const auto &[ExitStmt, ExitFacts] : Summary) {
+    auto PersistedExit = persist(Fun, ExitStmt);
+    if (!PersistedExit) {
+      return false;
+    }
+    auto &Facts = Persisted[PersistedExit->Index];
+    for (d_t Fact : ExitFacts) {
+      auto PersistedFact = persist(Fun, Fact);
+      if (!PersistedFact) {
+        return false;
+      }
+      Facts.push_back(std::move(*PersistedFact));
+    }
+  }
+  Summaries[{AnalysisID, *Hash, *PersistedD1}] = std::move(Persisted);
+  return true;
+}
+
+bool LLVMIFDSSummaryCache::load() {
+  std::ifstream IS(CacheFile, std::ios::binary | std::ios::ate);
+  // sizes read from the file are checked against the bytes left in it
+  // before anything is allocated for them
+  std::streamoff End = IS.tellg();
+  IS.seekg(0);
+  char FileMagic[sizeof(Magic)];
+  uint32_t Version;
+  if (!IS.read(FileMagic, sizeof(FileMagic)) ||
+      !std::equal(Magic, Magic + sizeof(Magic), FileMagic) ||
+      !read(IS, Version) || Version != FormatVersion) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                  << "Ignoring summary cache with unsupported format: "
+                  << CacheFile);
+    return false;
+  }
+  // the smallest encoding of a fact: its kind, position and an empty name
+  constexpr uint64_t MinFactSize =
+      sizeof(PersistedFact::FactKind) + sizeof(PersistedFact::Index) +
+      sizeof(uint32_t);
+  auto ReadFact = [&IS, End](PersistedFact &Fact) {
+    return read(IS, Fact.FactKind) && read(IS, Fact.Index) &&
+           read(IS, Fact.Name, End);
+  };
+  auto ReadSummary = [&IS, End, &ReadFact](PersistedSummary &Summary) {
+    uint32_t NumExits;
+    if (!read(IS, NumExits)) {
+      return false;
+    }
+    for (uint32_t E = 0; E < NumExits; ++E) {
+      uint32_t ExitIdx;
+      uint32_t NumFacts;
+      if (!read(IS, ExitIdx) || !read(IS, NumFacts) ||
+          NumFacts > remaining(IS, End) / MinFactSize) {
+        return false;
+      }
+      auto &Facts = Summary[ExitIdx];
+      Facts.resize(NumFacts);
+      for (auto &Fact : Facts) {
+        if (!ReadFact(Fact)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  std::map<KeyTy, PersistedSummary> Loaded;
+  uint64_t NumSummaries = 0;
+  bool Valid = read(IS, NumSummaries);
+  for (uint64_t S = 0; Valid && S < NumSummaries; ++S) {
+    std::string ID;
+    uint64_t Hash;
+    PersistedFact D1;
+    Valid = read(IS, ID, End) && read(IS, Hash) && ReadFact(D1) &&
+            ReadSummary(Loaded[{ID, Hash, D1}]);
+  }
+  if (!Valid) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                  << "Ignoring corrupt summary cache: " << CacheFile);
+    return false;
+  }
+  // summaries that have been computed meanwhile take precedence
+  Summaries.merge(Loaded);
+  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                << "Loaded " << NumSummaries << " summaries from "
+                << CacheFile);
+  return true;
+}
+
+bool LLVMIFDSSummaryCache::store() const {
+  std::ofstream OS(CacheFile, std::ios::binary | std::ios::trunc);
+  OS.write(Magic, sizeof(Magic));
+  write(OS, FormatVersion);
+  auto WriteFact = [&OS](const PersistedFact &Fact) {
+    write(OS, Fact.FactKind);
+    write(OS, Fact.Index);
+    write(OS, Fact.Name);
+  };
+  write<uint64_t>(OS, Summaries.size());
+  for (const auto &[Key, Summary] : Summaries) {
+    const auto &[ID, Hash, D1] = Key;
+    write(OS, ID);
+    write(OS, Hash);
+    WriteFact(D1);
+    write<uint32_t>(OS, Summary.size());
+    for (const auto &[ExitIdx, Facts] : Summary) {
+      write(OS, ExitIdx);
+      write<uint32_t>(OS, Facts.size());
+      for (const auto &Fact : Facts) {
+        WriteFact(Fact);
+      }
+    }
+  }
+  return static_cast<bool>(OS);
+}
+
+} // namespace psr
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <unordered_set>
+
+#include "llvm/IR/Constant.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/Support/Casting.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMProgramVersionMapping.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+static const llvm::Function *lookupFunction(const ProjectIRDB &IRDB,
+                                            const std::string &Name) {
+  if (const auto *F = IRDB.getFunctionDefinition(Name)) {
+    return F;
+  }
+  return IRDB.getFunction(Name);
+}
+
+// constant expressions have no identity across versions
+static bool isComparedPointer(const llvm::Value *V) {
+  return isInterestingPointer(V) &&
+         (!llvm::isa<llvm::Constant>(V) || llvm::isa<llvm::GlobalValue>(V));
+}
+
+LLVMProgramVersionMapping::LLVMProgramVersionMapping(
+    const ProjectIRDB &PreviousIRDB, const ProjectIRDB &IRDB)
+    : IRDB(IRDB) {
+  for (const auto *PreviousF : PreviousIRDB.getAllFunctions()) {
+    const auto *F = lookupFunction(IRDB, PreviousF->getName().str());
+    if (!F || F->isDeclaration() != PreviousF->isDeclaration() ||
+        computeFunctionHash(F) != computeFunctionHash(PreviousF)) {
+      ChangedFunctions.insert(PreviousF->getName().str());
+      continue;
+    }
+    Functions[PreviousF] = F;
+    // unchanged functions have the same arguments and instructions in the
+    // same order
+    for (auto PreviousArg = PreviousF->arg_begin(), Arg = F->arg_begin();
+         PreviousArg != PreviousF->arg_end(); ++PreviousArg, ++Arg) {
+      Values[&*PreviousArg] = &*Arg;
+    }
+    for (auto PreviousInst = llvm::inst_begin(PreviousF),
+              Inst = llvm::inst_begin(F);
+         PreviousInst != llvm::inst_end(PreviousF); ++PreviousInst, ++Inst) {
+      Values[&*PreviousInst] = &*Inst;
+    }
+  }
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (!PreviousIRDB.getFunction(F->getName().str())) {
+      ChangedFunctions.insert(F->getName().str());
+    }
+  }
+}
+
+LLVMProgramVersionMapping::LLVMProgramVersionMapping(
+    const ProjectIRDB &PreviousIRDB, const ProjectIRDB &IRDB,
+    LLVMPointsToInfo &PreviousPT, LLVMPointsToInfo &PT)
+    : LLVMProgramVersionMapping(PreviousIRDB, IRDB) {
+  ComparesPointsToInfo = true;
+  // the aliases of a function's pointers may lie in any function, so all
+  // values have to be mapped before the points-to sets are compared
+  for (auto It = Functions.begin(); It != Functions.end();) {
+    if (hasSamePointsToSets(It->first, PreviousPT, PT)) {
+      ++It;
+    } else {
+      ChangedFunctions.insert(It->first->getName().str());
+      It = Functions.erase(It);
+    }
+  }
+}
+
+std::optional<const llvm::Value *>
+LLVMProgramVersionMapping::mapPointer(const llvm::Value *Previous) const {
+  // changed callees are handled by the solver, so functions are mapped by
+  // their names only
+  if (const auto *F = llvm::dyn_cast<llvm::Function>(Previous)) {
+    if (const auto *NewF = lookupFunction(IRDB, F->getName().str())) {
+      return NewF;
+    }
+    return std::nullopt;
+  }
+  return mapFact(Previous);
+}
+
+bool LLVMProgramVersionMapping::hasSamePointsToSets(
+    const llvm::Function *PreviousF, LLVMPointsToInfo &PreviousPT,
+    LLVMPointsToInfo &PT) const {
+  std::unordered_set<const llvm::Value *> Pointers;
+  for (const auto &Arg : PreviousF->args()) {
+    Pointers.insert(&Arg);
+  }
+  for (const auto &Inst : llvm::instructions(PreviousF)) {
+    Pointers.insert(&Inst);
+    Pointers.insert(Inst.op_begin(), Inst.op_end());
+  }
+  for (const auto *PreviousPointer : Pointers) {
+    if (!isComparedPointer(PreviousPointer)) {
+      continue;
+    }
+    auto Pointer = mapPointer(PreviousPointer);
+    if (!Pointer) {
+      return false;
+    }
+    std::unordered_set<const llvm::Value *> Expected;
+    for (const auto *PreviousAlias :
+         *PreviousPT.getPointsToSet(PreviousPointer)) {
+      if (!isComparedPointer(PreviousAlias)) {
+        continue;
+      }
+      auto Alias = mapPointer(PreviousAlias);
+      if (!Alias) {
+        return false;
+      }
+      Expected.insert(*Alias);
+    }
+    size_t NumAliases = 0;
+    for (const auto *Alias : *PT.getPointsToSet(*Pointer)) {
+      if (!isComparedPointer(Alias)) {
+        continue;
+      }
+      if (!Expected.count(Alias)) {
+        return false;
+      }
+      ++NumAliases;
+    }
+    if (NumAliases != Expected.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<LLVMProgramVersionMapping::f_t>
+LLVMProgramVersionMapping::mapFunction(f_t Previous) const {
+  auto Search = Functions.find(Previous);
+  if (Search != Functions.end()) {
+    return Search->second;
+  }
+  return std::nullopt;
+}
+
+std::optional<LLVMProgramVersionMapping::n_t>
+LLVMProgramVersionMapping::mapStatement(n_t Previous) const {
+  auto Search = Values.find(Previous);
+  if (Search != Values.end()) {
+    return llvm::cast<llvm::Instruction>(Search->second);
+  }
+  return std::nullopt;
+}
+
+std::optional<LLVMProgramVersionMapping::d_t>
+LLVMProgramVersionMapping::mapFact(d_t Previous) const {
+  auto Search = Values.find(Previous);
+  if (Search != Values.end()) {
+    return Search->second;
+  }
+  if (const auto *F = llvm::dyn_cast<llvm::Function>(Previous)) {
+    return mapFunction(F);
+  }
+  if (const auto *G = llvm::dyn_cast<llvm::GlobalVariable>(Previous)) {
+    if (const auto *NewG =
+            IRDB.getGlobalVariableDefinition(G->getName().str())) {
+      return NewG;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace psr
@@ -9,8 +9,11 @@
 
 // #include <functional>
 #include <limits>
+#include <typeinfo>
 #include <utility>
 
+#include "boost/functional/hash.hpp"
+
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
@@ -32,6 +35,7 @@
 #include "phasar/Utils/LLVMIRToSrc.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PoolAllocator.h"
 
 using namespace std;
 using namespace psr;
@@ -69,8 +73,8 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
     IDELinearConstantAnalysis::n_t Curr, IDELinearConstantAnalysis::n_t Succ) {
   if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
     if (Alloca->getAllocatedType()->isIntegerTy()) {
-      return make_shared<Gen<IDELinearConstantAnalysis::d_t>>(Alloca,
-                                                              getZeroValue());
+      return makePooledShared<Gen<IDELinearConstantAnalysis::d_t>>(
+          Alloca, getZeroValue());
     }
   }
   // Check store instructions. Store instructions override previous value
@@ -80,14 +84,16 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
     IDELinearConstantAnalysis::d_t ValueOp = Store->getValueOperand();
     // Case I: Storing a constant integer.
     if (llvm::isa<llvm::ConstantInt>(ValueOp)) {
-      return make_shared<StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
+      return makePooledShared<
+          StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
           Store, [this](IDELinearConstantAnalysis::d_t Source) {
             return Source == getZeroValue();
           });
     }
     // Case II: Storing an integer typed value.
     if (ValueOp->getType()->isIntegerTy()) {
-      return make_shared<StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
+      return makePooledShared<
+          StrongUpdateStore<IDELinearConstantAnalysis::d_t>>(
           Store, [Store](IDELinearConstantAnalysis::d_t Source) {
             return Source == Store->getValueOperand();
           });
@@ -97,7 +103,7 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
   if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
     // only consider i32 load
     if (Load->getPointerOperandType()->getPointerElementType()->isIntegerTy()) {
-      return make_shared<GenIf<IDELinearConstantAnalysis::d_t>>(
+      return makePooledShared<GenIf<IDELinearConstantAnalysis::d_t>>(
           Load, [Load](IDELinearConstantAnalysis::d_t Source) {
             return Source == Load->getPointerOperand();
           });
@@ -107,7 +113,7 @@ IDELinearConstantAnalysis::getNormalFlowFunction(
   if (llvm::isa<llvm::BinaryOperator>(Curr)) {
     auto *Lop = Curr->getOperand(0);
     auto *Rop = Curr->getOperand(1);
-    return make_shared<GenIf<IDELinearConstantAnalysis::d_t>>(
+    return makePooledShared<GenIf<IDELinearConstantAnalysis::d_t>>(
         Curr, [this, Lop, Rop](IDELinearConstantAnalysis::d_t Source) {
           return (Lop == Source && llvm::isa<llvm::ConstantInt>(Rop)) ||
                  (Rop == Source && llvm::isa<llvm::ConstantInt>(Lop)) ||
@@ -190,7 +196,7 @@ IDELinearConstantAnalysis::getCallFlowFunction(
         return Res;
       }
     };
-    return make_shared<LCAFF>(llvm::ImmutableCallSite(CallStmt), DestFun);
+    return makePooledShared<LCAFF>(llvm::ImmutableCallSite(CallStmt), DestFun);
   }
   // Pass everything else as identity
   return Identity<IDELinearConstantAnalysis::d_t>::getInstance();
@@ -231,10 +237,10 @@ IDELinearConstantAnalysis::getRetFlowFunction(
         return Res;
       }
     };
-    return make_shared<LCAFF>(CallSite, ReturnValue);
+    return makePooledShared<LCAFF>(CallSite, ReturnValue);
   }
   // All other facts except GlobalVariables are killed at this point
-  return make_shared<KillIf<IDELinearConstantAnalysis::d_t>>(
+  return makePooledShared<KillIf<IDELinearConstantAnalysis::d_t>>(
       [](IDELinearConstantAnalysis::d_t Source) {
         return !llvm::isa<llvm::GlobalVariable>(Source);
       });
@@ -246,7 +252,7 @@ IDELinearConstantAnalysis::getCallToRetFlowFunction(
     IDELinearConstantAnalysis::n_t RetSite, set<f_t> Callees) {
   for (const auto *Callee : Callees) {
     if (!ICF->getStartPointsOf(Callee).empty()) {
-      return make_shared<KillIf<IDELinearConstantAnalysis::d_t>>(
+      return makePooledShared<KillIf<IDELinearConstantAnalysis::d_t>>(
           [this](IDELinearConstantAnalysis::d_t Source) {
             return !isZeroValue(Source) &&
                    llvm::isa<llvm::GlobalVariable>(Source);
@@ -337,7 +343,7 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
     const auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(CurrNode);
     const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(GV->getInitializer());
     auto IntConst = CI->getSExtValue();
-    return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+    return makePooledShared<IDELinearConstantAnalysis::GenConstant>(IntConst);
   }
 
   // ALL_BOTTOM for zero value
@@ -345,7 +351,7 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
       (llvm::isa<llvm::AllocaInst>(Curr) && isZeroValue(CurrNode))) {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Case: Zero value.");
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+    return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
         IDELinearConstantAnalysis::BOTTOM);
   }
 
@@ -361,14 +367,15 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
         const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(ValueOperand);
         auto IntConst = CI->getSExtValue();
-        return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+        return makePooledShared<IDELinearConstantAnalysis::GenConstant>(
+            IntConst);
       }
       // Case II: Storing an integer typed value.
       if (CurrNode != SuccNode && ValueOperand->getType()->isIntegerTy()) {
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Case: Storing an integer typed value.");
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-        return make_shared<IDELinearConstantAnalysis::LCAIdentity>();
+        return makePooledShared<IDELinearConstantAnalysis::LCAIdentity>();
       }
     }
   }
@@ -379,7 +386,7 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                     << "Case: Loading an integer typed value.");
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-      return make_shared<IDELinearConstantAnalysis::LCAIdentity>();
+      return makePooledShared<IDELinearConstantAnalysis::LCAIdentity>();
     }
   }
 
@@ -393,11 +400,11 @@ IDELinearConstantAnalysis::getNormalEdgeFunction(
     // For non linear constant computation we propagate bottom
     if (CurrNode == ZeroValue && !llvm::isa<llvm::ConstantInt>(Lop) &&
         !llvm::isa<llvm::ConstantInt>(Rop)) {
-      return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+      return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
           IDELinearConstantAnalysis::BOTTOM);
     } else {
-      return make_shared<IDELinearConstantAnalysis::BinOp>(OP, Lop, Rop,
-                                                           CurrNode);
+      return makePooledShared<IDELinearConstantAnalysis::BinOp>(OP, Lop, Rop,
+                                                                CurrNode);
     }
   }
 
@@ -419,7 +426,8 @@ IDELinearConstantAnalysis::getCallEdgeFunction(
       const auto *Actual = CS.getArgOperand(getFunctionArgumentNr(A));
       if (const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(Actual)) {
         auto IntConst = CI->getSExtValue();
-        return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+        return makePooledShared<IDELinearConstantAnalysis::GenConstant>(
+            IntConst);
       }
     }
   }
@@ -440,7 +448,7 @@ IDELinearConstantAnalysis::getReturnEdgeFunction(
     auto *ReturnValue = Return->getReturnValue();
     if (auto *CI = llvm::dyn_cast<llvm::ConstantInt>(ReturnValue)) {
       auto IntConst = CI->getSExtValue();
-      return make_shared<IDELinearConstantAnalysis::GenConstant>(IntConst);
+      return makePooledShared<IDELinearConstantAnalysis::GenConstant>(IntConst);
     }
   }
   return EdgeIdentity<IDELinearConstantAnalysis::l_t>::getInstance();
@@ -489,7 +497,7 @@ IDELinearConstantAnalysis::join(IDELinearConstantAnalysis::l_t Lhs,
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
 IDELinearConstantAnalysis::allTopFunction() {
-  return make_shared<AllTop<IDELinearConstantAnalysis::l_t>>(TOP);
+  return makePooledShared<AllTop<IDELinearConstantAnalysis::l_t>>(TOP);
 }
 
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
@@ -520,7 +528,7 @@ IDELinearConstantAnalysis::LCAEdgeFunctionComposer::joinWith(
           OtherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+  return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -549,7 +557,7 @@ IDELinearConstantAnalysis::GenConstant::composeWith(
   if (auto *LSVI = dynamic_cast<LCAIdentity *>(SecondFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
+  return makePooledShared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
       this->shared_from_this(), SecondFunction);
 }
 
@@ -564,7 +572,7 @@ IDELinearConstantAnalysis::GenConstant::joinWith(
           OtherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+  return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -577,6 +585,12 @@ bool IDELinearConstantAnalysis::GenConstant::equal_to(
   return this == Other.get();
 }
 
+size_t IDELinearConstantAnalysis::GenConstant::hash() const {
+  size_t Seed = typeid(GenConstant).hash_code();
+  boost::hash_combine(Seed, IntConst);
+  return Seed;
+}
+
 void IDELinearConstantAnalysis::GenConstant::print(ostream &OS,
                                                    bool IsForDebug) const {
   OS << IntConst << " (EF:" << GenConstant_Id << ')';
@@ -608,7 +622,7 @@ IDELinearConstantAnalysis::LCAIdentity::joinWith(
           OtherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+  return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -674,7 +688,7 @@ IDELinearConstantAnalysis::BinOp::composeWith(
           SecondFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
+  return makePooledShared<IDELinearConstantAnalysis::LCAEdgeFunctionComposer>(
       this->shared_from_this(), SecondFunction);
 }
 
@@ -689,7 +703,7 @@ IDELinearConstantAnalysis::BinOp::joinWith(
           OtherFunction.get())) {
     return this->shared_from_this();
   }
-  return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+  return makePooledShared<AllBottom<IDELinearConstantAnalysis::l_t>>(
       IDELinearConstantAnalysis::BOTTOM);
 }
 
@@ -831,16 +845,22 @@ void IDELinearConstantAnalysis::emitTextReport(
       OS << "\nFunction: " << FName << "\n----------"
          << std::string(FName.size(), '-') << '\n';
       for (const auto *Stmt : ICF->getAllInstructionsOf(F)) {
-        auto Results = SR.resultsAt(Stmt, true);
-        stripBottomResults(Results);
-        if (!Results.empty()) {
-          OS << "At IR statement: " << NtoString(Stmt) << '\n';
-          for (auto Res : Results) {
-            if (Res.second != IDELinearConstantAnalysis::BOTTOM) {
-              OS << "   Fact: " << DtoString(Res.first)
-                 << "\n  Value: " << LtoString(Res.second) << '\n';
-            }
-          }
+        bool HasResults = false;
+        SR.foreachResultAt(
+            Stmt,
+            [&](d_t Fact, l_t Value) {
+              if (Value == IDELinearConstantAnalysis::BOTTOM) {
+                return;
+              }
+              if (!HasResults) {
+                HasResults = true;
+                OS << "At IR statement: " << NtoString(Stmt) << '\n';
+              }
+              OS << "   Fact: " << DtoString(Fact)
+                 << "\n  Value: " << LtoString(Value) << '\n';
+            },
+            true);
+        if (HasResults) {
           OS << '\n';
         }
       }
@@ -203,15 +203,19 @@ void IDESecureHeapPropagation::emitTextReport(
     Os << "\nFunction: " << FName << "\n----------"
        << std::string(FName.size(), '-') << '\n';
     for (const auto *Stmt : ICF->getAllInstructionsOf(F)) {
-      auto Results = SR.resultsAt(Stmt, true);
-
-      if (!Results.empty()) {
-        Os << "At IR statement: " << NtoString(Stmt) << '\n';
-        for (auto Res : Results) {
-
-          Os << "   Fact: " << DtoString(Res.first)
-             << "\n  Value: " << LtoString(Res.second) << '\n';
-        }
+      bool HasResults = false;
+      SR.foreachResultAt(
+          Stmt,
+          [&](d_t Fact, l_t Value) {
+            if (!HasResults) {
+              HasResults = true;
+              Os << "At IR statement: " << NtoString(Stmt) << '\n';
+            }
+            Os << "   Fact: " << DtoString(Fact)
+               << "\n  Value: " << LtoString(Value) << '\n';
+          },
+          true);
+      if (HasResults) {
         Os << '\n';
       }
     }
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <utility>
+#include <vector>
 
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Function.h"
@@ -15,6 +16,7 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Value.h"
 
+#include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFlowFunctions.h"
@@ -218,6 +220,19 @@ IFDSConstAnalysis::initialSeeds() {
   return SeedMap;
 }
 
+std::vector<IFDSConstAnalysis::d_t> IFDSConstAnalysis::getFactUniverse() {
+  std::vector<IFDSConstAnalysis::d_t> Universe{getZeroValue()};
+  for (auto *M : IRDB->getAllModules()) {
+    // the facts are memory locations
+    for (const auto *V : getAllValuesOf(*M)) {
+      if (V->getType()->isPointerTy()) {
+        Universe.push_back(V);
+      }
+    }
+  }
+  return Universe;
+}
+
 IFDSConstAnalysis::d_t IFDSConstAnalysis::createZeroValue() const {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "IFDSConstAnalysis::createZeroValue()");
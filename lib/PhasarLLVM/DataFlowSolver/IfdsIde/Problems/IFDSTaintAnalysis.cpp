@@ -8,13 +8,16 @@
  *****************************************************************************/
 
 #include <utility>
+#include <vector>
 
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctionCombinators.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMFlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
@@ -46,39 +49,28 @@ IFDSTaintAnalysis::FlowFunctionPtrType
 IFDSTaintAnalysis::getNormalFlowFunction(IFDSTaintAnalysis::n_t Curr,
                                          IFDSTaintAnalysis::n_t Succ) {
   // If a tainted value is stored, the store location must be tainted too
+  // (the previous taint of the store location is killed otherwise)
   if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr)) {
-    struct TAFF : FlowFunction<IFDSTaintAnalysis::d_t> {
-      const llvm::StoreInst *Store;
-      TAFF(const llvm::StoreInst *S) : Store(S){};
-      set<IFDSTaintAnalysis::d_t>
-      computeTargets(IFDSTaintAnalysis::d_t Source) override {
-        if (Store->getValueOperand() == Source) {
-          return set<IFDSTaintAnalysis::d_t>{Store->getPointerOperand(),
-                                             Source};
-        } else if (Store->getValueOperand() != Source &&
-                   Store->getPointerOperand() == Source) {
-          return {};
-        } else {
-          return {Source};
-        }
-      }
-    };
-    return make_shared<TAFF>(Store);
+    return ff::makeFlowFunction<IFDSTaintAnalysis::d_t>(
+        ff::transfer<IFDSTaintAnalysis::d_t>(Store->getPointerOperand(),
+                                             Store->getValueOperand()));
   }
   // If a tainted value is loaded, the loaded value is of course tainted
   if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr)) {
-    return make_shared<GenIf<IFDSTaintAnalysis::d_t>>(
-        Load, [Load](IFDSTaintAnalysis::d_t Source) {
-          return Source == Load->getPointerOperand();
-        });
+    return ff::makeFlowFunction<IFDSTaintAnalysis::d_t>(
+        ff::genIf<IFDSTaintAnalysis::d_t>(
+            Load, [Load](IFDSTaintAnalysis::d_t Source) {
+              return Source == Load->getPointerOperand();
+            }));
   }
   // Check if an address is computed from a tainted base pointer of an
   // aggregated object
   if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(Curr)) {
-    return make_shared<GenIf<IFDSTaintAnalysis::d_t>>(
-        GEP, [GEP](IFDSTaintAnalysis::d_t Source) {
-          return Source == GEP->getPointerOperand();
-        });
+    return ff::makeFlowFunction<IFDSTaintAnalysis::d_t>(
+        ff::genIf<IFDSTaintAnalysis::d_t>(
+            GEP, [GEP](IFDSTaintAnalysis::d_t Source) {
+              return Source == GEP->getPointerOperand();
+            }));
   }
   // Otherwise we do not care and leave everything as it is
   return Identity<IFDSTaintAnalysis::d_t>::getInstance();
@@ -235,6 +227,22 @@ IFDSTaintAnalysis::getSummaryFlowFunction(IFDSTaintAnalysis::n_t CallStmt,
   }
 }
 
+bool IFDSTaintAnalysis::isRelevant(IFDSTaintAnalysis::n_t Inst,
+                                   IFDSTaintAnalysis::d_t Fact) {
+  // Only stores, loads and address computations affect the facts they use,
+  // all other normal instructions are the identity
+  if (!llvm::isa<llvm::StoreInst>(Inst) && !llvm::isa<llvm::LoadInst>(Inst) &&
+      !llvm::isa<llvm::GetElementPtrInst>(Inst)) {
+    return false;
+  }
+  for (const auto &Operand : Inst->operands()) {
+    if (Operand == Fact) {
+      return true;
+    }
+  }
+  return false;
+}
+
 map<IFDSTaintAnalysis::n_t, set<IFDSTaintAnalysis::d_t>>
 IFDSTaintAnalysis::initialSeeds() {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -259,6 +267,19 @@ IFDSTaintAnalysis::initialSeeds() {
   return SeedMap;
 }
 
+std::vector<IFDSTaintAnalysis::d_t> IFDSTaintAnalysis::getFactUniverse() {
+  std::vector<IFDSTaintAnalysis::d_t> Universe{getZeroValue()};
+  for (auto *M : IRDB->getAllModules()) {
+    auto Values = getAllValuesOf(*M);
+    Universe.insert(Universe.end(), Values.begin(), Values.end());
+  }
+  return Universe;
+}
+
+bool IFDSTaintAnalysis::hasSideEffects(IFDSTaintAnalysis::f_t Fun) {
+  return SourceSinkFunctions.isSink(cxxDemangle(Fun->getName().str()));
+}
+
 IFDSTaintAnalysis::d_t IFDSTaintAnalysis::createZeroValue() const {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "IFDSTaintAnalysis::createZeroValue()");
@@ -307,4 +328,19 @@ void IFDSTaintAnalysis::emitTextReport(
   }
 }
 
+set<IFDSTaintAnalysis::n_t> IFDSTaintAnalysis::getSinkCallSites() const {
+  set<IFDSTaintAnalysis::n_t> SinkCallSites;
+  for (const auto *F : ICF->getAllFunctions()) {
+    for (const auto *CallSite : ICF->getCallsFromWithin(F)) {
+      for (const auto *Callee : ICF->getCalleesOfCallAt(CallSite)) {
+        if (SourceSinkFunctions.isSink(
+                cxxDemangle(Callee->getName().str()))) {
+          SinkCallSites.insert(CallSite);
+        }
+      }
+    }
+  }
+  return SinkCallSites;
+}
+
 } // namespace psr
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include <utility>
+#include <vector>
 
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/Constants.h"
@@ -19,6 +20,7 @@
 
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctionCombinators.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
@@ -174,27 +176,21 @@ IFDSUninitializedVariables::getNormalFlowFunction(
     return make_shared<UVFF>(Store, UndefValueUses, ZeroValue);
   }
   if (const auto *Alloc = llvm::dyn_cast<llvm::AllocaInst>(Curr)) {
-
-    return make_shared<LambdaFlow<IFDSUninitializedVariables::d_t>>(
-        [Alloc, this](IFDSUninitializedVariables::d_t Source)
-            -> set<IFDSUninitializedVariables::d_t> {
-          if (isZeroValue(Source)) {
-            if (Alloc->getAllocatedType()->isIntegerTy() ||
-                Alloc->getAllocatedType()->isFloatingPointTy() ||
-                Alloc->getAllocatedType()->isPointerTy() ||
-                Alloc->getAllocatedType()->isArrayTy()) {
-              //------------------------------------------------------------
-              // Why not generate for structs, but for arrays? (would be
-              // consistent to generate either both or none of them)
-              //------------------------------------------------------------
-
-              // generate the alloca
-              return {Source, Alloc};
-            }
-          }
-          // otherwise propagate all facts
-          return {Source};
-        });
+    if (Alloc->getAllocatedType()->isIntegerTy() ||
+        Alloc->getAllocatedType()->isFloatingPointTy() ||
+        Alloc->getAllocatedType()->isPointerTy() ||
+        Alloc->getAllocatedType()->isArrayTy()) {
+      //------------------------------------------------------------------
+      // Why not generate for structs, but for arrays? (would be
+      // consistent to generate either both or none of them)
+      //------------------------------------------------------------------
+
+      // generate the alloca
+      return ff::makeFlowFunction<IFDSUninitializedVariables::d_t>(
+          ff::gen<IFDSUninitializedVariables::d_t>(Alloc, getZeroValue()));
+    }
+    // otherwise propagate all facts
+    return Identity<IFDSUninitializedVariables::d_t>::getInstance();
   }
   // check if some instruction is using an undefined value (in)directly
   struct UVFF : FlowFunction<IFDSUninitializedVariables::d_t> {
@@ -400,6 +396,23 @@ IFDSUninitializedVariables::getSummaryFlowFunction(
   return nullptr;
 }
 
+bool IFDSUninitializedVariables::isRelevant(
+    IFDSUninitializedVariables::n_t Inst,
+    IFDSUninitializedVariables::d_t Fact) {
+  // allocas only generate new facts from the zero value
+  if (llvm::isa<llvm::AllocaInst>(Inst)) {
+    return isZeroValue(Fact);
+  }
+  // all other instructions only affect the facts they use, unless they use an
+  // undefined value, which generates the instruction from every fact
+  for (const auto &Operand : Inst->operands()) {
+    if (Operand == Fact || llvm::isa<llvm::UndefValue>(Operand)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 map<IFDSUninitializedVariables::n_t, set<IFDSUninitializedVariables::d_t>>
 IFDSUninitializedVariables::initialSeeds() {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -414,6 +427,16 @@ IFDSUninitializedVariables::initialSeeds() {
   return SeedMap;
 }
 
+std::vector<IFDSUninitializedVariables::d_t>
+IFDSUninitializedVariables::getFactUniverse() {
+  std::vector<IFDSUninitializedVariables::d_t> Universe{getZeroValue()};
+  for (auto *M : IRDB->getAllModules()) {
+    auto Values = getAllValuesOf(*M);
+    Universe.insert(Universe.end(), Values.begin(), Values.end());
+  }
+  return Universe;
+}
+
 IFDSUninitializedVariables::d_t
 IFDSUninitializedVariables::createZeroValue() const {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
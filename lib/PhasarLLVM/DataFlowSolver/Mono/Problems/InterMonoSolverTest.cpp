@@ -53,7 +53,7 @@ BitVectorSet<const llvm::Value *>
 InterMonoSolverTest::normalFlow(const llvm::Instruction *Stmt,
                                 const BitVectorSet<const llvm::Value *> &In) {
   cout << "InterMonoSolverTest::normalFlow()\n";
-  BitVectorSet<const llvm::Value *> Result;
+  BitVectorSet<const llvm::Value *> Result(FactIndex);
   Result = Result.setUnion(In);
   if (const auto *const Alloc = llvm::dyn_cast<llvm::AllocaInst>(Stmt)) {
     Result.insert(Alloc);
@@ -66,7 +66,7 @@ InterMonoSolverTest::callFlow(const llvm::Instruction *CallSite,
                               const llvm::Function *Callee,
                               const BitVectorSet<const llvm::Value *> &In) {
   cout << "InterMonoSolverTest::callFlow()\n";
-  BitVectorSet<const llvm::Value *> Result;
+  BitVectorSet<const llvm::Value *> Result(FactIndex);
   Result.setUnion(In);
   if (const auto *const Call = llvm::dyn_cast<llvm::CallInst>(CallSite)) {
     Result.insert(Call);
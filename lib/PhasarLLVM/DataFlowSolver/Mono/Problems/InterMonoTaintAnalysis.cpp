@@ -89,7 +89,7 @@ InterMonoTaintAnalysis::callFlow(const llvm::Instruction *CallSite,
                                  const BitVectorSet<const llvm::Value *> &In) {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "InterMonoTaintAnalysis::callFlow()");
-  BitVectorSet<const llvm::Value *> Out;
+  BitVectorSet<const llvm::Value *> Out(FactIndex);
   llvm::ImmutableCallSite CS(CallSite);
   vector<const llvm::Value *> Actuals;
   vector<const llvm::Value *> Formals;
@@ -118,7 +118,7 @@ BitVectorSet<const llvm::Value *> InterMonoTaintAnalysis::returnFlow(
     const BitVectorSet<const llvm::Value *> &In) {
   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "InterMonoTaintAnalysis::returnFlow()");
-  BitVectorSet<const llvm::Value *> Out;
+  BitVectorSet<const llvm::Value *> Out(FactIndex);
   if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(ExitStmt)) {
     if (In.count(Ret->getReturnValue())) {
       Out.insert(CallSite);
@@ -193,7 +193,7 @@ InterMonoTaintAnalysis::initialSeeds() {
   const llvm::Function *Main = ICF->getFunction("main");
   unordered_map<const llvm::Instruction *, BitVectorSet<const llvm::Value *>>
       Seeds;
-  BitVectorSet<const llvm::Value *> Facts;
+  BitVectorSet<const llvm::Value *> Facts(FactIndex);
   for (unsigned Idx = 0; Idx < Main->arg_size(); ++Idx) {
     Facts.insert(getNthFunctionArgument(Main, Idx));
   }
@@ -23,18 +23,6 @@
 #include "phasar/Utils/BitVectorSet.h"
 #include "phasar/Utils/LLVMShorthands.h"
 
-namespace std {
-template <> struct hash<pair<const llvm::Value *, unsigned>> {
-  size_t operator()(const pair<const llvm::Value *, unsigned> &P) const {
-    std::hash<const llvm::Value *> HashPtr;
-    std::hash<unsigned> HashUnsigned;
-    size_t HP = HashPtr(P.first);
-    size_t HU = HashUnsigned(P.second);
-    return HP ^ (HU << 1);
-  }
-};
-} // namespace std
-
 using namespace psr;
 namespace psr {
 
@@ -59,7 +59,7 @@ BitVectorSet<const llvm::Value *>
 IntraMonoSolverTest::normalFlow(const llvm::Instruction *S,
                                 const BitVectorSet<const llvm::Value *> &In) {
   cout << "IntraMonoSolverTest::normalFlow()\n";
-  BitVectorSet<const llvm::Value *> Result;
+  BitVectorSet<const llvm::Value *> Result(FactIndex);
   Result.insert(In);
   if (const auto *const Store = llvm::dyn_cast<llvm::StoreInst>(S)) {
     Result.insert(Store);
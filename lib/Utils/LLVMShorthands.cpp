@@ -14,10 +14,13 @@
  *      Author: philipp
  */
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
@@ -25,8 +28,10 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
@@ -153,6 +158,29 @@ globalValuesUsedinFunction(const llvm::Function *F) {
   return GlobalsUsed;
 }
 
+std::vector<const llvm::Value *> getAllValuesOf(const llvm::Module &M) {
+  std::vector<const llvm::Value *> Values;
+  for (const auto &G : M.globals()) {
+    Values.push_back(&G);
+  }
+  for (const auto &F : M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    for (const auto &Arg : F.args()) {
+      Values.push_back(&Arg);
+    }
+    for (const auto &BB : F) {
+      for (const auto &I : BB) {
+        if (!I.getType()->isVoidTy()) {
+          Values.push_back(&I);
+        }
+      }
+    }
+  }
+  return Values;
+}
+
 std::string getMetaDataID(const llvm::Value *V) {
   if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
     if (auto *Metadata = Inst->getMetadata(PhasarConfig::MetaDataKind())) {
@@ -287,6 +315,83 @@ std::size_t computeModuleHash(const llvm::Module *M) {
   return std::hash<std::string>{}(SourceCode);
 }
 
+std::size_t computeFunctionHash(const llvm::Function *F) {
+  // std::hash is not guaranteed to be stable across runs
+  llvm::MD5 Hash;
+  auto UpdateInt = [&Hash](uint64_t Val) {
+    std::array<uint8_t, sizeof(Val)> Bytes;
+    for (auto &Byte : Bytes) {
+      Byte = Val & 0xFF;
+      Val >>= 8;
+    }
+    Hash.update(Bytes);
+  };
+  auto UpdateStr = [&Hash, &UpdateInt](llvm::StringRef Str) {
+    UpdateInt(Str.size());
+    Hash.update(Str);
+  };
+  auto UpdateType = [&UpdateStr](const llvm::Type *Ty) {
+    std::string TypeStr;
+    llvm::raw_string_ostream RSO(TypeStr);
+    Ty->print(RSO);
+    UpdateStr(RSO.str());
+  };
+  UpdateStr(F->getName());
+  UpdateType(F->getFunctionType());
+  UpdateInt(F->getLinkage());
+  UpdateInt(F->getCallingConv());
+  UpdateStr(
+      F->getAttributes().getAsString(llvm::AttributeList::FunctionIndex));
+  // values local to F are referred to by their position, metadata is
+  // skipped entirely as it is numbered module-wide
+  llvm::DenseMap<const llvm::Value *, uint64_t> LocalIds;
+  uint64_t NextId = 0;
+  for (const auto &Arg : F->args()) {
+    LocalIds[&Arg] = NextId++;
+  }
+  for (const auto &BB : *F) {
+    LocalIds[&BB] = NextId++;
+    for (const auto &I : BB) {
+      LocalIds[&I] = NextId++;
+    }
+  }
+  for (const auto &BB : *F) {
+    UpdateInt(BB.size());
+    for (const auto &I : BB) {
+      UpdateInt(I.getOpcode());
+      UpdateInt(I.getRawSubclassOptionalData());
+      UpdateType(I.getType());
+      if (const auto *Cmp = llvm::dyn_cast<llvm::CmpInst>(&I)) {
+        UpdateInt(Cmp->getPredicate());
+      } else if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+        UpdateType(Alloca->getAllocatedType());
+      } else if (const auto *GEP =
+                     llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+        UpdateType(GEP->getSourceElementType());
+      }
+      UpdateInt(I.getNumOperands());
+      for (const auto &Use : I.operands()) {
+        const llvm::Value *Op = Use.get();
+        if (llvm::isa<llvm::MetadataAsValue>(Op)) {
+          UpdateInt(0);
+        } else if (auto It = LocalIds.find(Op); It != LocalIds.end()) {
+          UpdateInt(1);
+          UpdateInt(It->second);
+        } else {
+          UpdateInt(2);
+          std::string OpStr;
+          llvm::raw_string_ostream RSO(OpStr);
+          Op->printAsOperand(RSO, true, F->getParent());
+          UpdateStr(RSO.str());
+        }
+      }
+    }
+  }
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.low();
+}
+
 const llvm::Instruction *getNthTermInstruction(const llvm::Function *F,
                                                unsigned TermInstNo) {
   unsigned Current = 1;
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <iterator>
 #include <ostream>
 
@@ -21,6 +22,7 @@
 #include "llvm/IR/DerivedTypes.h"
 
 #include "cxxabi.h"
+#include "unistd.h"
 
 #include "phasar/Utils/Utilities.h"
 
@@ -39,6 +41,17 @@ std::string createTimeStamp() {
   return TimeStr;
 }
 
+size_t getResidentSetSize() {
+  // the second field of statm holds the number of resident pages
+  std::ifstream Statm("/proc/self/statm");
+  size_t Size;
+  size_t Resident;
+  if (!(Statm >> Size >> Resident)) {
+    return 0;
+  }
+  return Resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
 string cxxDemangle(const string &MangledName) {
   return boost::core::demangle(MangledName.c_str());
 }
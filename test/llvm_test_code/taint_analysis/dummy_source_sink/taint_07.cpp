@@ -0,0 +1,12 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+
+int id(int p) { return p; }
+int zero(int p) { return 0; }
+
+int main(int argc, char **argv) {
+  int a = source();
+  int b = id(a);
+  sink(b);
+  return 0;
+}
@@ -0,0 +1,15 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+
+int id(int p) { return p; }
+int zero(int p) { return 0; }
+
+// taint_07.cpp with a modified main
+int main(int argc, char **argv) {
+  int a = source();
+  int b = zero(a);
+  sink(b);
+  int c = id(a);
+  sink(c);
+  return 0;
+}
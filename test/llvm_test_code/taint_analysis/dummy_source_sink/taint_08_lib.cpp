@@ -0,0 +1,5 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+
+int launder(int p) { return p; }
+void report(int p) { sink(p); }
@@ -0,0 +1,12 @@
+int source();
+void sink(int p);
+int launder(int p);
+void report(int p);
+
+int main(int argc, char **argv) {
+  int a = source();
+  int b = launder(a);
+  sink(b);
+  report(a);
+  return 0;
+}
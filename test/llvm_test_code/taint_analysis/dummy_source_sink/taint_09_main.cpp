@@ -0,0 +1,12 @@
+int source() { return 0; } // dummy source
+void sink(int p) {}        // dummy sink
+
+int relay(int p);
+int forward(int p) { return p; }
+
+int main(int argc, char **argv) {
+  int a = source();
+  int b = relay(a);
+  sink(b);
+  return 0;
+}
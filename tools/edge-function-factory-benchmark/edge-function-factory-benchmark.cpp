@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+// Compares the sharded EdgeFunctionSingletonFactory against the previous
+// implementation, which guarded a single map with a single mutex, by
+// creating edge functions from a number of threads at once.
+//
+// usage: edge-function-factory-benchmark [creations per thread] [key count]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+using namespace psr;
+
+namespace {
+
+// The factory as it was before sharding, minus its cleaner thread.
+template <typename EdgeFunctionType, typename CtorArgT>
+class MutexMapSingletonFactory {
+public:
+  static std::shared_ptr<EdgeFunctionType> createEdgeFunction(CtorArgT K) {
+    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
+
+    auto &Storage = getCacheData().Storage;
+    auto SearchVal = Storage.find(K);
+    if (SearchVal != Storage.end() && !SearchVal->second.expired()) {
+      return SearchVal->second.lock();
+    }
+    auto NewEdgeFunc = makePooledShared<EdgeFunctionType>(K);
+    Storage[K] = NewEdgeFunc;
+    return NewEdgeFunc;
+  }
+
+private:
+  struct EFStorageData {
+    std::map<CtorArgT, std::weak_ptr<EdgeFunctionType>> Storage{};
+    std::mutex DataMutex;
+  };
+
+  static EFStorageData &getCacheData() {
+    static EFStorageData StoredData{};
+    return StoredData;
+  }
+};
+
+struct ConstantEF : public EdgeFunction<int> {
+  explicit ConstantEF(int Val) : Val(Val) {}
+
+  int computeTarget(int /*Source*/) override { return Val; }
+
+  EdgeFunctionPtrType composeWith(EdgeFunctionPtrType SecondFunction) override {
+    return SecondFunction;
+  }
+
+  EdgeFunctionPtrType joinWith(EdgeFunctionPtrType OtherFunction) override {
+    return OtherFunction;
+  }
+
+  bool equal_to(EdgeFunctionPtrType OtherFunction) const override {
+    return this == OtherFunction.get();
+  }
+
+  int Val;
+};
+
+struct ShardedEF : public ConstantEF,
+                   public EdgeFunctionSingletonFactory<ShardedEF, int> {
+  using ConstantEF::ConstantEF;
+};
+
+struct MutexMapEF : public ConstantEF,
+                    public MutexMapSingletonFactory<MutexMapEF, int> {
+  using ConstantEF::ConstantEF;
+};
+
+// Every thread keeps the last few edge functions it created alive, such that
+// the workload mixes lookups of live edge functions with re-creations of
+// expired ones, similar to a solver that drops jump functions over time.
+template <typename FactoryEF>
+double run(unsigned NumThreads, size_t CreationsPerThread, int NumKeys) {
+  constexpr size_t KeepAlive = 64;
+  auto Start = std::chrono::steady_clock::now();
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([=] {
+      std::vector<std::shared_ptr<FactoryEF>> Alive(KeepAlive);
+      unsigned State = T + 1;
+      for (size_t I = 0; I < CreationsPerThread; ++I) {
+        State = State * 1103515245U + 12345U;
+        int Key = static_cast<int>((State >> 8) % NumKeys);
+        Alive[I % KeepAlive] = FactoryEF::createEdgeFunction(Key);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  std::chrono::duration<double, std::milli> Elapsed =
+      std::chrono::steady_clock::now() - Start;
+  return Elapsed.count();
+}
+
+} // anonymous namespace
+
+int main(int Argc, char **Argv) {
+  size_t CreationsPerThread = Argc > 1 ? std::strtoull(Argv[1], nullptr, 10)
+                                       : 1000000;
+  int NumKeys = Argc > 2 ? std::atoi(Argv[2]) : 4096;
+  if (CreationsPerThread == 0 || NumKeys <= 0) {
+    std::cerr << "usage: " << Argv[0]
+              << " [creations per thread] [key count]\n";
+    return 1;
+  }
+
+  std::vector<unsigned> ThreadCounts = {1, 2, 4, 8};
+  unsigned HWThreads = std::thread::hardware_concurrency();
+  if (HWThreads > 8) {
+    ThreadCounts.push_back(HWThreads);
+  }
+
+  std::cout << "creations per thread: " << CreationsPerThread
+            << ", keys: " << NumKeys << "\n\n";
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "mutex+map ms"
+            << std::setw(16) << "sharded ms" << std::setw(10) << "speedup"
+            << '\n';
+  for (unsigned NumThreads : ThreadCounts) {
+    double Baseline = run<MutexMapEF>(NumThreads, CreationsPerThread, NumKeys);
+    double Sharded = run<ShardedEF>(NumThreads, CreationsPerThread, NumKeys);
+    std::cout << std::setw(8) << NumThreads << std::setw(16) << std::fixed
+              << std::setprecision(1) << Baseline << std::setw(16) << Sharded
+              << std::setw(9) << std::setprecision(2) << Baseline / Sharded
+              << "x\n";
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "boost/program_options.hpp"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ESGTrace.h"
+#include "phasar/Utils/Logger.h"
+
+using namespace std;
+using namespace psr;
+namespace po = boost::program_options;
+
+// prints the number of recorded edges per function of their source node
+void printStatistics(std::ostream &OS, const ESGTraceReader &Reader,
+                     const std::set<std::string> &SelectedFunctions) {
+  size_t NumEdges = 0;
+  std::map<std::string, size_t> EdgesPerFunction;
+  Reader.foreachEdgeOf(SelectedFunctions, [&](const auto &E) {
+    const auto &Src = Reader.getNode(E.SrcNode);
+    ++EdgesPerFunction[Reader.getFunctions()[Src.Function].str()];
+    ++NumEdges;
+  });
+  OS << "Edges: " << NumEdges << '\n';
+  for (const auto &[Function, Count] : EdgesPerFunction) {
+    OS << "  " << Function << ": " << Count << '\n';
+  }
+}
+
+int main(int Argc, char **Argv) {
+  initializeLogger(false);
+  std::string TraceFile;
+  std::string Format;
+  std::string OutputFile;
+  std::vector<std::string> Functions;
+  po::options_description Options(
+      "Renders the exploded super-graph (ESG) that has been traced by a "
+      "solver,\nsee IFDSIDESolverConfig::setESGTraceFile()\n\nOptions");
+  // clang-format off
+  Options.add_options()
+    ("help,h", "Print help message")
+    ("trace,t", po::value(&TraceFile)->required(), "The ESG trace file")
+    ("function,f", po::value(&Functions)->multitoken(),
+     "Only render the edges from or to the given function(s)")
+    ("format", po::value(&Format)->default_value("dot"),
+     "The output format: dot, json or stats")
+    ("output,o", po::value(&OutputFile),
+     "The output file (default: stdout)");
+  // clang-format on
+  po::positional_options_description Positional;
+  Positional.add("trace", 1);
+  po::variables_map VarMap;
+  try {
+    po::store(po::command_line_parser(Argc, Argv)
+                  .options(Options)
+                  .positional(Positional)
+                  .run(),
+              VarMap);
+    if (VarMap.count("help")) {
+      std::cout << Options << '\n';
+      return 0;
+    }
+    po::notify(VarMap);
+  } catch (const po::error &Err) {
+    std::cerr << "error: " << Err.what() << "\n\n" << Options << '\n';
+    return 1;
+  }
+  if (Format != "dot" && Format != "json" && Format != "stats") {
+    std::cerr << "error: unknown format '" << Format << "'\n";
+    return 1;
+  }
+  ESGTraceReader Reader;
+  if (!Reader.load(TraceFile)) {
+    std::cerr << "error: cannot read ESG trace '" << TraceFile << "'\n";
+    return 1;
+  }
+  std::set<std::string> SelectedFunctions(Functions.begin(), Functions.end());
+  for (const auto &Function : SelectedFunctions) {
+    bool Traced = false;
+    for (const auto &Name : Reader.getFunctions()) {
+      Traced |= Name == Function;
+    }
+    if (!Traced) {
+      std::cerr << "warning: function '" << Function
+                << "' does not occur in the trace\n";
+    }
+  }
+  std::ofstream OFS;
+  if (!OutputFile.empty()) {
+    OFS.open(OutputFile);
+    if (!OFS) {
+      std::cerr << "error: cannot write '" << OutputFile << "'\n";
+      return 1;
+    }
+  }
+  std::ostream &OS = OutputFile.empty() ? std::cout : OFS;
+  if (Format == "dot") {
+    Reader.printAsDot(OS, SelectedFunctions);
+    OS << '\n';
+  } else if (Format == "json") {
+    OS << Reader.getAsJson(SelectedFunctions).dump(2) << '\n';
+  } else {
+    printStatistics(OS, Reader, SelectedFunctions);
+  }
+  return 0;
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright (c) 2020 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+// Compares the heap allocations and run time of solving IFDSSolverTest on
+// the given LLVM IR files with flow functions that return their targets in
+// a std::set against flow functions that return them in a SmallFactSet.
+//
+// usage: flow-function-container-benchmark <LLVM IR file>... [repetitions]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SmallFactSet.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/Logger.h"
+
+namespace {
+size_t NumAllocations = 0;
+// keeps the compiler from dropping the results
+volatile size_t Sink = 0;
+} // anonymous namespace
+
+// Counts every allocation of the benchmark; the solver runs single-threaded.
+void *operator new(size_t Size) {
+  ++NumAllocations;
+  if (void *Ptr = std::malloc(Size ? Size : 1)) {
+    return Ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *Ptr) noexcept { std::free(Ptr); }
+
+void operator delete(void *Ptr, size_t /*Size*/) noexcept { std::free(Ptr); }
+
+using namespace psr;
+
+namespace {
+
+struct Workload {
+  size_t Allocations;
+  double Millis;
+  size_t Results;
+};
+
+// Solves IFDSSolverTest with the given container Repetitions times.
+template <typename Container>
+Workload run(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH, LLVMBasedICFG &ICF,
+             LLVMPointsToSet &PT, unsigned Repetitions) {
+  Workload W{0, 0, 0};
+  for (unsigned I = 0; I < Repetitions; ++I) {
+    IFDSSolverTestT<Container> Problem(&IRDB, &TH, &ICF, &PT, {"main"});
+    size_t AllocationsBefore = NumAllocations;
+    auto Start = std::chrono::steady_clock::now();
+    {
+      IFDSSolver<LLVMAnalysisDomainDefault, Container> Solver(Problem);
+      Solver.solve();
+      for (const auto *F : IRDB.getAllFunctions()) {
+        for (const auto &BB : *F) {
+          for (const auto &Inst : BB) {
+            W.Results += Solver.ifdsResultsAt(&Inst).size();
+          }
+        }
+      }
+    }
+    std::chrono::duration<double, std::milli> Elapsed =
+        std::chrono::steady_clock::now() - Start;
+    W.Allocations += NumAllocations - AllocationsBefore;
+    W.Millis += Elapsed.count();
+  }
+  Sink = W.Results;
+  return W;
+}
+
+} // anonymous namespace
+
+int main(int Argc, char **Argv) {
+  initializeLogger(false);
+  std::vector<std::string> IRFiles;
+  unsigned Repetitions = 10;
+  for (int I = 1; I < Argc; ++I) {
+    if (boost::filesystem::is_regular_file(Argv[I])) {
+      IRFiles.emplace_back(Argv[I]);
+    } else if (I == Argc - 1 && std::atoi(Argv[I]) > 0) {
+      Repetitions = std::atoi(Argv[I]);
+    } else {
+      IRFiles.clear();
+      break;
+    }
+  }
+  if (IRFiles.empty()) {
+    std::cerr << "usage: " << Argv[0]
+              << " <LLVM IR file>... [repetitions]\n";
+    return 1;
+  }
+  using SetTy = std::set<LLVMAnalysisDomainDefault::d_t>;
+  using SmallTy = SmallFactSet<LLVMAnalysisDomainDefault::d_t>;
+
+  std::cout << "repetitions: " << Repetitions << "\n\n";
+  std::cout << std::setw(40) << "IFDSSolverTest on" << std::setw(14)
+            << "set allocs" << std::setw(14) << "small allocs" << std::setw(14)
+            << "set ms" << std::setw(14) << "small ms" << '\n';
+  for (const auto &IRFile : IRFiles) {
+    ProjectIRDB IRDB({IRFile}, IRDBOptions::WPA);
+    if (!IRDB.getFunctionDefinition("main")) {
+      std::cerr << IRFile << " does not define main, skipping\n";
+      continue;
+    }
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+    auto Set = run<SetTy>(IRDB, TH, ICF, PT, Repetitions);
+    auto Small = run<SmallTy>(IRDB, TH, ICF, PT, Repetitions);
+    if (Set.Results != Small.Results) {
+      std::cerr << IRFile << ": the containers yield different results\n";
+      return 1;
+    }
+    std::cout << std::setw(40)
+              << boost::filesystem::path(IRFile).filename().string()
+              << std::setw(14) << Set.Allocations / Repetitions
+              << std::setw(14) << Small.Allocations / Repetitions
+              << std::fixed << std::setprecision(1) << std::setw(14)
+              << Set.Millis / Repetitions << std::setw(14)
+              << Small.Millis / Repetitions << '\n';
+  }
+  return 0;
+}
@@ -289,14 +289,21 @@ int main(int Argc, const char **Argv) {
   } else {
     Strategy = AnalysisStrategy::WholeProgram;
   }
+  if (PhasarConfig::VariablesMap().count("mwa")) {
+    Strategy = AnalysisStrategy::ModuleWise;
+  }
   if (!PhasarConfig::VariablesMap().count("module")) {
     std::cout << "At least on LLVM target module is required!\n"
                  "Specify a LLVM target module or re-run with '--help'\n";
     return 0;
   }
-  // setup IRDB as source code manager
+  // setup IRDB as source code manager, the modules are only linked into a
+  // single module if they are not analyzed module-wise
   ProjectIRDB IRDB(
-      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>());
+      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>(),
+      Strategy == AnalysisStrategy::ModuleWise
+          ? IRDBOptions::OWNS
+          : (IRDBOptions::WPA | IRDBOptions::OWNS));
 
   // store enabled data-flow analyses
   std::vector<DataFlowAnalysisKind> DataFlowAnalyses;
@@ -0,0 +1,73 @@
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ESGTrace.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class ESGTraceTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(ESGTraceTest, ESGTraceTest_05) {
+  unittest::TemporaryFile TraceFile(".esg");
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  TaintProblem->getIFDSIDESolverConfig().setESGTraceFile(TraceFile.path());
+  TaintProblem->getIFDSIDESolverConfig().setRecordEdges(false);
+  IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  ESGTraceReader Reader;
+  ASSERT_TRUE(Reader.load(TraceFile.path()));
+  EXPECT_GT(Reader.getNumEdges(), 0U);
+  // the edges from or to sink()
+  size_t NumSinkEdges = 0;
+  Reader.foreachEdgeOf({"_Z4sinki"}, [&](const ESGTraceReader::Edge &E) {
+    ++NumSinkEdges;
+    auto SrcFun = Reader.getFunctions()[Reader.getNode(E.SrcNode).Function];
+    auto DstFun = Reader.getFunctions()[Reader.getNode(E.DstNode).Function];
+    EXPECT_TRUE(SrcFun == "_Z4sinki" || DstFun == "_Z4sinki");
+  });
+  EXPECT_GT(NumSinkEdges, 0U);
+  EXPECT_LT(NumSinkEdges, Reader.getNumEdges());
+  EXPECT_EQ(Reader.getAsJson({"_Z4sinki"})["edges"].size(), NumSinkEdges);
+  std::stringstream DOT;
+  Reader.printAsDot(DOT, {"_Z4sinki"});
+  EXPECT_NE(DOT.str().find("subgraph cluster__Z4sinki"), std::string::npos);
+}
+
+TEST_F(ESGTraceTest, ESGTraceTest_CorruptID) {
+  unittest::TemporaryFile TraceFile(".esg");
+  {
+    ESGTraceWriter Writer(TraceFile.path());
+    Writer.addFunction(0, "main");
+    Writer.addNode(0, 0, "1", "entry");
+    Writer.addFact(0, true, "zero");
+    Writer.addEdge(false, 0, 0, 0, 0);
+    // a corrupt ID must not be taken as the size of the facts
+    Writer.addFact(0xFFFFFFFF, false, "corrupt");
+    Writer.addFact(1, false, "a");
+    Writer.addEdge(false, 0, 0, 0, 1);
+    ASSERT_TRUE(Writer.good());
+  }
+  ESGTraceReader Reader;
+  ASSERT_TRUE(Reader.load(TraceFile.path()));
+  EXPECT_EQ(Reader.getNumEdges(), 1U);
+  size_t NumEdges = 0;
+  Reader.foreachEdge([&](const ESGTraceReader::Edge &E) {
+    ++NumEdges;
+    EXPECT_TRUE(Reader.getFact(E.DstFact).IsZero);
+  });
+  EXPECT_EQ(NumEdges, 1U);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,4 +1,5 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionMemoTable.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
 
 #include "gtest/gtest.h"
@@ -23,6 +24,42 @@ struct MyEFC : EdgeFunctionComposer<int> {
   };
 };
 
+struct OtherEFC : EdgeFunctionComposer<int> {
+  OtherEFC(std::shared_ptr<EdgeFunction<int>> F,
+           std::shared_ptr<EdgeFunction<int>> G)
+      : EdgeFunctionComposer<int>(std::move(F), std::move(G)){};
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> OtherFunction) override {
+    return std::make_shared<AllBottom<int>>(-1);
+  };
+};
+
+// an edge function with structural equality
+struct AddEF : EdgeFunction<int>, std::enable_shared_from_this<AddEF> {
+  const int Summand;
+
+  AddEF(int Summand) : Summand(Summand){};
+  int computeTarget(int Source) override { return Source + Summand; };
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) override {
+    return std::make_shared<MyEFC>(this->shared_from_this(), SecondFunction);
+  }
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> OtherFunction) override {
+    return std::make_shared<AllBottom<int>>(-1);
+  };
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> Other) const override {
+    if (auto *A = dynamic_cast<AddEF *>(Other.get())) {
+      return A->Summand == Summand;
+    }
+    return false;
+  }
+  size_t hash() const override { return std::hash<int>()(Summand) + 1; }
+  void print(std::ostream &Os, bool IsForDebug = false) const override {
+    Os << "AddEF_" << Summand;
+  }
+};
+
 struct MulTwoEF : EdgeFunction<int>, std::enable_shared_from_this<MulTwoEF> {
 private:
   const unsigned MulTwoEfId;
@@ -98,6 +135,54 @@ TEST(EdgeFunctionComposerTest, HandleEFComposition) {
   EXPECT_FALSE(AddEF1->equal_to(AddEF2));
 }
 
+TEST(EdgeFunctionComposerTest, StructuralEqualityAndHash) {
+  auto EFC1 = std::make_shared<MyEFC>(std::make_shared<AddEF>(1),
+                                      std::make_shared<AddEF>(2));
+  auto EFC2 = std::make_shared<MyEFC>(std::make_shared<AddEF>(1),
+                                      std::make_shared<AddEF>(2));
+  auto EFC3 = std::make_shared<MyEFC>(std::make_shared<AddEF>(2),
+                                      std::make_shared<AddEF>(1));
+  EXPECT_TRUE(EFC1->equal_to(EFC2));
+  EXPECT_NE(EFC1->hash(), 0U);
+  EXPECT_EQ(EFC1->hash(), EFC2->hash());
+  EXPECT_FALSE(EFC1->equal_to(EFC3));
+  // composers of different types are not equal, even over the same parts
+  auto Other = std::make_shared<OtherEFC>(std::make_shared<AddEF>(1),
+                                          std::make_shared<AddEF>(2));
+  EXPECT_FALSE(EFC1->equal_to(Other));
+  EXPECT_FALSE(Other->equal_to(EFC1));
+  EXPECT_NE(EFC1->hash(), Other->hash());
+  // parts that opt out of sharing make the composition opt out as well
+  auto EFC4 = std::make_shared<MyEFC>(std::make_shared<AddEF>(1),
+                                      std::make_shared<AddTwoEF>(0));
+  EXPECT_EQ(EFC4->hash(), 0U);
+}
+
+TEST(EdgeFunctionComposerTest, MemoTableKeepsComposerTypes) {
+  EdgeFunctionMemoTable<int> Memo;
+  auto EFC = Memo.intern(std::make_shared<MyEFC>(std::make_shared<AddEF>(1),
+                                                 std::make_shared<AddEF>(2)));
+  auto Same = Memo.intern(std::make_shared<MyEFC>(
+      std::make_shared<AddEF>(1), std::make_shared<AddEF>(2)));
+  auto Other = Memo.intern(std::make_shared<OtherEFC>(
+      std::make_shared<AddEF>(1), std::make_shared<AddEF>(2)));
+  EXPECT_EQ(EFC, Same);
+  EXPECT_NE(EFC, Other);
+  EXPECT_NE(dynamic_cast<OtherEFC *>(Other.get()), nullptr);
+}
+
+TEST(EdgeFunctionComposerTest, ChainLength) {
+  auto AddEF1 = std::make_shared<AddTwoEF>(++CurrAddTwoEfId);
+  auto AddEF2 = std::make_shared<AddTwoEF>(++CurrAddTwoEfId);
+  auto MulEF = std::make_shared<MulTwoEF>(++CurrMulTwoEfId);
+  auto EFC1 = std::make_shared<MyEFC>(AddEF1, MulEF);
+  EXPECT_EQ(EFC1->getChainLength(), 2U);
+  auto EFC2 = std::make_shared<MyEFC>(EFC1, AddEF2);
+  EXPECT_EQ(EFC2->getChainLength(), 3U);
+  auto EFC3 = std::make_shared<OtherEFC>(EFC2, EFC1);
+  EXPECT_EQ(EFC3->getChainLength(), 5U);
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
@@ -2,8 +2,10 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 
-#include <chrono>
+#include <map>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace psr::internal {
 struct TestEdgeFunction
@@ -45,7 +47,7 @@ TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctions) {
   auto EF1 = TestEdgeFunction::createEdgeFunction(42);
   auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
+  EXPECT_EQ(TestEdgeFunction::getTestCacheData().size(), 2U);
 }
 
 TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsWithCorrectData) {
@@ -61,7 +63,7 @@ TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsTwice) {
   auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
   auto EF3 = TestEdgeFunction::createEdgeFunction(42);
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
+  EXPECT_EQ(TestEdgeFunction::getTestCacheData().size(), 2U);
   EXPECT_EQ(EF1.get(), EF3.get());
 }
 
@@ -73,49 +75,92 @@ TEST(EdgeFunctionSingletonFactoryTest, selfCleanExpiredEdgeFunctions) {
 
   TestEdgeFunction::cleanExpiredEdgeFunctions();
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 1U);
+  EXPECT_EQ(TestEdgeFunction::getTestCacheData().size(), 1U);
 }
 
-//===----------------------------------------------------------------------===//
-// Threaded tests
+TEST(EdgeFunctionSingletonFactoryTest, reclaimExpiredOnInsertion) {
+  TestEdgeFunction::cleanExpiredEdgeFunctions();
+  ASSERT_EQ(TestEdgeFunction::getTestCacheData().size(), 0U);
 
-TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
+  for (int I = 10000; I < 11000; ++I) {
+    TestEdgeFunction::createEdgeFunction(I);
+  } // all of them expire immediately
 
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
+  std::vector<std::shared_ptr<TestEdgeFunction>> Live;
+  for (int I = 20000; I < 24000; ++I) {
+    Live.push_back(TestEdgeFunction::createEdgeFunction(I));
+  }
 
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
+  // the insertions have swept over the expired EdgeFunctions
+  EXPECT_EQ(TestEdgeFunction::getTestCacheData().size(), Live.size());
 }
 
-TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsTwiceThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
-
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
-  auto EF3 = TestEdgeFunction::createEdgeFunction(42);
+TEST(EdgeFunctionSingletonFactoryTest, recreateExpiredEdgeFunction) {
+  {
+    auto EF1 = TestEdgeFunction::createEdgeFunction(4711);
+  } // EF1 deleted after scope
 
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
-  EXPECT_EQ(EF1.get(), EF3.get());
+  auto EF2 = TestEdgeFunction::createEdgeFunction(4711);
+  ASSERT_NE(EF2, nullptr);
+  EXPECT_EQ(EF2->Val, 4711);
+  EXPECT_EQ(TestEdgeFunction::createEdgeFunction(4711).get(), EF2.get());
 }
 
-TEST(EdgeFunctionSingletonFactoryTest, selfCleanExpiredEdgeFunctionsThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
+//===----------------------------------------------------------------------===//
+// Threaded tests
 
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  {
-    auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
-  } // EF2 deleted after scope
+TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsThreaded) {
+  constexpr int NumThreads = 8;
+  constexpr int NumKeys = 1000;
+  std::vector<std::vector<std::shared_ptr<TestEdgeFunction>>> Created(
+      NumThreads);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&Created, T] {
+      for (int I = 0; I < NumKeys; ++I) {
+        // let the threads walk the keys in different orders
+        int Key = 30000 + (I * (T + 1)) % NumKeys;
+        Created[T].push_back(TestEdgeFunction::createEdgeFunction(Key));
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
 
-  std::this_thread::sleep_for(std::chrono::seconds{3});
+  std::map<int, TestEdgeFunction *> Canonical;
+  for (const auto &EFs : Created) {
+    for (const auto &EF : EFs) {
+      auto *&Expected = Canonical[EF->Val];
+      if (!Expected) {
+        Expected = EF.get();
+      }
+      EXPECT_EQ(EF.get(), Expected);
+    }
+  }
+  EXPECT_EQ(Canonical.size(), static_cast<size_t>(NumKeys));
+}
 
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 1U);
+TEST(EdgeFunctionSingletonFactoryTest, createAndExpireEdgeFunctionsThreaded) {
+  constexpr int NumThreads = 8;
+  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([T] {
+      for (int I = 0; I < 10000; ++I) {
+        // short-lived EdgeFunctions that race with their reclamation
+        auto EF = TestEdgeFunction::createEdgeFunction(40000 + (I + T) % 64);
+        EXPECT_EQ(EF->Val, 40000 + (I + T) % 64);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  TestEdgeFunction::cleanExpiredEdgeFunctions();
+  EXPECT_EQ(TestEdgeFunction::getTestCacheData().size(), 1U);
+  EXPECT_EQ(TestEdgeFunction::createEdgeFunction(42).get(), EF1.get());
 }
 
 // main function for the test case
@@ -0,0 +1,91 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctionCombinators.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SmallFactSet.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+
+using namespace psr;
+
+static constexpr int Zero = 0;
+
+// compares the targets of two flow functions for the facts 0 to 9
+static void expectSameTargets(FlowFunction<int> &Expected,
+                              FlowFunction<int> &Actual) {
+  for (int Fact = 0; Fact < 10; ++Fact) {
+    EXPECT_EQ(Expected.computeTargets(Fact), Actual.computeTargets(Fact))
+        << "for fact " << Fact;
+  }
+}
+
+TEST(FlowFunctionCombinatorsTest, MatchFlowFunctions) {
+  auto IsOdd = [](int Source) { return Source % 2 == 1; };
+  expectSameTargets(*Identity<int>::getInstance(),
+                    *ff::makeFlowFunction<int>(ff::identity()));
+  Gen<int> GenFF(7, Zero);
+  expectSameTargets(GenFF, *ff::makeFlowFunction<int>(ff::gen(7, Zero)));
+  GenIf<int> GenIfFF(8, IsOdd);
+  expectSameTargets(GenIfFF, *ff::makeFlowFunction<int>(ff::genIf(8, IsOdd)));
+  Kill<int> KillFF(3);
+  expectSameTargets(KillFF, *ff::makeFlowFunction<int>(ff::kill(3)));
+  KillIf<int> KillIfFF(IsOdd);
+  expectSameTargets(KillIfFF, *ff::makeFlowFunction<int>(ff::killIf(IsOdd)));
+  expectSameTargets(*KillAll<int>::getInstance(),
+                    *ff::makeFlowFunction<int>(ff::killAll()));
+  Transfer<int> TransferFF(4, 2);
+  expectSameTargets(TransferFF,
+                    *ff::makeFlowFunction<int>(ff::transfer(4, 2)));
+  ZeroedFlowFunction<int> ZeroedFF(KillAll<int>::getInstance(), Zero);
+  expectSameTargets(ZeroedFF, *ff::makeFlowFunction<int>(
+                                  ff::zeroed(ff::killAll(), Zero)));
+}
+
+TEST(FlowFunctionCombinatorsTest, Lambdas) {
+  LambdaFlow<int> LambdaFF([](int Source) -> std::set<int> {
+    return {Source, Source + 10};
+  });
+  expectSameTargets(LambdaFF, *ff::makeFlowFunction<int>(ff::lambda(
+                                  [](int Source) -> std::set<int> {
+                                    return {Source, Source + 10};
+                                  })));
+  expectSameTargets(LambdaFF,
+                    *ff::makeFlowFunction<int>(ff::lambda(
+                        [](int Source, std::set<int> &Targets) {
+                          Targets.insert(Source);
+                          Targets.insert(Source + 10);
+                        })));
+}
+
+TEST(FlowFunctionCombinatorsTest, ComposeAndUnite) {
+  // kills 1, then copies 2 to 3 and kills the previous 3
+  auto Composed = ff::makeFlowFunction<int>(
+      ff::compose(ff::kill(1), ff::identity(), ff::transfer(3, 2)));
+  EXPECT_EQ(std::set<int>(), Composed->computeTargets(1));
+  EXPECT_EQ(std::set<int>({2, 3}), Composed->computeTargets(2));
+  EXPECT_EQ(std::set<int>(), Composed->computeTargets(3));
+  EXPECT_EQ(std::set<int>({4}), Composed->computeTargets(4));
+  // generates 5 from the zero value and from 6, and kills 7
+  auto United = ff::makeFlowFunction<int>(
+      ff::unite(ff::gen(5, Zero), ff::genIf(5, [](int S) { return S == 6; }),
+                ff::killIf([](int S) { return S == 7; })));
+  EXPECT_EQ(std::set<int>({Zero, 5}), United->computeTargets(Zero));
+  EXPECT_EQ(std::set<int>({5, 6}), United->computeTargets(6));
+  // the union still contains 7, since gen passes it
+  EXPECT_EQ(std::set<int>({7}), United->computeTargets(7));
+}
+
+TEST(FlowFunctionCombinatorsTest, SmallFactSetContainer) {
+  using ContainerTy = SmallFactSet<int>;
+  auto FF = ff::makeFlowFunction<int, ContainerTy>(
+      ff::compose(ff::gen(1, Zero), ff::transfer(2, 1)));
+  EXPECT_EQ(ContainerTy({Zero, 1, 2}), FF->computeTargets(Zero));
+  EXPECT_EQ(ContainerTy(), FF->computeTargets(2));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
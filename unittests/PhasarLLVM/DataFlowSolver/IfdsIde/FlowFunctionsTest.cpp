@@ -0,0 +1,131 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctionCombinators.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SmallFactSet.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+
+static constexpr int Zero = 0;
+
+// collects the edges that computeTargetsBatch() draws for the facts 0 to 9
+template <typename ContainerTy>
+static std::map<int, std::multiset<int>>
+batchTargets(FlowFunction<int, ContainerTy> &FF) {
+  std::map<int, std::multiset<int>> Targets;
+  ContainerTy Sources;
+  for (int Fact = 0; Fact < 10; ++Fact) {
+    Sources.insert(Fact);
+    Targets[Fact];
+  }
+  FF.computeTargetsBatch(Sources, [&Targets](const int &Source,
+                                             const int &Target) {
+    Targets[Source].insert(Target);
+  });
+  return Targets;
+}
+
+// the edges that computeTargets() draws for the facts 0 to 9
+template <typename ContainerTy>
+static std::map<int, std::multiset<int>>
+targets(FlowFunction<int, ContainerTy> &FF) {
+  std::map<int, std::multiset<int>> Targets;
+  for (int Fact = 0; Fact < 10; ++Fact) {
+    auto FactTargets = FF.computeTargets(Fact);
+    Targets[Fact].insert(FactTargets.begin(), FactTargets.end());
+  }
+  return Targets;
+}
+
+template <typename ContainerTy> static void expectSameBatchTargets() {
+  std::vector<std::shared_ptr<FlowFunction<int, ContainerTy>>> FFs = {
+      Identity<int, ContainerTy>::getInstance(),
+      std::make_shared<ZeroedFlowFunction<int, ContainerTy>>(
+          KillAll<int, ContainerTy>::getInstance(), Zero),
+      std::make_shared<ZeroedFlowFunction<int, ContainerTy>>(
+          Identity<int, ContainerTy>::getInstance(), Zero),
+      std::make_shared<Gen<int, ContainerTy>>(7, Zero),
+      std::make_shared<Gen<int, ContainerTy>>(Zero, Zero),
+      std::make_shared<Kill<int, ContainerTy>>(3),
+      KillAll<int, ContainerTy>::getInstance(),
+      std::make_shared<Transfer<int, ContainerTy>>(4, 2),
+      std::make_shared<Transfer<int, ContainerTy>>(5, 5),
+      std::make_shared<LambdaFlow<int, ContainerTy>>(
+          [](int Source) -> ContainerTy {
+            return {Source, (Source + 1) % 10};
+          })};
+  for (size_t I = 0; I < FFs.size(); ++I) {
+    EXPECT_EQ(targets(*FFs[I]), batchTargets(*FFs[I]))
+        << "for flow function " << I;
+  }
+}
+
+TEST(FlowFunctionsTest, BatchTargetsMatchTargets) {
+  expectSameBatchTargets<std::set<int>>();
+  expectSameBatchTargets<SmallFactSet<int>>();
+}
+
+// the edges that the gen/kill form of FF describes for the facts 0 to 9
+static std::map<int, std::multiset<int>>
+genKillTargets(const FlowFunction<int> &FF) {
+  auto Form = FF.getGenKillForm();
+  EXPECT_TRUE(Form.has_value());
+  std::map<int, std::multiset<int>> Targets;
+  for (int Fact = 0; Fact < 10; ++Fact) {
+    auto &FactTargets = Targets[Fact];
+    if (!Form) {
+      continue;
+    }
+    if (!Form->KillAll && !Form->Kill.count(Fact)) {
+      FactTargets.insert(Fact);
+    }
+    if (Form->GenSource && *Form->GenSource == Fact) {
+      for (int Target : Form->Gen) {
+        if (!FactTargets.count(Target)) {
+          FactTargets.insert(Target);
+        }
+      }
+    }
+  }
+  return Targets;
+}
+
+TEST(FlowFunctionsTest, GenKillFormsMatchTargets) {
+  std::vector<std::shared_ptr<FlowFunction<int>>> FFs = {
+      Identity<int>::getInstance(),
+      std::make_shared<Gen<int>>(7, Zero),
+      std::make_shared<GenAll<int>>(std::set<int>{2, 3}, Zero),
+      std::make_shared<Kill<int>>(3),
+      std::make_shared<KillMultiple<int>>(std::set<int>{Zero, 4}),
+      KillAll<int>::getInstance(),
+      ff::makeFlowFunction<int>(ff::gen(5, Zero)),
+      ff::makeFlowFunction<int>(ff::zeroed(ff::killAll(), Zero))};
+  for (size_t I = 0, Size = FFs.size(); I < Size; ++I) {
+    FFs.push_back(std::make_shared<ZeroedFlowFunction<int>>(FFs[I], Zero));
+  }
+  for (size_t I = 0; I < FFs.size(); ++I) {
+    EXPECT_EQ(targets(*FFs[I]), genKillTargets(*FFs[I]))
+        << "for flow function " << I;
+  }
+  // flow functions whose targets depend on the source have no gen/kill form
+  EXPECT_FALSE(Transfer<int>(4, 2).getGenKillForm());
+  EXPECT_FALSE(
+      std::make_shared<ZeroedFlowFunction<int>>(
+          std::make_shared<Gen<int>>(7, 1), Zero)
+          ->getGenKillForm());
+  EXPECT_FALSE(
+      ff::makeFlowFunction<int>(ff::genIf(8, [](int S) { return S == 1; }))
+          ->getGenKillForm());
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class JumpFunctionsTest : public ::testing::TestWithParam<bool> {
+protected:
+  using n_t = IDELinearConstantAnalysis::n_t;
+  using d_t = IDELinearConstantAnalysis::d_t;
+  using l_t = IDELinearConstantAnalysis::l_t;
+  using JumpFunctionsTy =
+      JumpFunctions<IDELinearConstantAnalysisDomain, std::set<d_t>>;
+  // source fact, target fact, edge function
+  using Record = std::tuple<d_t, d_t, EdgeFunction<l_t> *>;
+
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB = nullptr;
+  LLVMTypeHierarchy *TH = nullptr;
+  LLVMPointsToSet *PT = nullptr;
+  LLVMBasedICFG *ICFG = nullptr;
+  IDELinearConstantAnalysis *LCAProblem = nullptr;
+  std::vector<n_t> Insts;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    IRDB = new ProjectIRDB({PathToLlFiles + "basic_01_cpp_dbg.ll"},
+                           IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    PT = new LLVMPointsToSet(*IRDB);
+    ICFG = new LLVMBasedICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                             TH, PT);
+    LCAProblem =
+        new IDELinearConstantAnalysis(IRDB, TH, ICFG, PT, EntryPoints);
+    for (const auto &I : llvm::instructions(IRDB->getFunction("main"))) {
+      Insts.push_back(&I);
+    }
+    ASSERT_GE(Insts.size(), 4U);
+  }
+
+  void TearDown() override {
+    delete LCAProblem;
+    delete ICFG;
+    delete PT;
+    delete TH;
+    delete IRDB;
+  }
+
+  static std::set<Record> getRecordsByTarget(const JumpFunctionsTy &JF,
+                                             n_t Target) {
+    std::set<Record> Records;
+    JF.foreachByTarget(Target, [&](d_t Source, d_t TargetVal,
+                                   const auto &Function) {
+      Records.emplace(Source, TargetVal, Function.get());
+    });
+    return Records;
+  }
+}; // Test Fixture
+
+TEST_P(JumpFunctionsTest, AddAndLookup) {
+  JumpFunctionsTy JF(LCAProblem->allTopFunction(), *LCAProblem, GetParam());
+  auto Id = EdgeIdentity<l_t>::getInstance();
+  d_t A = Insts[0];
+  d_t B = Insts[1];
+  n_t N = Insts[2];
+  JF.addFunction(A, N, B, Id);
+  JF.addFunction(B, N, B, Id);
+  // the all-top function is the implicit default and not stored
+  JF.addFunction(A, Insts[3], A, LCAProblem->allTopFunction());
+
+  auto Reverse = JF.reverseLookup(N, B);
+  ASSERT_TRUE(Reverse);
+  EXPECT_EQ(Reverse->get().size(), 2U);
+  auto Forward = JF.forwardLookup(A, N);
+  ASSERT_TRUE(Forward);
+  ASSERT_EQ(Forward->get().size(), 1U);
+  EXPECT_EQ(Forward->get().front().first, B);
+  EXPECT_FALSE(JF.reverseLookup(N, A));
+  EXPECT_FALSE(JF.forwardLookup(A, Insts[3]));
+  EXPECT_EQ(getRecordsByTarget(JF, N),
+            (std::set<Record>{{A, B, Id.get()}, {B, B, Id.get()}}));
+  EXPECT_TRUE(getRecordsByTarget(JF, Insts[3]).empty());
+}
+
+TEST_P(JumpFunctionsTest, AddOverwritesExistingFunction) {
+  JumpFunctionsTy JF(LCAProblem->allTopFunction(), *LCAProblem, GetParam());
+  auto Id = EdgeIdentity<l_t>::getInstance();
+  auto Bot = std::make_shared<AllBottom<l_t>>(
+      IDELinearConstantAnalysis::BOTTOM);
+  d_t A = Insts[0];
+  n_t N = Insts[1];
+  JF.addFunction(A, N, A, Id);
+  JF.addFunction(A, N, A, Bot);
+
+  auto Reverse = JF.reverseLookup(N, A);
+  ASSERT_TRUE(Reverse);
+  ASSERT_EQ(Reverse->get().size(), 1U);
+  EXPECT_EQ(Reverse->get().front().second, Bot);
+  auto Forward = JF.forwardLookup(A, N);
+  ASSERT_TRUE(Forward);
+  ASSERT_EQ(Forward->get().size(), 1U);
+  EXPECT_EQ(Forward->get().front().second, Bot);
+  EXPECT_EQ(getRecordsByTarget(JF, N),
+            (std::set<Record>{{A, A, Bot.get()}}));
+}
+
+TEST_P(JumpFunctionsTest, RemoveFunction) {
+  JumpFunctionsTy JF(LCAProblem->allTopFunction(), *LCAProblem, GetParam());
+  auto Id = EdgeIdentity<l_t>::getInstance();
+  d_t A = Insts[0];
+  d_t B = Insts[1];
+  n_t N = Insts[2];
+  JF.addFunction(A, N, B, Id);
+  JF.addFunction(B, N, B, Id);
+
+  EXPECT_TRUE(JF.removeFunction(A, N, B));
+  EXPECT_FALSE(JF.removeFunction(A, N, B));
+  auto Reverse = JF.reverseLookup(N, B);
+  ASSERT_TRUE(Reverse);
+  ASSERT_EQ(Reverse->get().size(), 1U);
+  EXPECT_EQ(Reverse->get().front().first, B);
+  auto Forward = JF.forwardLookup(A, N);
+  EXPECT_TRUE(!Forward || Forward->get().empty());
+  // only the removed record disappears from the records of the target
+  EXPECT_EQ(getRecordsByTarget(JF, N),
+            (std::set<Record>{{B, B, Id.get()}}));
+}
+
+TEST_P(JumpFunctionsTest, RemoveFunctionsAt) {
+  JumpFunctionsTy JF(LCAProblem->allTopFunction(), *LCAProblem, GetParam());
+  auto Id = EdgeIdentity<l_t>::getInstance();
+  d_t A = Insts[0];
+  d_t B = Insts[1];
+  n_t N = Insts[2];
+  n_t M = Insts[3];
+  JF.addFunction(A, N, A, Id);
+  JF.addFunction(A, N, B, Id);
+  JF.addFunction(B, N, B, Id);
+  JF.addFunction(A, M, B, Id);
+
+  EXPECT_EQ(JF.removeFunctionsAt(N), 3U);
+  EXPECT_EQ(JF.removeFunctionsAt(N), 0U);
+  EXPECT_FALSE(JF.reverseLookup(N, A));
+  EXPECT_FALSE(JF.reverseLookup(N, B));
+  EXPECT_FALSE(JF.forwardLookup(A, N));
+  EXPECT_FALSE(JF.forwardLookup(B, N));
+  EXPECT_TRUE(getRecordsByTarget(JF, N).empty());
+  // the jump functions of other targets are kept
+  EXPECT_EQ(getRecordsByTarget(JF, M),
+            (std::set<Record>{{A, B, Id.get()}}));
+  auto Forward = JF.forwardLookup(A, M);
+  ASSERT_TRUE(Forward);
+  EXPECT_EQ(Forward->get().size(), 1U);
+
+  // removed targets can be populated again
+  JF.addFunction(B, N, A, Id);
+  EXPECT_EQ(getRecordsByTarget(JF, N),
+            (std::set<Record>{{B, A, Id.get()}}));
+}
+
+TEST_P(JumpFunctionsTest, Clear) {
+  JumpFunctionsTy JF(LCAProblem->allTopFunction(), *LCAProblem, GetParam());
+  auto Id = EdgeIdentity<l_t>::getInstance();
+  for (size_t I = 1; I < Insts.size(); ++I) {
+    JF.addFunction(Insts[0], Insts[I], Insts[I - 1], Id);
+  }
+  JF.clear();
+  for (size_t I = 1; I < Insts.size(); ++I) {
+    EXPECT_FALSE(JF.reverseLookup(Insts[I], Insts[I - 1]));
+    EXPECT_FALSE(JF.forwardLookup(Insts[0], Insts[I]));
+    EXPECT_TRUE(getRecordsByTarget(JF, Insts[I]).empty());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Backends, JumpFunctionsTest, ::testing::Bool(),
+    [](const ::testing::TestParamInfo<bool> &Info) {
+      return std::string(Info.param ? "Dense" : "Tables");
+    });
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
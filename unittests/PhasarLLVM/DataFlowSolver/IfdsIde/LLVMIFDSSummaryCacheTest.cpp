@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMIFDSSummaryCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class LLVMIFDSSummaryCacheTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(LLVMIFDSSummaryCacheTest, SummaryCacheTest_07) {
+  unittest::TemporaryFile CacheFile(".summ");
+  // treat id() as a library function
+  auto IsLibraryFunction = [](const llvm::Function *F) {
+    return F->getName() == "_Z2idi";
+  };
+  initialize({PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  TaintProblem->getIFDSIDESolverConfig().setComputePersistedSummaries();
+  {
+    LLVMIFDSSummaryCache Cache("ifds-taint", CacheFile.path(),
+                               IsLibraryFunction);
+    CompactIFDSSolver_P<IFDSTaintAnalysis> Solver(*TaintProblem);
+    Solver.setSummaryCache(&Cache);
+    Solver.solve();
+    EXPECT_EQ(Cache.getNumHits(), 0U);
+    EXPECT_GT(Cache.size(), 0U);
+    ASSERT_TRUE(Cache.store());
+  }
+  EXPECT_EQ(TaintProblem->Leaks.size(), 1U);
+  // a later run on a fresh copy of the program does not descend into id()
+  ProjectIRDB LaterIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy LaterTH(LaterIRDB);
+  LLVMPointsToSet LaterPT(LaterIRDB);
+  LLVMBasedICFG LaterICFG(LaterIRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                          &LaterTH, &LaterPT);
+  IFDSTaintAnalysis LaterProblem(&LaterIRDB, &LaterTH, &LaterICFG, &LaterPT,
+                                 *TSF, EntryPoints);
+  LLVMIFDSSummaryCache Cache("ifds-taint", CacheFile.path(),
+                             IsLibraryFunction);
+  CompactIFDSSolver_P<IFDSTaintAnalysis> Solver(LaterProblem);
+  Solver.setSummaryCache(&Cache);
+  Solver.solve();
+  EXPECT_GT(Cache.getNumHits(), 0U);
+  for (const auto &Inst :
+       llvm::instructions(LaterIRDB.getFunctionDefinition("_Z2idi"))) {
+    EXPECT_TRUE(Solver.ifdsResultsAt(&Inst).empty());
+  }
+  EXPECT_EQ(LaterProblem.Leaks.size(), 1U);
+  // summaries of other analyses are not mixed up
+  LLVMIFDSSummaryCache OtherCache("other", CacheFile.path(),
+                                  IsLibraryFunction);
+  EXPECT_FALSE(OtherCache
+                   .lookup(LaterIRDB.getFunctionDefinition("_Z2idi"),
+                           LLVMZeroValue::getInstance())
+                   .has_value());
+}
+
+TEST_F(LLVMIFDSSummaryCacheTest, SummaryCacheTest_08_SideEffects) {
+  unittest::TemporaryFile CacheFile(".summ");
+  // treat report(), which calls the sink, as a library function
+  auto IsLibraryFunction = [](const llvm::Function *F) {
+    return F->getName() == "_Z6reporti";
+  };
+  initialize({PathToLlFiles + "dummy_source_sink/taint_08_main_cpp_dbg.ll",
+              PathToLlFiles + "dummy_source_sink/taint_08_lib_cpp_dbg.ll"});
+  TaintProblem->getIFDSIDESolverConfig().setComputePersistedSummaries();
+  {
+    LLVMIFDSSummaryCache Cache("ifds-taint", CacheFile.path(),
+                               IsLibraryFunction);
+    CompactIFDSSolver_P<IFDSTaintAnalysis> Solver(*TaintProblem);
+    Solver.setSummaryCache(&Cache);
+    Solver.solve();
+    // replaying a summary of report() would skip the leak in it
+    EXPECT_EQ(Cache.size(), 0U);
+    ASSERT_TRUE(Cache.store());
+  }
+  EXPECT_EQ(TaintProblem->Leaks.size(), 2U);
+  auto LaterProblem = makeTaintProblem();
+  LLVMIFDSSummaryCache Cache("ifds-taint", CacheFile.path(),
+                             IsLibraryFunction);
+  CompactIFDSSolver_P<IFDSTaintAnalysis> Solver(*LaterProblem);
+  Solver.setSummaryCache(&Cache);
+  Solver.solve();
+  EXPECT_EQ(Cache.getNumHits(), 0U);
+  EXPECT_EQ(LaterProblem->Leaks, TaintProblem->Leaks);
+}
+
+TEST_F(LLVMIFDSSummaryCacheTest, SummaryCacheTest_CorruptSizes) {
+  unittest::TemporaryFile CacheFile(".summ");
+  {
+    std::ofstream OS(CacheFile.path(), std::ios::binary);
+    OS.write("PSRSUMM", 8);
+    uint32_t Version = LLVMIFDSSummaryCache::FormatVersion;
+    OS.write(reinterpret_cast<const char *>(&Version), sizeof(Version));
+    uint64_t NumSummaries = 1;
+    OS.write(reinterpret_cast<const char *>(&NumSummaries),
+             sizeof(NumSummaries));
+    // an analysis ID that is longer than the rest of the file
+    uint32_t IDSize = 0xFFFFFFFF;
+    OS.write(reinterpret_cast<const char *>(&IDSize), sizeof(IDSize));
+    OS.write("ifds-taint", 10);
+  }
+  LLVMIFDSSummaryCache Cache("ifds-taint", CacheFile.path(),
+                             [](const llvm::Function *) { return true; });
+  EXPECT_FALSE(Cache.load());
+  EXPECT_EQ(Cache.size(), 0U);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
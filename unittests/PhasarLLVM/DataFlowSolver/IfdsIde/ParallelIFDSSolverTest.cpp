@@ -0,0 +1,170 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BottomUpIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+// Generates every alloca at its definition and propagates the values that
+// are stored to or loaded from a fact along with it. The flow functions only
+// read the IR, so that the problem is thread-safe unless it is asked to
+// record the threads that construct its flow functions.
+class AllocaFlowProblem : public IFDSSolverTest {
+public:
+  AllocaFlowProblem(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                    const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                    bool RecordThreads)
+      : IFDSSolverTest(IRDB, TH, ICF, PT, {"main"}),
+        RecordThreads(RecordThreads) {}
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    if (RecordThreads) {
+      Threads.insert(std::this_thread::get_id());
+    }
+    d_t Zero = getZeroValue();
+    return std::make_shared<LambdaFlow<d_t>>([Curr, Zero](d_t Source) {
+      std::set<d_t> Targets{Source};
+      if (Source == Zero && llvm::isa<llvm::AllocaInst>(Curr)) {
+        Targets.insert(Curr);
+      }
+      if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr);
+          Store && Store->getValueOperand() == Source) {
+        Targets.insert(Store->getPointerOperand());
+      }
+      if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr);
+          Load && Load->getPointerOperand() == Source) {
+        Targets.insert(Load);
+      }
+      return Targets;
+    });
+  }
+
+  bool isThreadSafe() const override { return !RecordThreads; }
+
+  // the threads that have constructed normal flow functions
+  std::set<std::thread::id> Threads;
+
+private:
+  bool RecordThreads;
+};
+
+} // anonymous namespace
+
+/* ============== TEST FIXTURE ============== */
+class ParallelIFDSSolverTest : public ::testing::TestWithParam<std::string> {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+
+  ProjectIRDB *IRDB = nullptr;
+  LLVMTypeHierarchy *TH = nullptr;
+  LLVMPointsToSet *PT = nullptr;
+  LLVMBasedICFG *ICFG = nullptr;
+
+  using ResultsTy = std::map<const llvm::Instruction *,
+                             std::set<IFDSSolverTest::d_t>>;
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    IRDB = new ProjectIRDB({PathToLlFiles + GetParam()}, IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    TH = new LLVMTypeHierarchy(*IRDB);
+    PT = new LLVMPointsToSet(*IRDB);
+    ICFG = new LLVMBasedICFG(*IRDB, CallGraphAnalysisType::OTF, {"main"}, TH,
+                             PT);
+  }
+
+  void TearDown() override {
+    delete ICFG;
+    delete PT;
+    delete TH;
+    delete IRDB;
+  }
+
+  // Solves Problem with SolverTy on NumThreads threads and returns the facts
+  // that hold at each instruction.
+  template <typename SolverTy>
+  ResultsTy solve(AllocaFlowProblem &Problem, unsigned NumThreads) {
+    Problem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    SolverTy Solver(Problem);
+    Solver.solve();
+    ResultsTy Results;
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(F)) {
+        Results[&Inst] = Solver.ifdsResultsAt(&Inst);
+      }
+    }
+    return Results;
+  }
+
+  template <typename SolverTy> void checkSameResultsAsSingleThreaded() {
+    AllocaFlowProblem Sequential(IRDB, TH, ICFG, PT, false);
+    AllocaFlowProblem Parallel(IRDB, TH, ICFG, PT, false);
+    auto Expected = solve<SolverTy>(Sequential, 1);
+    auto Results = solve<SolverTy>(Parallel, 4);
+    EXPECT_EQ(Parallel.getNumSolverThreads(), 4U);
+    EXPECT_EQ(Results, Expected);
+    size_t NumAllocaFacts = 0;
+    for (const auto &Entry : Results) {
+      for (const auto *Fact : Entry.second) {
+        NumAllocaFacts += llvm::isa<llvm::AllocaInst>(Fact);
+      }
+    }
+    EXPECT_GT(NumAllocaFacts, 0U);
+  }
+}; // Test Fixture
+
+TEST_P(ParallelIFDSSolverTest, IFDSSolverSameResultsAsSingleThreaded) {
+  checkSameResultsAsSingleThreaded<IFDSSolver<LLVMAnalysisDomainDefault>>();
+}
+
+TEST_P(ParallelIFDSSolverTest, BottomUpSameResultsAsSingleThreaded) {
+  checkSameResultsAsSingleThreaded<
+      BottomUpIFDSSolver<LLVMAnalysisDomainDefault>>();
+}
+
+TEST_P(ParallelIFDSSolverTest, NotThreadSafeProblemRunsOnOneThread) {
+  AllocaFlowProblem Expected(IRDB, TH, ICFG, PT, false);
+  AllocaFlowProblem Problem(IRDB, TH, ICFG, PT, true);
+  auto Results = solve<IFDSSolver<LLVMAnalysisDomainDefault>>(Problem, 4);
+  EXPECT_EQ(Problem.getNumSolverThreads(), 1U);
+  EXPECT_EQ(Problem.Threads, std::set<std::thread::id>{
+                                 std::this_thread::get_id()});
+  EXPECT_EQ(Results,
+            solve<IFDSSolver<LLVMAnalysisDomainDefault>>(Expected, 1));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    LinearConstantPrograms, ParallelIFDSSolverTest,
+    ::testing::Values("call_08_cpp_dbg.ll", "call_11_cpp_dbg.ll",
+                      "recursion_01_cpp_dbg.ll", "recursion_03_cpp_dbg.ll",
+                      "global_07_cpp_dbg.ll"),
+    [](const ::testing::TestParamInfo<std::string> &Info) {
+      return Info.param.substr(0, Info.param.find('.'));
+    });
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 
@@ -25,6 +26,7 @@
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 
+#include "ReportUtils.h"
 #include "TestConfig.h"
 
 using namespace psr;
@@ -517,6 +519,36 @@ TEST_F(IDEInstInteractionAnalysisTest, HandleHeap_01) {
 // }
 
 // main function for the test case/*  */
+/* ============== REPORT TESTS ============== */
+
+TEST_F(IDEInstInteractionAnalysisTest, HandleReportTest_01) {
+  IRDB = new ProjectIRDB({PathToLlFiles + "call_01_cpp.ll"}, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::CHA, EntryPoints, &TH,
+                     &PT);
+  using IIAProblemTy = IDEInstInteractionAnalysisT<std::string, true>;
+  IIAProblemTy IIAProblem(IRDB, &TH, &ICFG, &PT, EntryPoints);
+  IIAProblem.registerEdgeFactGenerator([](const llvm::Instruction *I) {
+    return std::set<std::string>{llvmIRToShortString(I)};
+  });
+  IDESolver_P<IIAProblemTy> IIASolver(IIAProblem);
+  IIASolver.solve();
+  auto SR = IIASolver.getSolverResults();
+  std::stringstream Report;
+  IIAProblem.emitTextReport(SR, Report);
+  auto Entries = unittest::parseTextReport(Report.str());
+  EXPECT_FALSE(Entries.empty());
+  // the report omits the facts whose values are bottom
+  const auto Bottom = IIAProblem.bottomElement();
+  EXPECT_EQ(Entries, unittest::expectedReportEntries(
+                         ICFG, IIAProblem, SR, true,
+                         [&Bottom](const IIAProblemTy::l_t &Value) {
+                           return !(Value == Bottom);
+                         }));
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
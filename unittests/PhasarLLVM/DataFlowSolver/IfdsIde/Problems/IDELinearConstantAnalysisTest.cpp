@@ -1,3 +1,4 @@
+#include <sstream>
 #include <tuple>
 
 #include "gtest/gtest.h"
@@ -10,6 +11,7 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 
+#include "ReportUtils.h"
 #include "TestConfig.h"
 
 using namespace psr;
@@ -29,7 +31,11 @@ protected:
   void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
 
   IDELinearConstantAnalysis::lca_results_t
-  doAnalysis(const std::string &LlvmFilePath, bool PrintDump = false) {
+  doAnalysis(const std::string &LlvmFilePath, bool PrintDump = false,
+             PathEdgeWorklistKind WorklistKind =
+                 PathEdgeWorklistKind::Recursive,
+             unsigned NumThreads = 1, bool MemoizeEdgeFunctions = false,
+             size_t MemoryBudget = 0) {
     IRDB = new ProjectIRDB({PathToLlFiles + LlvmFilePath}, IRDBOptions::WPA);
     ValueAnnotationPass::resetValueID();
     LLVMTypeHierarchy TH(*IRDB);
@@ -37,6 +43,11 @@ protected:
     LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
                        &PT);
     IDELinearConstantAnalysis LCAProblem(IRDB, &TH, &ICFG, &PT, EntryPoints);
+    LCAProblem.getIFDSIDESolverConfig().setPathEdgeWorklistKind(WorklistKind);
+    LCAProblem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    LCAProblem.getIFDSIDESolverConfig().setMemoizeEdgeFunctions(
+        MemoizeEdgeFunctions);
+    LCAProblem.getIFDSIDESolverConfig().setMemoryBudget(MemoryBudget);
     IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
     LCASolver.solve();
     if (PrintDump) {
@@ -623,6 +634,208 @@ TEST_F(IDELinearConstantAnalysisTest, HandleGlobalsTest_08) {
   compareResults(Results, GroundTruth);
 }
 
+/* ============== PATH-EDGE WORKLIST TESTS ============== */
+
+TEST_F(IDELinearConstantAnalysisTest, HandleWorklistFIFOTest_01) {
+  auto Results =
+      doAnalysis("call_08_cpp_dbg.ll", false, PathEdgeWorklistKind::FIFO);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z3fooii", 1, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 1, "b", 1);
+  GroundTruth.emplace("_Z3fooii", 2, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 2, "b", 1);
+  GroundTruth.emplace("main", 6, "i", 10);
+  GroundTruth.emplace("main", 7, "i", 10);
+  GroundTruth.emplace("main", 7, "j", 1);
+  GroundTruth.emplace("main", 10, "i", 10);
+  GroundTruth.emplace("main", 10, "j", 1);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleWorklistLIFOTest_01) {
+  auto Results =
+      doAnalysis("recursion_01_cpp_dbg.ll", false, PathEdgeWorklistKind::LIFO);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 10, "j", -1);
+  GroundTruth.emplace("main", 11, "j", -1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z9decrementi"].find(2) ==
+              Results["_Z9decrementi"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleWorklistRPOTest_01) {
+  auto Results = doAnalysis("recursion_03_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::ReversePostOrder);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+}
+
+/* ============== PARALLEL SOLVER TESTS ============== */
+
+TEST_F(IDELinearConstantAnalysisTest, HandleParallelTest_01) {
+  auto Results = doAnalysis("call_08_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 4);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z3fooii", 1, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 1, "b", 1);
+  GroundTruth.emplace("_Z3fooii", 2, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 2, "b", 1);
+  GroundTruth.emplace("main", 6, "i", 10);
+  GroundTruth.emplace("main", 7, "i", 10);
+  GroundTruth.emplace("main", 7, "j", 1);
+  GroundTruth.emplace("main", 10, "i", 10);
+  GroundTruth.emplace("main", 10, "j", 1);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleParallelTest_02) {
+  auto Results = doAnalysis("recursion_01_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 4);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 10, "j", -1);
+  GroundTruth.emplace("main", 11, "j", -1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z9decrementi"].find(2) ==
+              Results["_Z9decrementi"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleParallelTest_03) {
+  auto Results = doAnalysis("recursion_03_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 3);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+}
+
+/* ============== MEMOIZED EDGE FUNCTION TESTS ============== */
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoizedTest_01) {
+  auto Results = doAnalysis("basic_04_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 1, true);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 3, "i", 14);
+  GroundTruth.emplace("main", 4, "i", 14);
+  GroundTruth.emplace("main", 4, "j", 20);
+  GroundTruth.emplace("main", 5, "i", 14);
+  GroundTruth.emplace("main", 5, "j", 20);
+  GroundTruth.emplace("main", 6, "i", 14);
+  GroundTruth.emplace("main", 6, "j", 20);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoizedTest_02) {
+  auto Results = doAnalysis("call_08_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 4, true);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z3fooii", 1, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 1, "b", 1);
+  GroundTruth.emplace("_Z3fooii", 2, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 2, "b", 1);
+  GroundTruth.emplace("main", 6, "i", 10);
+  GroundTruth.emplace("main", 7, "i", 10);
+  GroundTruth.emplace("main", 7, "j", 1);
+  GroundTruth.emplace("main", 10, "i", 10);
+  GroundTruth.emplace("main", 10, "j", 1);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoizedTest_03) {
+  auto Results = doAnalysis("while_01_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 1, true);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+/* ============== MEMORY BUDGET TESTS ============== */
+
+// a budget of a single byte is always exceeded, such that all droppable jump
+// functions are dropped and recomputed in Phase II
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoryBudgetTest_01) {
+  auto Results = doAnalysis("call_08_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::FIFO, 1, false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z3fooii", 1, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 1, "b", 1);
+  GroundTruth.emplace("_Z3fooii", 2, "a", 10);
+  GroundTruth.emplace("_Z3fooii", 2, "b", 1);
+  GroundTruth.emplace("main", 6, "i", 10);
+  GroundTruth.emplace("main", 7, "i", 10);
+  GroundTruth.emplace("main", 7, "j", 1);
+  GroundTruth.emplace("main", 10, "i", 10);
+  GroundTruth.emplace("main", 10, "j", 1);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoryBudgetTest_02) {
+  auto Results = doAnalysis("basic_04_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::Recursive, 1, false, 1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 3, "i", 14);
+  GroundTruth.emplace("main", 4, "i", 14);
+  GroundTruth.emplace("main", 4, "j", 20);
+  GroundTruth.emplace("main", 5, "i", 14);
+  GroundTruth.emplace("main", 5, "j", 20);
+  GroundTruth.emplace("main", 6, "i", 14);
+  GroundTruth.emplace("main", 6, "j", 20);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleMemoryBudgetTest_03) {
+  auto Results = doAnalysis("while_01_cpp_dbg.ll", false,
+                            PathEdgeWorklistKind::ReversePostOrder, 1, false,
+                            1);
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+/* ============== REPORT TESTS ============== */
+
+TEST_F(IDELinearConstantAnalysisTest, HandleReportTest_01) {
+  // without debug info, the text report lists the raw results
+  IRDB = new ProjectIRDB({PathToLlFiles + "call_01_cpp.ll"}, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                     &PT);
+  IDELinearConstantAnalysis LCAProblem(IRDB, &TH, &ICFG, &PT, EntryPoints);
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+  auto SR = LCASolver.getSolverResults();
+  std::stringstream Report;
+  LCAProblem.emitTextReport(SR, Report);
+  auto Entries = unittest::parseTextReport(Report.str());
+  EXPECT_EQ(Entries, unittest::expectedReportEntries(
+                         ICFG, LCAProblem, SR, true, [](int64_t Value) {
+                           return Value != IDELinearConstantAnalysis::BOTTOM;
+                         }));
+  size_t NumConstants = 0;
+  for (const auto &[Stmt, StmtEntries] : Entries) {
+    for (const auto &Entry : StmtEntries) {
+      NumConstants += Entry.size() > 6 &&
+                      Entry.compare(Entry.size() - 6, 6, " -> 42") == 0;
+    }
+  }
+  EXPECT_GT(NumConstants, 0U);
+  std::stringstream Dump;
+  LCASolver.dumpResults(Dump);
+  EXPECT_EQ(unittest::parseResultsDump(Dump.str()),
+            unittest::expectedReportEntries(ICFG, LCAProblem, SR, false,
+                                            [](int64_t) { return true; }));
+}
+
 // main function for the test case/*  */
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
@@ -7,6 +7,8 @@
  *     Philipp Schubert, Fabian Schiebel and others
  *****************************************************************************/
 
+#include <sstream>
+
 #include "gtest/gtest.h"
 
 #include "phasar/DB/ProjectIRDB.h"
@@ -19,6 +21,8 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 
+#include "ReportUtils.h"
+
 using namespace psr;
 
 /* ============== TEST FIXTURE ============== */
@@ -145,6 +149,18 @@ TEST_F(IDETSAnalysisOpenSSLSecureHeapTest, Memory7) {
   compareResults(Gt);
 }
 
+TEST_F(IDETSAnalysisOpenSSLSecureHeapTest, Memory6_Report) {
+  initialize({PathToLlFiles + "memory6_c.ll"});
+  auto SR = SecureHeapPropagationResults->getSolverResults();
+  std::stringstream Report;
+  SecureHeapPropagationProblem->emitTextReport(SR, Report);
+  auto Entries = unittest::parseTextReport(Report.str());
+  EXPECT_FALSE(Entries.empty());
+  EXPECT_EQ(Entries, unittest::expectedReportEntries(
+                         *ICFG, *SecureHeapPropagationProblem, SR, true,
+                         [](IDESecureHeapPropagation::l_t) { return true; }));
+}
+
 int main(int Argc, char *Argv[]) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,103 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSFieldSensTaintAnalysis.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/InternedIFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "llvm/IR/InstIterator.h"
+#include "gtest/gtest.h"
+
+#include "TestConfig.h"
+
+using namespace std;
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class IFDSFieldSensTaintAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "taint_analysis/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB{};
+  LLVMTypeHierarchy *TH{};
+  LLVMBasedICFG *ICFG{};
+  LLVMPointsToInfo *PT{};
+  TaintConfiguration<ExtendedValue> *TSF{};
+
+  IFDSFieldSensTaintAnalysisTest() = default;
+  ~IFDSFieldSensTaintAnalysisTest() override = default;
+
+  void initialize(const std::vector<std::string> &IRFiles) {
+    IRDB = new ProjectIRDB(IRFiles, IRDBOptions::WPA);
+    TH = new LLVMTypeHierarchy(*IRDB);
+    PT = new LLVMPointsToSet(*IRDB);
+    ICFG = new LLVMBasedICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints, TH,
+                             PT);
+    // taint argc, which main() stores into a field of a struct
+    const auto *Main = ICFG->getFunction("main");
+    TSF = new TaintConfiguration<ExtendedValue>(
+        std::map<const llvm::Instruction *, std::set<ExtendedValue>>{
+            {&Main->front().front(), {ExtendedValue(&*Main->arg_begin())}}});
+  }
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void TearDown() override {
+    delete IRDB;
+    delete TH;
+    delete ICFG;
+    delete TSF;
+  }
+
+  /// Expects the interned solver to compute the same facts as the IFDSSolver
+  /// at every instruction, of which some are field sensitive.
+  void expectSameResultsAsIFDSSolver(bool BatchFlowFunctions) {
+    IFDSFieldSensTaintAnalysis ReferenceProblem(IRDB, TH, ICFG, PT, *TSF,
+                                                EntryPoints);
+    IFDSSolver_P<IFDSFieldSensTaintAnalysis> ReferenceSolver(ReferenceProblem);
+    ReferenceSolver.solve();
+    IFDSFieldSensTaintAnalysis TaintProblem(IRDB, TH, ICFG, PT, *TSF,
+                                            EntryPoints);
+    TaintProblem.getIFDSIDESolverConfig().setBatchFlowFunctions(
+        BatchFlowFunctions);
+    InternedIFDSSolver_P<IFDSFieldSensTaintAnalysis> TaintSolver(TaintProblem);
+    TaintSolver.solve();
+    size_t NumFieldFacts = 0;
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(F)) {
+        auto Facts = TaintSolver.ifdsResultsAt(&Inst);
+        EXPECT_EQ(Facts, ReferenceSolver.ifdsResultsAt(&Inst))
+            << "at " << llvmIRToString(&Inst);
+        for (const auto &Fact : Facts) {
+          NumFieldFacts += !Fact.getMemLocationSeq().empty();
+        }
+      }
+    }
+    EXPECT_GT(NumFieldFacts, 0U);
+  }
+}; // Test Fixture
+
+/* ============== INTERNED SOLVER TESTS ============== */
+
+TEST_F(IFDSFieldSensTaintAnalysisTest, InternedStructMember) {
+  initialize({PathToLlFiles + "struct_member_cpp.ll"});
+  expectSameResultsAsIFDSSolver(false);
+}
+
+TEST_F(IFDSFieldSensTaintAnalysisTest, InternedStructMember_Batch) {
+  initialize({PathToLlFiles + "struct_member_cpp.ll"});
+  expectSameResultsAsIFDSSolver(true);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
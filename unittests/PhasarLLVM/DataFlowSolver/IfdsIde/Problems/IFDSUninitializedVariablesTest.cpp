@@ -1,6 +1,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
@@ -388,6 +389,113 @@ TEST_F(IFDSUninitializedVariablesTest, UninitTest_21_SHOULD_LEAK) {
   // 37 => {17}; actual leak
   compareResults(GroundTruth);
 }
+
+/* ============== COMPACT IFDS SOLVER TESTS ============== */
+
+TEST_F(IFDSUninitializedVariablesTest, CompactUninitTest_02_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "binop_uninit_cpp_dbg.ll"});
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[6] = {"1"};
+  GroundTruth[7] = {"6"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, CompactUninitTest_20_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "recursion_cpp_dbg.ll"});
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[11] = {"2"};
+  GroundTruth[14] = {"2"};
+  GroundTruth[31] = {"24"};
+  GroundTruth[20] = {"1"};
+  GroundTruth[29] = {"28"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, CompactUninitTest_21_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "virtual_call_cpp_dbg.ll"});
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth = {
+      {3, {"0"}}, {8, {"5"}}, {10, {"5"}}, {35, {"34"}}, {37, {"17"}}};
+  compareResults(GroundTruth);
+}
+
+/* ============== SPARSE PROPAGATION TESTS ============== */
+
+TEST_F(IFDSUninitializedVariablesTest, SparseUninitTest_02_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "binop_uninit_cpp_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setSparsePropagation();
+  IFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[6] = {"1"};
+  GroundTruth[7] = {"6"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, SparseUninitTest_20_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "recursion_cpp_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setSparsePropagation();
+  IFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[11] = {"2"};
+  GroundTruth[14] = {"2"};
+  GroundTruth[31] = {"24"};
+  GroundTruth[20] = {"1"};
+  GroundTruth[29] = {"28"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, SparseUninitTest_21_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "virtual_call_cpp_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setSparsePropagation();
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth = {
+      {3, {"0"}}, {8, {"5"}}, {10, {"5"}}, {35, {"34"}}, {37, {"17"}}};
+  compareResults(GroundTruth);
+}
+
+/* ============== BIT-VECTOR TESTS ============== */
+
+TEST_F(IFDSUninitializedVariablesTest, BitVectorUninitTest_02_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "binop_uninit_cpp_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setBatchFlowFunctions();
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[6] = {"1"};
+  GroundTruth[7] = {"6"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, BitVectorUninitTest_20_SHOULD_LEAK) {
+  initialize({PathToLlFiles + "recursion_cpp_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setBatchFlowFunctions();
+  CompactIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[11] = {"2"};
+  GroundTruth[14] = {"2"};
+  GroundTruth[31] = {"24"};
+  GroundTruth[20] = {"1"};
+  GroundTruth[29] = {"28"};
+  compareResults(GroundTruth);
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,122 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/SmallFactSet.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "llvm/IR/InstIterator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+using FactSet = SmallFactSet<int, 2>;
+
+static std::vector<int> toVector(const FactSet &Facts) {
+  return std::vector<int>(Facts.begin(), Facts.end());
+}
+
+TEST(SmallFactSetTest, InsertKeepsFactsSortedAndUnique) {
+  FactSet Facts{3, 1, 3};
+  EXPECT_EQ(std::vector<int>({1, 3}), toVector(Facts));
+  EXPECT_TRUE(Facts.insert(2).second);
+  EXPECT_FALSE(Facts.insert(3).second);
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), toVector(Facts));
+  EXPECT_EQ(3U, Facts.size());
+  EXPECT_EQ(1U, Facts.count(2));
+  EXPECT_EQ(0U, Facts.count(4));
+  EXPECT_EQ(Facts.end(), Facts.find(0));
+  EXPECT_EQ(2, *Facts.find(2));
+}
+
+TEST(SmallFactSetTest, RangeInsertMatchesStdSet) {
+  std::set<int> Expected;
+  FactSet Facts;
+  std::vector<std::vector<int>> Ranges = {
+      {5}, {1, 9, 5}, {}, {7, 7, 0}, {12, 10, 11}, {-1, 20, 3, 4, 5}};
+  for (const auto &Range : Ranges) {
+    Expected.insert(Range.begin(), Range.end());
+    Facts.insert(Range.begin(), Range.end());
+    EXPECT_EQ(std::vector<int>(Expected.begin(), Expected.end()),
+              toVector(Facts));
+  }
+  FactSet FromSet(Expected.begin(), Expected.end());
+  EXPECT_EQ(Facts, FromSet);
+}
+
+TEST(SmallFactSetTest, EraseAndCompare) {
+  FactSet Facts{1, 2, 3};
+  EXPECT_EQ(1U, Facts.erase(2));
+  EXPECT_EQ(0U, Facts.erase(2));
+  EXPECT_EQ(FactSet({1, 3}), Facts);
+  EXPECT_NE(FactSet({1, 2}), Facts);
+  EXPECT_TRUE(FactSet({1, 2}) < Facts);
+  Facts.clear();
+  EXPECT_TRUE(Facts.empty());
+}
+
+TEST(SmallFactSetTest, FlowFunctions) {
+  using ContainerTy = SmallFactSet<int>;
+  auto Id = Identity<int, ContainerTy>::getInstance();
+  EXPECT_EQ(ContainerTy({4}), Id->computeTargets(4));
+  Gen<int, ContainerTy> GenFF(7, 0);
+  EXPECT_EQ(ContainerTy({0, 7}), GenFF.computeTargets(0));
+  EXPECT_EQ(ContainerTy({3}), GenFF.computeTargets(3));
+  GenIf<int, ContainerTy> GenIfFF(ContainerTy{1, 8},
+                                  [](int Source) { return Source == 5; });
+  EXPECT_EQ(ContainerTy({1, 5, 8}), GenIfFF.computeTargets(5));
+  Transfer<int, ContainerTy> TransferFF(2, 1);
+  EXPECT_EQ(ContainerTy({1, 2}), TransferFF.computeTargets(1));
+  EXPECT_TRUE(TransferFF.computeTargets(2).empty());
+  KillMultiple<int, ContainerTy> KillFF(std::set<int>{1, 2});
+  EXPECT_TRUE(KillFF.computeTargets(2).empty());
+  EXPECT_EQ(ContainerTy({3}), KillFF.computeTargets(3));
+  auto KillAllFF = KillAll<int, ContainerTy>::getInstance();
+  EXPECT_TRUE(KillAllFF->computeTargets(3).empty());
+}
+
+TEST(SmallFactSetTest, IFDSSolver) {
+  boost::log::core::get()->set_logging_enabled(false);
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles +
+                    "taint_analysis/dummy_source_sink/taint_07_cpp_dbg.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  IFDSSolverTest ReferenceProblem(&IRDB, &TH, &ICFG, &PT, {"main"});
+  IFDSSolver ReferenceSolver(ReferenceProblem);
+  ReferenceSolver.solve();
+  using ContainerTy = SmallFactSet<const llvm::Value *>;
+  IFDSSolverTestT<ContainerTy> Problem(&IRDB, &TH, &ICFG, &PT, {"main"});
+  IFDSSolver Solver(Problem);
+  static_assert(
+      std::is_same_v<decltype(Solver),
+                     IFDSSolver<LLVMAnalysisDomainDefault, ContainerTy>>);
+  Solver.solve();
+  size_t NumFacts = 0;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &Inst : llvm::instructions(F)) {
+      auto Facts = Solver.ifdsResultsAt(&Inst);
+      EXPECT_EQ(Facts, ReferenceSolver.ifdsResultsAt(&Inst))
+          << "at " << llvmIRToString(&Inst);
+      NumFacts += Facts.size();
+    }
+  }
+  EXPECT_GT(NumFacts, 0U);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,368 @@
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedBackwardICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BiDiIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+namespace {
+
+// the domain of the problems that are solved on the backward ICFG
+struct LLVMBackwardAnalysisDomain : public LLVMAnalysisDomainDefault {
+  using c_t = LLVMBasedBackwardCFG;
+  using i_t = LLVMBasedBackwardsICFG;
+};
+
+// Finds the values that the return values of the entry points depend on: an
+// instruction depends on its operands, a loaded value on the values stored
+// to its pointer, a call on the return values of its callees and formal
+// parameters on the actual arguments. It is solved backward from the returns
+// of the entry points.
+class ReturnValueSliceProblem
+    : public IFDSTabulationProblem<LLVMBackwardAnalysisDomain> {
+public:
+  ReturnValueSliceProblem(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                          const LLVMBasedBackwardsICFG *ICF,
+                          LLVMPointsToInfo *PT,
+                          std::set<std::string> EntryPoints)
+      : IFDSTabulationProblem(IRDB, TH, ICF, PT, std::move(EntryPoints)) {
+    ZeroValue = createZeroValue();
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    return std::make_shared<LambdaFlow<d_t>>([Curr](d_t Source) {
+      std::set<d_t> Targets;
+      // the definition of a value depends on its operands
+      if (Source == Curr) {
+        for (const auto &Op : Curr->operands()) {
+          if (isDependency(Op)) {
+            Targets.insert(Op);
+          }
+        }
+        return Targets;
+      }
+      Targets.insert(Source);
+      if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Curr);
+          Store && Store->getPointerOperand() == Source &&
+          isDependency(Store->getValueOperand())) {
+        Targets.insert(Store->getValueOperand());
+      }
+      return Targets;
+    });
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallStmt,
+                                          f_t DestFun) override {
+    std::set<d_t> ReturnValues;
+    for (const auto *Exit : ICF->getStartPointsOf(DestFun)) {
+      if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(Exit);
+          Ret && Ret->getReturnValue() &&
+          isDependency(Ret->getReturnValue())) {
+        ReturnValues.insert(Ret->getReturnValue());
+      }
+    }
+    return std::make_shared<LambdaFlow<d_t>>(
+        [this, CallStmt, ReturnValues](d_t Source) -> std::set<d_t> {
+          if (isZeroValue(Source)) {
+            return {Source};
+          }
+          if (Source == CallStmt) {
+            return ReturnValues;
+          }
+          return {};
+        });
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitStmt, n_t RetSite) override {
+    const auto *Call = llvm::cast<llvm::CallBase>(CallSite);
+    return std::make_shared<LambdaFlow<d_t>>(
+        [this, Call, CalleeFun](d_t Source) -> std::set<d_t> {
+          if (isZeroValue(Source)) {
+            return {Source};
+          }
+          const auto *Formal = llvm::dyn_cast<llvm::Argument>(Source);
+          if (Formal && Formal->getParent() == CalleeFun &&
+              Formal->getArgNo() < Call->arg_size() &&
+              isDependency(Call->getArgOperand(Formal->getArgNo()))) {
+            return {Call->getArgOperand(Formal->getArgNo())};
+          }
+          return {};
+        });
+  }
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               std::set<f_t> Callees) override {
+    bool HasDeclaredCallee = false;
+    for (const auto *Callee : Callees) {
+      HasDeclaredCallee |= Callee->isDeclaration();
+    }
+    const auto *Call = llvm::cast<llvm::CallBase>(CallSite);
+    return std::make_shared<LambdaFlow<d_t>>(
+        [Call, HasDeclaredCallee](d_t Source) {
+          std::set<d_t> Targets;
+          if (Source != Call) {
+            Targets.insert(Source);
+          } else if (HasDeclaredCallee) {
+            // the result of an unknown function depends on its arguments
+            for (const auto &Arg : Call->args()) {
+              if (isDependency(Arg)) {
+                Targets.insert(Arg);
+              }
+            }
+          }
+          return Targets;
+        });
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t CallStmt,
+                                             f_t DestFun) override {
+    return nullptr;
+  }
+
+  std::map<n_t, std::set<d_t>> initialSeeds() override {
+    std::map<n_t, std::set<d_t>> Seeds;
+    for (const auto &EntryPoint : EntryPoints) {
+      for (const auto *Exit : ICF->getStartPointsOf(
+               ICF->getFunction(EntryPoint))) {
+        auto &Facts = Seeds[Exit];
+        Facts.insert(getZeroValue());
+        if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(Exit);
+            Ret && Ret->getReturnValue() &&
+            isDependency(Ret->getReturnValue())) {
+          Facts.insert(Ret->getReturnValue());
+        }
+      }
+    }
+    return Seeds;
+  }
+
+  d_t createZeroValue() const override { return LLVMZeroValue::getInstance(); }
+
+  bool isZeroValue(d_t Fact) const override {
+    return LLVMZeroValue::getInstance()->isLLVMZeroValue(Fact);
+  }
+
+  void printNode(std::ostream &OS, n_t Stmt) const override {
+    OS << llvmIRToString(Stmt);
+  }
+
+  void printDataFlowFact(std::ostream &OS, d_t Fact) const override {
+    OS << llvmIRToString(Fact);
+  }
+
+  void printFunction(std::ostream &OS, f_t Fun) const override {
+    OS << Fun->getName().str();
+  }
+
+private:
+  static bool isDependency(const llvm::Value *V) {
+    return llvm::isa<llvm::Instruction>(V) || llvm::isa<llvm::Argument>(V);
+  }
+};
+
+// Taints the parameters of the entry points rather than the values that
+// the sources return.
+class ParameterTaintAnalysis : public IFDSTaintAnalysis {
+public:
+  using IFDSTaintAnalysis::IFDSTaintAnalysis;
+
+  std::map<n_t, std::set<d_t>> initialSeeds() override {
+    std::map<n_t, std::set<d_t>> Seeds;
+    for (const auto &EntryPoint : EntryPoints) {
+      const auto *Fun = ICF->getFunction(EntryPoint);
+      auto &Facts = Seeds[&Fun->front().front()];
+      Facts.insert(getZeroValue());
+      for (const auto &Arg : Fun->args()) {
+        Facts.insert(&Arg);
+      }
+    }
+    return Seeds;
+  }
+};
+
+} // anonymous namespace
+
+/* ============== TEST FIXTURE ============== */
+
+class BiDiIFDSSolverTest : public unittest::IFDSTaintAnalysisTestBase {
+protected:
+  using LeaksTy = std::unordered_map<const llvm::Instruction *,
+                                     std::set<const llvm::Value *>>;
+
+  // the functions the directions are seeded in, i.e. id() of taint_07
+  const std::set<std::string> SeedFunctions = {"_Z2idi"};
+
+  std::unique_ptr<LLVMBasedBackwardsICFG> BackwardICFG;
+
+  void initialize() {
+    IFDSTaintAnalysisTestBase::initialize(
+        {PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+    BackwardICFG = std::make_unique<LLVMBasedBackwardsICFG>(*ICFG);
+  }
+
+  void TearDown() override {
+    BackwardICFG.reset();
+    IFDSTaintAnalysisTestBase::TearDown();
+  }
+
+  std::unique_ptr<ParameterTaintAnalysis>
+  makeForwardProblem(const std::set<std::string> &Entries) const {
+    auto Problem = std::make_unique<ParameterTaintAnalysis>(IRDB, TH, ICFG, PT,
+                                                            *TSF, Entries);
+    Problem->getIFDSIDESolverConfig().setFollowReturnsPastSeeds(true);
+    return Problem;
+  }
+
+  std::unique_ptr<ReturnValueSliceProblem>
+  makeBackwardProblem(const std::set<std::string> &Entries) const {
+    auto Problem = std::make_unique<ReturnValueSliceProblem>(
+        IRDB, TH, BackwardICFG.get(), PT, Entries);
+    Problem->getIFDSIDESolverConfig().setFollowReturnsPastSeeds(true);
+    return Problem;
+  }
+
+  /// Returns the call of Callee in main.
+  [[nodiscard]] const llvm::CallBase *getCallInMain(llvm::StringRef Callee) {
+    for (const auto &Inst : llvm::instructions(ICFG->getFunction("main"))) {
+      if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst);
+          Call && Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == Callee) {
+        return Call;
+      }
+    }
+    return nullptr;
+  }
+}; // Test Fixture
+
+// Both directions start in id(): the forward direction with its tainted
+// parameter, the backward direction with its return value. Each returns to
+// the call of id() in main, where the forward direction hands the result of
+// the call and the backward direction the argument to the caller.
+TEST_F(BiDiIFDSSolverTest, BiDiTaintTest_07_LeaksMeetAtCallSite) {
+  initialize();
+  const auto *IdCall = getCallInMain("_Z2idi");
+  ASSERT_NE(IdCall, nullptr);
+  auto ForwardProblem = makeForwardProblem(SeedFunctions);
+  auto BackwardProblem = makeBackwardProblem(SeedFunctions);
+  BiDiIFDSSolver_P<ParameterTaintAnalysis, ReturnValueSliceProblem> Solver(
+      *ForwardProblem, *BackwardProblem);
+  Solver.solve();
+  EXPECT_EQ(Solver.getForwardLeaks(), LeaksTy({{IdCall, {IdCall}}}));
+  EXPECT_EQ(Solver.getBackwardLeaks(),
+            LeaksTy({{IdCall, {IdCall->getArgOperand(0)}}}));
+  // both directions reach the call of id(), so no return remains paused
+  EXPECT_EQ(Solver.getNumPausedReturns(), 0U);
+  // the taint reaches the sink in main ...
+  ASSERT_EQ(ForwardProblem->Leaks.size(), 1U);
+  for (const auto &[SinkCallSite, LeakedValues] : ForwardProblem->Leaks) {
+    EXPECT_EQ(SinkCallSite->getFunction()->getName(), "main");
+    EXPECT_FALSE(LeakedValues.empty());
+  }
+  // ... and the slice the variable that passes the result of source() to id()
+  const auto *SourceCall = getCallInMain("_Z6sourcev");
+  ASSERT_NE(SourceCall, nullptr);
+  ASSERT_TRUE(SourceCall->hasOneUse());
+  const auto *Store =
+      llvm::dyn_cast<llvm::StoreInst>(*SourceCall->user_begin());
+  ASSERT_NE(Store, nullptr);
+  EXPECT_TRUE(
+      Solver.backwardResultsAt(Store).count(Store->getPointerOperand()));
+  // each direction computes what it computes on its own
+  auto ReferenceForwardProblem = makeForwardProblem(SeedFunctions);
+  IFDSSolver_P<ParameterTaintAnalysis> ReferenceForwardSolver(
+      *ReferenceForwardProblem);
+  ReferenceForwardSolver.solve();
+  auto ReferenceBackwardProblem = makeBackwardProblem(SeedFunctions);
+  IFDSSolver_P<ReturnValueSliceProblem> ReferenceBackwardSolver(
+      *ReferenceBackwardProblem);
+  ReferenceBackwardSolver.solve();
+  expectSameResults(
+      *IRDB,
+      [&Solver](const llvm::Instruction *Inst) {
+        return Solver.forwardResultsAt(Inst);
+      },
+      resultsOf(ReferenceForwardSolver));
+  expectSameResults(
+      *IRDB,
+      [&Solver](const llvm::Instruction *Inst) {
+        return Solver.backwardResultsAt(Inst);
+      },
+      resultsOf(ReferenceBackwardSolver));
+  EXPECT_EQ(ForwardProblem->Leaks, ReferenceForwardProblem->Leaks);
+}
+
+TEST_F(BiDiIFDSSolverTest, BiDiTaintTest_07_PausedWithoutBackwardDirection) {
+  initialize();
+  const auto *IdCall = getCallInMain("_Z2idi");
+  ASSERT_NE(IdCall, nullptr);
+  auto ForwardProblem = makeForwardProblem(SeedFunctions);
+  // the backward direction has no seeds and never reaches main()
+  auto BackwardProblem = makeBackwardProblem({});
+  BiDiIFDSSolver_P<ParameterTaintAnalysis, ReturnValueSliceProblem> Solver(
+      *ForwardProblem, *BackwardProblem);
+  Solver.solve();
+  // the forward direction tries to hand the result of the call to main(),
+  // but its returns, of the zero value and of the taint, stay paused
+  EXPECT_EQ(Solver.getForwardLeaks(), LeaksTy({{IdCall, {IdCall}}}));
+  EXPECT_TRUE(Solver.getBackwardLeaks().empty());
+  EXPECT_GT(Solver.getNumPausedZeroReturns(), 0U);
+  EXPECT_EQ(Solver.getNumPausedReturns(),
+            Solver.getNumPausedZeroReturns() + 1);
+  for (const auto &Inst : llvm::instructions(ICFG->getFunction("main"))) {
+    EXPECT_TRUE(Solver.forwardResultsAt(&Inst).empty())
+        << "at " << llvmIRToString(&Inst);
+  }
+  EXPECT_TRUE(ForwardProblem->Leaks.empty());
+}
+
+TEST_F(BiDiIFDSSolverTest, BiDiTaintTest_07_PausedWithoutForwardDirection) {
+  initialize();
+  const auto *IdCall = getCallInMain("_Z2idi");
+  ASSERT_NE(IdCall, nullptr);
+  // the forward direction has no seeds and never reaches main()
+  auto ForwardProblem = makeForwardProblem({});
+  auto BackwardProblem = makeBackwardProblem(SeedFunctions);
+  BiDiIFDSSolver_P<ParameterTaintAnalysis, ReturnValueSliceProblem> Solver(
+      *ForwardProblem, *BackwardProblem);
+  Solver.solve();
+  EXPECT_TRUE(Solver.getForwardLeaks().empty());
+  EXPECT_EQ(Solver.getBackwardLeaks(),
+            LeaksTy({{IdCall, {IdCall->getArgOperand(0)}}}));
+  EXPECT_EQ(Solver.getNumPausedReturns(),
+            Solver.getNumPausedZeroReturns() + 1);
+  for (const auto &Inst : llvm::instructions(ICFG->getFunction("main"))) {
+    EXPECT_TRUE(Solver.backwardResultsAt(&Inst).empty())
+        << "at " << llvmIRToString(&Inst);
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
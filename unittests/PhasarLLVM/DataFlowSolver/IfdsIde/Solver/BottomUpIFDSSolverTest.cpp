@@ -0,0 +1,70 @@
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BottomUpIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+namespace {
+
+// summarizes the functions for their formal parameters as well
+template <typename AnalysisDomainTy>
+class FormalsBottomUpIFDSSolver : public BottomUpIFDSSolver<AnalysisDomainTy> {
+public:
+  using BottomUpIFDSSolver<AnalysisDomainTy>::BottomUpIFDSSolver;
+
+protected:
+  using typename BottomUpIFDSSolver<AnalysisDomainTy>::d_t;
+  using typename BottomUpIFDSSolver<AnalysisDomainTy>::f_t;
+
+  std::set<d_t> getSummaryEntryFacts(f_t Fun) override {
+    std::set<d_t> Formals;
+    for (const auto &Arg : Fun->args()) {
+      Formals.insert(&Arg);
+    }
+    return Formals;
+  }
+};
+
+} // anonymous namespace
+
+/* ============== TEST FIXTURE ============== */
+
+class BottomUpIFDSSolverTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(BottomUpIFDSSolverTest, BottomUpTaintTest_04) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  BottomUpIFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  EXPECT_GT(TaintSolver.getNumSCCs(), 1U);
+  EXPECT_GT(TaintSolver.getNumSummaries(), 0U);
+}
+
+TEST_F(BottomUpIFDSSolverTest, BottomUpTaintTest_07_SameResultsAsCompact) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  auto ReferenceProblem = makeTaintProblem();
+  CompactIFDSSolver_P<IFDSTaintAnalysis> CompactTaintSolver(*ReferenceProblem);
+  CompactTaintSolver.solve();
+  TaintProblem->getIFDSIDESolverConfig().setNumThreads(4);
+  FormalsBottomUpIFDSSolver<IFDSTaintAnalysis::ProblemAnalysisDomain>
+      TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  // source() is summarized for zero and id() for zero and its parameter,
+  // but sink() is not, as the leaks are its side effects
+  EXPECT_GT(TaintSolver.getNumSummaries(), 2U);
+  expectSameResults(*IRDB, resultsOf(TaintSolver),
+                    resultsOf(CompactTaintSolver));
+  EXPECT_EQ(TaintProblem->Leaks.size(), 1U);
+  EXPECT_EQ(TaintProblem->Leaks, ReferenceProblem->Leaks);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DemandDrivenIFDSSolver.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class DemandDrivenIFDSSolverTest
+    : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(DemandDrivenIFDSSolverTest, DemandDrivenTaintTest_04) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  DemandDrivenIFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  auto SinkCallSites = TaintProblem->getSinkCallSites();
+  EXPECT_EQ(SinkCallSites.size(), 2U);
+  TaintSolver.demand({SinkCallSites.begin(), SinkCallSites.end()});
+  EXPECT_EQ(TaintProblem->Leaks.size(), 2U);
+  for (const auto &[SinkCallSite, LeakedValues] : TaintProblem->Leaks) {
+    for (const auto *LeakedValue : LeakedValues) {
+      EXPECT_TRUE(TaintSolver.holdsAt(SinkCallSite, LeakedValue));
+    }
+  }
+}
+
+TEST_F(DemandDrivenIFDSSolverTest,
+       DemandDrivenTaintTest_05_SameResultsAsCompact) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  // the reference solver records its leaks in a problem of its own
+  auto ReferenceProblem = makeTaintProblem();
+  CompactIFDSSolver_P<IFDSTaintAnalysis> CompactTaintSolver(*ReferenceProblem);
+  CompactTaintSolver.solve();
+  DemandDrivenIFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  auto SinkCallSites = TaintProblem->getSinkCallSites();
+  TaintSolver.demand({SinkCallSites.begin(), SinkCallSites.end()});
+  expectSameResults(*IRDB, resultsOf(TaintSolver),
+                    resultsOf(CompactTaintSolver),
+                    [&TaintSolver](const llvm::Instruction *Inst) {
+                      return TaintSolver.isDemanded(Inst);
+                    });
+  size_t NumInsts = 0;
+  for (const auto *F : IRDB->getAllFunctions()) {
+    NumInsts += F->getInstructionCount();
+  }
+  // nothing after the last sink call has to be analyzed
+  size_t NumDemanded = TaintSolver.getNumDemandedNodes();
+  EXPECT_LT(NumDemanded, NumInsts);
+  // queries are answered from the memoized results
+  for (const auto *SinkCallSite : SinkCallSites) {
+    TaintSolver.query(SinkCallSite);
+  }
+  EXPECT_EQ(TaintSolver.getNumDemandedNodes(), NumDemanded);
+  compareResults({{22, {"21"}}});
+}
+
+TEST_F(DemandDrivenIFDSSolverTest, DemandDrivenTaintTest_06_Analysis) {
+  ProjectIRDB DDIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_06_cpp_m2r_dbg.ll"},
+      IRDBOptions::WPA);
+  DemandDrivenAnalysis<IFDSTaintAnalysis> DDA(
+      DDIRDB, unittest::makeSourceSinkTaintConfig(), EntryPoints);
+  auto SinkCallSites = DDA.getProblem().getSinkCallSites();
+  ASSERT_EQ(SinkCallSites.size(), 1U);
+  auto Facts = DDA.query(*SinkCallSites.begin());
+  ASSERT_EQ(DDA.getProblem().Leaks.size(), 1U);
+  const auto &[SinkCallSite, LeakedValues] = *DDA.getProblem().Leaks.begin();
+  EXPECT_EQ(getMetaDataID(SinkCallSite), "5");
+  for (const auto *LeakedValue : LeakedValues) {
+    EXPECT_EQ(getMetaDataID(LeakedValue), "main.0");
+    EXPECT_TRUE(Facts.count(LeakedValue));
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
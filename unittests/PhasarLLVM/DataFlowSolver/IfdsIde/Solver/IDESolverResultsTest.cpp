@@ -0,0 +1,78 @@
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class IDESolverResultsTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(IDESolverResultsTest, StreamingResultsTest_05) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  // the visitors are checked against the results of a solver of their own
+  auto ReferenceProblem = makeTaintProblem();
+  CompactIFDSSolver_P<IFDSTaintAnalysis> ReferenceSolver(*ReferenceProblem);
+  ReferenceSolver.solve();
+  IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  // IFDSSolver only records facts at calls and start points that are
+  // reached from zero in its second phase
+  auto IsCompared = [this](const llvm::Instruction *Inst) {
+    return !ICFG->isCallStmt(Inst) && !ICFG->isStartPoint(Inst);
+  };
+  size_t NumExpected = 0;
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &Inst : llvm::instructions(F)) {
+      if (!IsCompared(&Inst)) {
+        continue;
+      }
+      auto Expected = ReferenceSolver.ifdsResultsAt(&Inst);
+      NumExpected += Expected.size();
+      for (bool StripZero : {false, true}) {
+        if (StripZero) {
+          Expected.erase(ReferenceProblem->getZeroValue());
+        }
+        std::vector<const llvm::Value *> Visited;
+        TaintSolver.foreachResultAt(
+            &Inst,
+            [&Visited](const llvm::Value *Fact, const BinaryDomain &) {
+              Visited.push_back(Fact);
+            },
+            StripZero);
+        EXPECT_EQ(Visited.size(), Expected.size())
+            << "at " << llvmIRToString(&Inst);
+        EXPECT_EQ(std::set<const llvm::Value *>(Visited.begin(), Visited.end()),
+                  Expected)
+            << "at " << llvmIRToString(&Inst);
+      }
+    }
+  }
+  size_t NumVisited = 0;
+  TaintSolver.foreachResult([&](const llvm::Instruction *Inst,
+                                const llvm::Value *Fact, const BinaryDomain &) {
+    if (IsCompared(Inst)) {
+      ++NumVisited;
+      EXPECT_TRUE(ReferenceSolver.ifdsResultsAt(Inst).count(Fact))
+          << "at " << llvmIRToString(Inst);
+    }
+  });
+  EXPECT_GT(NumExpected, 0U);
+  EXPECT_EQ(NumVisited, NumExpected);
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
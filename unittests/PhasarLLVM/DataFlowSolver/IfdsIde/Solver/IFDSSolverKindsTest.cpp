@@ -0,0 +1,230 @@
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BottomUpIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DemandDrivenIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/InternedIFDSSolver.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+// the solvers and solver configurations the taint analysis is run with in
+// addition to the default IFDSSolver
+enum class TaintSolverKind {
+  BoundedCache,
+  BatchFIFO,
+  BatchLIFO,
+  BatchRPO,
+  Sparse,
+  DenseJumpFunctions,
+  Compact,
+  CompactBatch,
+  CompactSparse,
+  Interned,
+  BottomUp,
+  DemandDriven
+};
+
+std::string toString(TaintSolverKind Kind) {
+  switch (Kind) {
+  case TaintSolverKind::BoundedCache:
+    return "BoundedCache";
+  case TaintSolverKind::BatchFIFO:
+    return "BatchFIFO";
+  case TaintSolverKind::BatchLIFO:
+    return "BatchLIFO";
+  case TaintSolverKind::BatchRPO:
+    return "BatchRPO";
+  case TaintSolverKind::Sparse:
+    return "Sparse";
+  case TaintSolverKind::DenseJumpFunctions:
+    return "DenseJumpFunctions";
+  case TaintSolverKind::Compact:
+    return "Compact";
+  case TaintSolverKind::CompactBatch:
+    return "CompactBatch";
+  case TaintSolverKind::CompactSparse:
+    return "CompactSparse";
+  case TaintSolverKind::Interned:
+    return "Interned";
+  case TaintSolverKind::BottomUp:
+    return "BottomUp";
+  case TaintSolverKind::DemandDriven:
+    return "DemandDriven";
+  }
+  return "unknown";
+}
+
+std::ostream &operator<<(std::ostream &OS, TaintSolverKind Kind) {
+  return OS << toString(Kind);
+}
+
+// a test program and the leaks that are to be found in it
+struct TaintTestCase {
+  std::string Name;
+  std::string File;
+  std::map<int, std::set<std::string>> GroundTruth;
+};
+
+std::ostream &operator<<(std::ostream &OS, const TaintTestCase &TC) {
+  return OS << TC.Name;
+}
+
+const std::vector<TaintTestCase> TaintTestCases = {
+    {"taint_01", "dummy_source_sink/taint_01_cpp_dbg.ll", {{13, {"12"}}}},
+    {"taint_01_m2r", "dummy_source_sink/taint_01_cpp_m2r_dbg.ll", {{4, {"2"}}}},
+    {"taint_02", "dummy_source_sink/taint_02_cpp_dbg.ll", {{9, {"8"}}}},
+    {"taint_03", "dummy_source_sink/taint_03_cpp_dbg.ll", {{18, {"17"}}}},
+    {"taint_04",
+     "dummy_source_sink/taint_04_cpp_dbg.ll",
+     {{19, {"18"}}, {24, {"23"}}}},
+    {"taint_05", "dummy_source_sink/taint_05_cpp_dbg.ll", {{22, {"21"}}}},
+    {"taint_06",
+     "dummy_source_sink/taint_06_cpp_m2r_dbg.ll",
+     {{5, {"main.0"}}}},
+};
+
+/* ============== TEST FIXTURE ============== */
+
+class IFDSSolverKindsTest : public unittest::IFDSTaintAnalysisTestBase {
+protected:
+  template <typename SolverTy>
+  static ResultsFn solveWith(IFDSTaintAnalysis &Problem) {
+    auto Solver = std::make_shared<SolverTy>(Problem);
+    Solver->solve();
+    return [Solver](const llvm::Instruction *Inst) {
+      return Solver->ifdsResultsAt(Inst);
+    };
+  }
+
+  /// Solves Problem with the given kind of solver and returns its results.
+  static ResultsFn solve(TaintSolverKind Kind, IFDSTaintAnalysis &Problem) {
+    auto &Config = Problem.getIFDSIDESolverConfig();
+    switch (Kind) {
+    case TaintSolverKind::BoundedCache:
+      Config.setFlowEdgeFunctionCacheCapacity(2);
+      return solveWith<IFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::BatchFIFO:
+    case TaintSolverKind::BatchLIFO:
+    case TaintSolverKind::BatchRPO:
+      Config.setBatchFlowFunctions();
+      Config.setPathEdgeWorklistKind(
+          Kind == TaintSolverKind::BatchFIFO   ? PathEdgeWorklistKind::FIFO
+          : Kind == TaintSolverKind::BatchLIFO ? PathEdgeWorklistKind::LIFO
+                                               : PathEdgeWorklistKind::
+                                                     ReversePostOrder);
+      return solveWith<IFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::Sparse:
+      Config.setSparsePropagation();
+      return solveWith<IFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::DenseJumpFunctions:
+      Config.setDenseJumpFunctions();
+      return solveWith<IFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::Compact:
+      return solveWith<CompactIFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::CompactBatch:
+      Config.setBatchFlowFunctions();
+      return solveWith<CompactIFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::CompactSparse:
+      Config.setSparsePropagation();
+      return solveWith<CompactIFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::Interned:
+      return solveWith<InternedIFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::BottomUp:
+      return solveWith<BottomUpIFDSSolver_P<IFDSTaintAnalysis>>(Problem);
+    case TaintSolverKind::DemandDriven: {
+      auto Solver =
+          std::make_shared<DemandDrivenIFDSSolver_P<IFDSTaintAnalysis>>(
+              Problem);
+      auto SinkCallSites = Problem.getSinkCallSites();
+      Solver->demand({SinkCallSites.begin(), SinkCallSites.end()});
+      return [Solver](const llvm::Instruction *Inst) {
+        return Solver->ifdsResultsAt(Inst);
+      };
+    }
+    }
+    return nullptr;
+  }
+}; // Test Fixture
+
+class IFDSTaintSolverTest
+    : public IFDSSolverKindsTest,
+      public ::testing::WithParamInterface<
+          std::tuple<TaintSolverKind, TaintTestCase>> {};
+
+TEST_P(IFDSTaintSolverTest, FindsLeaks) {
+  const auto &[Kind, TC] = GetParam();
+  initialize({PathToLlFiles + TC.File});
+  auto Results = solve(Kind, *TaintProblem);
+  compareResults(TC.GroundTruth);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SolverKinds, IFDSTaintSolverTest,
+    ::testing::Combine(
+        ::testing::Values(
+            TaintSolverKind::BoundedCache, TaintSolverKind::BatchFIFO,
+            TaintSolverKind::BatchLIFO, TaintSolverKind::BatchRPO,
+            TaintSolverKind::Sparse, TaintSolverKind::DenseJumpFunctions,
+            TaintSolverKind::Compact, TaintSolverKind::CompactBatch,
+            TaintSolverKind::CompactSparse, TaintSolverKind::Interned,
+            TaintSolverKind::BottomUp, TaintSolverKind::DemandDriven),
+        ::testing::ValuesIn(TaintTestCases)),
+    [](const ::testing::TestParamInfo<IFDSTaintSolverTest::ParamType> &Info) {
+      return toString(std::get<0>(Info.param)) + "_" +
+             std::get<1>(Info.param).Name;
+    });
+
+// the solvers that compute the same facts as IFDSSolver; the sparse and
+// demand-driven ones compute subsets, see their own tests
+class IFDSTaintSameResultsTest
+    : public IFDSSolverKindsTest,
+      public ::testing::WithParamInterface<TaintSolverKind> {};
+
+TEST_P(IFDSTaintSameResultsTest, SameResultsAsIFDSSolver) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  auto ReferenceProblem = makeTaintProblem();
+  IFDSSolver_P<IFDSTaintAnalysis> ReferenceSolver(*ReferenceProblem);
+  ReferenceSolver.solve();
+  auto Results = solve(GetParam(), *TaintProblem);
+  bool TabulatesAllFacts = GetParam() == TaintSolverKind::Compact ||
+                           GetParam() == TaintSolverKind::CompactBatch ||
+                           GetParam() == TaintSolverKind::BottomUp;
+  expectSameResults(*IRDB, Results, resultsOf(ReferenceSolver),
+                    [&](const llvm::Instruction *Inst) {
+                      // IFDSSolver only records facts at calls and start
+                      // points that are reached from zero in its second phase
+                      return !TabulatesAllFacts ||
+                             (!ICFG->isCallStmt(Inst) &&
+                              !ICFG->isStartPoint(Inst));
+                    });
+  EXPECT_EQ(TaintProblem->Leaks, ReferenceProblem->Leaks);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SolverKinds, IFDSTaintSameResultsTest,
+    ::testing::Values(TaintSolverKind::BoundedCache, TaintSolverKind::BatchFIFO,
+                      TaintSolverKind::BatchLIFO, TaintSolverKind::BatchRPO,
+                      TaintSolverKind::DenseJumpFunctions,
+                      TaintSolverKind::Compact, TaintSolverKind::CompactBatch,
+                      TaintSolverKind::Interned, TaintSolverKind::BottomUp),
+    [](const ::testing::TestParamInfo<TaintSolverKind> &Info) {
+      return toString(Info.param);
+    });
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
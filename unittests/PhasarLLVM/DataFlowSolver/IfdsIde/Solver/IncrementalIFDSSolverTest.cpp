@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMProgramVersionMapping.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IncrementalIFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class IncrementalIFDSSolverTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(IncrementalIFDSSolverTest, IncrementalTaintTest_07) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> PreviousSolver(*TaintProblem);
+  PreviousSolver.solve();
+  // the updated version only changes main
+  ProjectIRDB UpdatedIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_update_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy UpdatedTH(UpdatedIRDB);
+  LLVMPointsToSet UpdatedPT(UpdatedIRDB);
+  LLVMBasedICFG UpdatedICFG(UpdatedIRDB, CallGraphAnalysisType::OTF,
+                            EntryPoints, &UpdatedTH, &UpdatedPT);
+  LLVMProgramVersionMapping Mapping(*IRDB, UpdatedIRDB, *PT, UpdatedPT);
+  EXPECT_TRUE(Mapping.getChangedFunctions().count("main"));
+  EXPECT_FALSE(Mapping.getChangedFunctions().count("_Z2idi"));
+  IFDSTaintAnalysis UpdatedProblem(&UpdatedIRDB, &UpdatedTH, &UpdatedICFG,
+                                   &UpdatedPT, *TSF, EntryPoints);
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> UpdatedSolver(
+      UpdatedProblem, PreviousSolver, Mapping);
+  UpdatedSolver.solve();
+  EXPECT_GT(UpdatedSolver.getNumReusedContexts(), 0U);
+  // same results as solving the updated version from scratch
+  IFDSTaintAnalysis FreshProblem(&UpdatedIRDB, &UpdatedTH, &UpdatedICFG,
+                                 &UpdatedPT, *TSF, EntryPoints);
+  CompactIFDSSolver_P<IFDSTaintAnalysis> FreshSolver(FreshProblem);
+  FreshSolver.solve();
+  expectSameResults(UpdatedIRDB, resultsOf(UpdatedSolver),
+                    resultsOf(FreshSolver));
+  EXPECT_EQ(UpdatedProblem.Leaks, FreshProblem.Leaks);
+  EXPECT_EQ(UpdatedProblem.Leaks.size(), 1U);
+}
+
+TEST_F(IncrementalIFDSSolverTest, IncrementalTaintTest_07_PointsToChanged) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> PreviousSolver(*TaintProblem);
+  PreviousSolver.solve();
+  ProjectIRDB UpdatedIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_update_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy UpdatedTH(UpdatedIRDB);
+  LLVMPointsToSet UpdatedPT(UpdatedIRDB);
+  // the code of id() is unchanged, but one of its pointers gains an alias
+  const auto *IdAlloca =
+      &*llvm::inst_begin(UpdatedIRDB.getFunctionDefinition("_Z2idi"));
+  const auto *MainAlloca =
+      &*llvm::inst_begin(UpdatedIRDB.getFunctionDefinition("main"));
+  UpdatedPT.introduceAlias(IdAlloca, MainAlloca);
+  LLVMBasedICFG UpdatedICFG(UpdatedIRDB, CallGraphAnalysisType::OTF,
+                            EntryPoints, &UpdatedTH, &UpdatedPT);
+  LLVMProgramVersionMapping Mapping(*IRDB, UpdatedIRDB, *PT, UpdatedPT);
+  EXPECT_TRUE(Mapping.getChangedFunctions().count("_Z2idi"));
+  EXPECT_FALSE(
+      Mapping.mapFunction(IRDB->getFunctionDefinition("_Z2idi")).has_value());
+  IFDSTaintAnalysis UpdatedProblem(&UpdatedIRDB, &UpdatedTH, &UpdatedICFG,
+                                   &UpdatedPT, *TSF, EntryPoints);
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> UpdatedSolver(
+      UpdatedProblem, PreviousSolver, Mapping);
+  UpdatedSolver.solve();
+  IFDSTaintAnalysis FreshProblem(&UpdatedIRDB, &UpdatedTH, &UpdatedICFG,
+                                 &UpdatedPT, *TSF, EntryPoints);
+  CompactIFDSSolver_P<IFDSTaintAnalysis> FreshSolver(FreshProblem);
+  FreshSolver.solve();
+  expectSameResults(UpdatedIRDB, resultsOf(UpdatedSolver),
+                    resultsOf(FreshSolver));
+  EXPECT_EQ(UpdatedProblem.Leaks, FreshProblem.Leaks);
+}
+
+TEST_F(IncrementalIFDSSolverTest, IncrementalTaintTest_07_IgnoredPointsTo) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"});
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> PreviousSolver(*TaintProblem);
+  PreviousSolver.solve();
+  ProjectIRDB UpdatedIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_update_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy UpdatedTH(UpdatedIRDB);
+  LLVMPointsToSet UpdatedPT(UpdatedIRDB);
+  LLVMBasedICFG UpdatedICFG(UpdatedIRDB, CallGraphAnalysisType::OTF,
+                            EntryPoints, &UpdatedTH, &UpdatedPT);
+  // the taint analysis queries points-to information the mapping ignores
+  LLVMProgramVersionMapping Mapping(*IRDB, UpdatedIRDB);
+  EXPECT_FALSE(Mapping.comparesPointsToInfo());
+  IFDSTaintAnalysis UpdatedProblem(&UpdatedIRDB, &UpdatedTH, &UpdatedICFG,
+                                   &UpdatedPT, *TSF, EntryPoints);
+  IncrementalIFDSSolver_P<IFDSTaintAnalysis> UpdatedSolver(
+      UpdatedProblem, PreviousSolver, Mapping);
+  UpdatedSolver.solve();
+  EXPECT_EQ(UpdatedSolver.getNumReusableFunctions(), 0U);
+  EXPECT_EQ(UpdatedSolver.getNumReusedContexts(), 0U);
+  EXPECT_EQ(UpdatedProblem.Leaks.size(), 1U);
+}
+
+TEST_F(IncrementalIFDSSolverTest, IncrementalTaintTest_07_Analysis) {
+  ProjectIRDB PreviousIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  IncrementalUpdateAnalysis<IFDSTaintAnalysis> IUA(
+      PreviousIRDB, unittest::makeSourceSinkTaintConfig(), EntryPoints);
+  IUA.solve();
+  EXPECT_EQ(IUA.getProblem().Leaks.size(), 1U);
+  ProjectIRDB UpdatedIRDB(
+      {PathToLlFiles + "dummy_source_sink/taint_07_update_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  IUA.update(UpdatedIRDB);
+  EXPECT_TRUE(IUA.getChangedFunctions().count("main"));
+  EXPECT_GT(IUA.getSolver().getNumReusedContexts(), 0U);
+  // only the call of id() leaks, zero() kills the taint
+  ASSERT_EQ(IUA.getProblem().Leaks.size(), 1U);
+  for (const auto &[SinkCallSite, LeakedValues] : IUA.getProblem().Leaks) {
+    EXPECT_EQ(SinkCallSite->getFunction()->getName(), "main");
+    EXPECT_EQ(LeakedValues.size(), 1U);
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
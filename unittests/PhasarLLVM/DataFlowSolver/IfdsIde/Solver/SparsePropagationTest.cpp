@@ -0,0 +1,57 @@
+#include <map>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/CompactIFDSSolver.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TaintAnalysisTestUtils.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class SparsePropagationTest : public unittest::IFDSTaintAnalysisTestBase {};
+
+TEST_F(SparsePropagationTest, SparseTaintTest_05_SameResultsAtRelevantNodes) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
+  auto DenseProblem = makeTaintProblem();
+  CompactIFDSSolver_P<IFDSTaintAnalysis> DenseSolver(*DenseProblem);
+  DenseSolver.solve();
+  TaintProblem->getIFDSIDESolverConfig().setSparsePropagation();
+  CompactIFDSSolver_P<IFDSTaintAnalysis> SparseSolver(*TaintProblem);
+  SparseSolver.solve();
+  EXPECT_LT(SparseSolver.getNumPathEdges(), DenseSolver.getNumPathEdges());
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &Inst : llvm::instructions(F)) {
+      auto DenseFacts = DenseSolver.ifdsResultsAt(&Inst);
+      auto SparseFacts = SparseSolver.ifdsResultsAt(&Inst);
+      // sparse propagation never introduces facts ...
+      for (const auto *Fact : SparseFacts) {
+        EXPECT_TRUE(DenseFacts.count(Fact)) << "at " << llvmIRToString(&Inst);
+      }
+      // ... and keeps all facts where they may be affected
+      bool IsSparseTarget = ICFG->isCallStmt(&Inst) ||
+                            ICFG->isExitStmt(&Inst) ||
+                            ICFG->isStartPoint(&Inst);
+      for (const auto *Fact : DenseFacts) {
+        if (IsSparseTarget || TaintProblem->isRelevant(&Inst, Fact)) {
+          EXPECT_TRUE(SparseFacts.count(Fact))
+              << "at " << llvmIRToString(&Inst);
+        }
+      }
+    }
+  }
+  compareResults({{22, {"21"}}});
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
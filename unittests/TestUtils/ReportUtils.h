@@ -0,0 +1,86 @@
+#ifndef UNITTEST_TESTUTILS_REPORTUTILS_H_
+#define UNITTEST_TESTUTILS_REPORTUTILS_H_
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace psr::unittest {
+
+// the "fact -> value" entries that a report lists per statement
+using ReportEntries = std::map<std::string, std::multiset<std::string>>;
+
+/// Parses a text report as emitted by the emitTextReport() of the IDE
+/// analyses: each "At IR statement:" line is followed by pairs of "Fact:"
+/// and "Value:" lines.
+inline ReportEntries parseTextReport(const std::string &Report) {
+  ReportEntries Entries;
+  std::istringstream IS(Report);
+  std::string Line;
+  std::string Stmt;
+  std::string Fact;
+  while (std::getline(IS, Line)) {
+    if (Line.rfind("At IR statement: ", 0) == 0) {
+      Stmt = Line.substr(17);
+      Entries[Stmt];
+    } else if (Line.rfind("   Fact: ", 0) == 0) {
+      Fact = Line.substr(9);
+    } else if (Line.rfind("  Value: ", 0) == 0) {
+      Entries[Stmt].insert(Fact + " -> " + Line.substr(9));
+    }
+  }
+  return Entries;
+}
+
+/// Parses the output of IDESolver::dumpResults(): each "N:" line is followed
+/// by "D: <fact> | V: <value>" lines.
+inline ReportEntries parseResultsDump(const std::string &Dump) {
+  ReportEntries Entries;
+  std::istringstream IS(Dump);
+  std::string Line;
+  std::string Stmt;
+  while (std::getline(IS, Line)) {
+    if (Line.rfind("N: ", 0) == 0) {
+      Stmt = Line.substr(3);
+      Entries[Stmt];
+    } else if (Line.rfind("\tD: ", 0) == 0) {
+      auto Sep = Line.rfind(" | V: ");
+      Entries[Stmt].insert(Line.substr(4, Sep - 4) + " -> " +
+                           Line.substr(Sep + 6));
+    }
+  }
+  return Entries;
+}
+
+/// Returns the entries that a report of Problem lists for the results SR at
+/// the instructions of ICF: all facts, except for the zero value if
+/// StripZero is set, whose values Keep accepts. Each entry is checked
+/// against the single lookup SR.resultAt().
+template <typename ICFGTy, typename ProblemTy, typename ResultsTy,
+          typename KeepFn>
+ReportEntries expectedReportEntries(const ICFGTy &ICF,
+                                    const ProblemTy &Problem,
+                                    const ResultsTy &SR, bool StripZero,
+                                    KeepFn Keep) {
+  ReportEntries Entries;
+  for (const auto *F : ICF.getAllFunctions()) {
+    for (const auto *Stmt : ICF.getAllInstructionsOf(F)) {
+      for (const auto &[Fact, Value] : SR.resultsAt(Stmt, StripZero)) {
+        EXPECT_TRUE(SR.resultAt(Stmt, Fact) == Value);
+        if (Keep(Value)) {
+          Entries[Problem.NtoString(Stmt)].insert(Problem.DtoString(Fact) +
+                                                  " -> " +
+                                                  Problem.LtoString(Value));
+        }
+      }
+    }
+  }
+  return Entries;
+}
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_REPORTUTILS_H_
@@ -0,0 +1,161 @@
+#ifndef UNITTEST_TESTUTILS_TAINTANALYSISTESTUTILS_H_
+#define UNITTEST_TESTUTILS_TAINTANALYSISTESTUTILS_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Value.h"
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/TaintConfiguration.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+
+#include "TestConfig.h"
+
+namespace psr::unittest {
+
+/// The taint configuration of the dummy_source_sink test programs: the value
+/// that source() returns is tainted and sink(int) leaks its argument. The
+/// caller owns the returned configuration.
+inline TaintConfiguration<const llvm::Value *> *makeSourceSinkTaintConfig() {
+  return new TaintConfiguration<const llvm::Value *>(
+      {TaintConfiguration<const llvm::Value *>::SourceFunction("source()",
+                                                               true)},
+      {TaintConfiguration<const llvm::Value *>::SinkFunction(
+          "sink(int)", std::vector<unsigned>({0}))});
+}
+
+/// A uniquely named file in the temporary directory that is removed when it
+/// goes out of scope, even if the test that uses it fails early.
+class TemporaryFile {
+public:
+  explicit TemporaryFile(const std::string &Extension)
+      : Path((boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("%%%%-%%%%" + Extension))
+                 .string()) {}
+  TemporaryFile(const TemporaryFile &) = delete;
+  TemporaryFile &operator=(const TemporaryFile &) = delete;
+
+  ~TemporaryFile() {
+    boost::system::error_code EC;
+    boost::filesystem::remove(Path, EC);
+  }
+
+  [[nodiscard]] const std::string &path() const { return Path; }
+
+private:
+  std::string Path;
+};
+
+/// Sets up IFDSTaintAnalysis on the taint_analysis test programs for the
+/// tests of the solvers that are run with it.
+class IFDSTaintAnalysisTestBase : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = PathToLLTestFiles + "taint_analysis/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  ProjectIRDB *IRDB{};
+  LLVMTypeHierarchy *TH{};
+  LLVMBasedICFG *ICFG{};
+  LLVMPointsToInfo *PT{};
+  IFDSTaintAnalysis *TaintProblem{};
+  TaintConfiguration<const llvm::Value *> *TSF{};
+
+  void initialize(const std::vector<std::string> &IRFiles) {
+    IRDB = new ProjectIRDB(IRFiles, IRDBOptions::WPA);
+    TH = new LLVMTypeHierarchy(*IRDB);
+    PT = new LLVMPointsToSet(*IRDB);
+    ICFG = new LLVMBasedICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints, TH,
+                             PT);
+    TSF = makeSourceSinkTaintConfig();
+    TaintProblem = new IFDSTaintAnalysis(IRDB, TH, ICFG, PT, *TSF, EntryPoints);
+  }
+
+  /// Returns another taint problem on the initialized program, e.g. for a
+  /// reference solver that records its leaks separately from TaintProblem.
+  [[nodiscard]] std::unique_ptr<IFDSTaintAnalysis>
+  makeTaintProblem(const std::set<std::string> &Entries) const {
+    return std::make_unique<IFDSTaintAnalysis>(IRDB, TH, ICFG, PT, *TSF,
+                                               Entries);
+  }
+
+  [[nodiscard]] std::unique_ptr<IFDSTaintAnalysis> makeTaintProblem() const {
+    return makeTaintProblem(EntryPoints);
+  }
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void TearDown() override {
+    delete TaintProblem;
+    delete TSF;
+    delete ICFG;
+    delete PT;
+    delete TH;
+    delete IRDB;
+  }
+
+  /// Expects TaintProblem to have found the leaks of GroundTruth, which maps
+  /// the IDs of the sink calls to the IDs of the values leaked there.
+  void
+  compareResults(const std::map<int, std::set<std::string>> &GroundTruth) {
+    std::map<int, std::set<std::string>> FoundLeaks;
+    for (const auto &Leak : TaintProblem->Leaks) {
+      int SinkId = std::stoi(getMetaDataID(Leak.first));
+      std::set<std::string> LeakedValueIds;
+      for (const auto *LV : Leak.second) {
+        LeakedValueIds.insert(getMetaDataID(LV));
+      }
+      FoundLeaks.insert(std::make_pair(SinkId, LeakedValueIds));
+    }
+    EXPECT_EQ(FoundLeaks, GroundTruth);
+  }
+
+  // the facts that hold at an instruction
+  using ResultsFn =
+      std::function<std::set<const llvm::Value *>(const llvm::Instruction *)>;
+
+  template <typename SolverTy> static ResultsFn resultsOf(SolverTy &Solver) {
+    return [&Solver](const llvm::Instruction *Inst) {
+      return Solver.ifdsResultsAt(Inst);
+    };
+  }
+
+  /// Expects Actual and Expected to hold the same facts at all instructions
+  /// of DB that Filter accepts.
+  static void expectSameResults(
+      const ProjectIRDB &DB, const ResultsFn &Actual,
+      const ResultsFn &Expected,
+      const std::function<bool(const llvm::Instruction *)> &Filter = nullptr) {
+    for (const auto *F : DB.getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(F)) {
+        if (!Filter || Filter(&Inst)) {
+          EXPECT_EQ(Actual(&Inst), Expected(&Inst))
+              << "at " << llvmIRToString(&Inst);
+        }
+      }
+    }
+  }
+};
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_TAINTANALYSISTESTUTILS_H_
@@ -6,7 +6,9 @@
 
 #include <iostream>
 #include <set>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace psr;
 using namespace std;
@@ -396,6 +398,82 @@ TEST(BitVectorSet, lessThan) {
   EXPECT_FALSE(A < A);
 }
 
+TEST(BitVectorSet, explicitIndex) {
+  BitVectorSetIndex<int> Index;
+  BitVectorSet<int> A({10, 20, 30}, Index);
+  BitVectorSet<int> B(Index);
+  B.insert(30);
+  B.insert(40);
+
+  EXPECT_EQ(&A.getIndex(), &Index);
+  EXPECT_EQ(Index.size(), 4U);
+  EXPECT_EQ(A.setUnion(B), BitVectorSet<int>({10, 20, 30, 40}, Index));
+  EXPECT_EQ(A.setIntersect(B), BitVectorSet<int>({30}, Index));
+  EXPECT_FALSE(A.includes(B));
+  A.insert(B);
+  EXPECT_TRUE(A.includes(B));
+  EXPECT_EQ(&A.setUnion(B).getIndex(), &Index);
+}
+
+TEST(BitVectorSet, differentIndices) {
+  BitVectorSetIndex<int> Index;
+  BitVectorSet<int> Global({1, 2, 3});
+  BitVectorSet<int> Local({3, 2, 1}, Index);
+
+  EXPECT_EQ(Global, Local);
+  EXPECT_TRUE(Global.includes(Local));
+  EXPECT_EQ(Local.setUnion(BitVectorSet<int>({4})),
+            BitVectorSet<int>({1, 2, 3, 4}));
+  EXPECT_EQ(Local.setIntersect(BitVectorSet<int>({2, 5})),
+            BitVectorSet<int>({2}));
+  // an empty set adopts the index of the set that is inserted
+  BitVectorSet<int> Empty;
+  Empty.insert(Local);
+  EXPECT_EQ(&Empty.getIndex(), &Index);
+  EXPECT_EQ(&BitVectorSet<int>().setUnion(Local).getIndex(), &Index);
+}
+
+TEST(BitVectorSet, hashDifferentIndices) {
+  BitVectorSetIndex<int> Index;
+  // 7 gets different positions in the two indices
+  BitVectorSet<int> Global({3, 7});
+  BitVectorSet<int> Local({100, 7, 3}, Index);
+  Local.erase(100);
+
+  ASSERT_EQ(Global, Local);
+  std::hash<BitVectorSet<int>> Hash;
+  EXPECT_EQ(Hash(Global), Hash(Local));
+  EXPECT_NE(Hash(Global), Hash(BitVectorSet<int>({3})));
+  // trailing zeros do not matter either
+  BitVectorSet<int> Trailing({3, 7, 1000});
+  Trailing.erase(1000);
+  EXPECT_EQ(Hash(Global), Hash(Trailing));
+}
+
+TEST(BitVectorSet, concurrentIndex) {
+  BitVectorSetIndex<int> Index;
+  std::vector<std::thread> Threads;
+  std::vector<BitVectorSet<int>> Sets(4, BitVectorSet<int>(Index));
+  for (size_t T = 0; T < Sets.size(); ++T) {
+    Threads.emplace_back([&Sets, T] {
+      // the elements 0 to 999 are inserted by all threads
+      for (int I = 0; I < 1000; ++I) {
+        Sets[T].insert(I);
+        Sets[T].insert(static_cast<int>(T + 1) * 1000 + I);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  EXPECT_EQ(Index.size(), 5000U);
+  for (size_t T = 0; T < Sets.size(); ++T) {
+    EXPECT_EQ(Sets[T].size(), 2000U);
+    EXPECT_EQ(Sets[T].count(static_cast<int>(T + 1) * 1000 + 999), 1U);
+  }
+  EXPECT_EQ(Sets[0].setIntersect(Sets[1]).size(), 1000U);
+}
+
 //===----------------------------------------------------------------------===//
 // llvm::BitVector
 
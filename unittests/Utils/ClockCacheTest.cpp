@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/ClockCache.h"
+
+#include <string>
+
+using namespace psr;
+using namespace std;
+
+TEST(ClockCache, unbounded) {
+  ClockCache<int, string> C;
+  for (int I = 0; I < 100; ++I) {
+    EXPECT_FALSE(C.insert(I, to_string(I)));
+  }
+  EXPECT_EQ(C.size(), 100U);
+  for (int I = 0; I < 100; ++I) {
+    ASSERT_NE(C.lookup(I), nullptr);
+    EXPECT_EQ(*C.lookup(I), to_string(I));
+  }
+  EXPECT_EQ(C.lookup(100), nullptr);
+}
+
+TEST(ClockCache, evictsUnreferenced) {
+  ClockCache<int, int> C(3);
+  EXPECT_FALSE(C.insert(1, 10));
+  EXPECT_FALSE(C.insert(2, 20));
+  EXPECT_FALSE(C.insert(3, 30));
+  // 1 and 3 get a second chance, 2 is evicted
+  EXPECT_NE(C.lookup(1), nullptr);
+  EXPECT_NE(C.lookup(3), nullptr);
+  EXPECT_TRUE(C.insert(4, 40));
+  EXPECT_EQ(C.size(), 3U);
+  EXPECT_EQ(C.lookup(2), nullptr);
+  EXPECT_EQ(*C.lookup(1), 10);
+  EXPECT_EQ(*C.lookup(3), 30);
+  EXPECT_EQ(*C.lookup(4), 40);
+}
+
+TEST(ClockCache, evictsInClockOrder) {
+  ClockCache<int, int> C(2);
+  C.insert(1, 10);
+  C.insert(2, 20);
+  EXPECT_TRUE(C.insert(3, 30));
+  EXPECT_EQ(C.lookup(1), nullptr);
+  EXPECT_TRUE(C.insert(4, 40));
+  EXPECT_EQ(C.lookup(2), nullptr);
+  EXPECT_EQ(*C.lookup(3), 30);
+  EXPECT_EQ(*C.lookup(4), 40);
+}
+
+TEST(ClockCache, clear) {
+  ClockCache<int, int> C(2);
+  C.insert(1, 10);
+  C.clear();
+  EXPECT_TRUE(C.empty());
+  EXPECT_EQ(C.lookup(1), nullptr);
+  EXPECT_FALSE(C.insert(1, 10));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
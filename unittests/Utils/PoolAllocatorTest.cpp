@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/PoolAllocator.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace psr;
+using namespace std;
+
+namespace {
+struct Node : enable_shared_from_this<Node> {
+  int Value;
+  Node(int Value) : Value(Value) {}
+  virtual ~Node() = default;
+};
+} // namespace
+
+TEST(PoolAllocator, makePooledShared) {
+  vector<shared_ptr<Node>> Nodes;
+  for (int I = 0; I < 1000; ++I) {
+    Nodes.push_back(makePooledShared<Node>(I));
+  }
+  for (int I = 0; I < 1000; ++I) {
+    EXPECT_EQ(Nodes[I]->Value, I);
+    EXPECT_EQ(Nodes[I]->shared_from_this(), Nodes[I]);
+  }
+}
+
+TEST(PoolAllocator, reusesFreedBlocks) {
+  auto N = makePooledShared<Node>(1);
+  Node *Addr = N.get();
+  N.reset();
+  N = makePooledShared<Node>(2);
+  EXPECT_EQ(N.get(), Addr);
+  EXPECT_EQ(N->Value, 2);
+}
+
+TEST(PoolAllocator, freeOnOtherThread) {
+  vector<shared_ptr<Node>> Nodes;
+  for (int I = 0; I < 1000; ++I) {
+    Nodes.push_back(makePooledShared<Node>(I));
+  }
+  thread Releaser([&Nodes] {
+    Nodes.clear();
+    for (int I = 0; I < 1000; ++I) {
+      auto N = makePooledShared<Node>(I);
+      EXPECT_EQ(N->Value, I);
+    }
+  });
+  Releaser.join();
+  EXPECT_EQ(makePooledShared<Node>(42)->Value, 42);
+}
+
+namespace {
+struct LargeNode : Node {
+  char Payload[200];
+  LargeNode(int Value) : Node(Value) {}
+};
+} // namespace
+
+TEST(PoolAllocator, releaseFreeChunks) {
+  vector<shared_ptr<LargeNode>> Nodes;
+  for (int I = 0; I < 1000; ++I) {
+    Nodes.push_back(makePooledShared<LargeNode>(I));
+  }
+  // every chunk still holds a live object
+  for (size_t I = 0; I < Nodes.size(); I += 2) {
+    Nodes[I].reset();
+  }
+  releasePooledMemory();
+  for (size_t I = 1; I < Nodes.size(); I += 2) {
+    EXPECT_EQ(Nodes[I]->Value, static_cast<int>(I));
+  }
+  Nodes.clear();
+  EXPECT_GE(releasePooledMemory(), 1000 * sizeof(LargeNode));
+  EXPECT_EQ(releasePooledMemory(), 0U);
+  EXPECT_EQ(makePooledShared<LargeNode>(42)->Value, 42);
+}
+
+TEST(PoolAllocator, releaseKeepsBlocksOfOtherThreads) {
+  auto N = makePooledShared<LargeNode>(1);
+  thread Other([] {
+    vector<shared_ptr<LargeNode>> Nodes;
+    for (int I = 0; I < 10; ++I) {
+      Nodes.push_back(makePooledShared<LargeNode>(I));
+    }
+    Nodes.clear();
+    // the blocks cached by this thread are not released by another thread
+    thread([] { releasePooledMemory(); }).join();
+    for (int I = 0; I < 10; ++I) {
+      Nodes.push_back(makePooledShared<LargeNode>(I));
+      EXPECT_EQ(Nodes.back()->Value, I);
+    }
+  });
+  Other.join();
+  releasePooledMemory();
+  EXPECT_EQ(N->Value, 1);
+}
+
+TEST(PoolAllocator, scopeReleasesOnDestruction) {
+  vector<shared_ptr<LargeNode>> Nodes;
+  {
+    PooledMemoryScope Scope;
+    for (int I = 0; I < 1000; ++I) {
+      Nodes.push_back(makePooledShared<LargeNode>(I));
+    }
+    Nodes.clear();
+  }
+  // the scope has already returned the chunks
+  EXPECT_EQ(releasePooledMemory(), 0U);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}